@@ -41,6 +41,7 @@ GENERIC_FEATURES = \
     MOUSEKEY \
     MUSIC \
     OS_DETECTION \
+    PROFILER \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
     SECURE \
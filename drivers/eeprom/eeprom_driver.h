@@ -20,3 +20,10 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_COMBINING)
+// Writes out the data held back by write combining
+void eeprom_driver_flush(void);
+// Flushes once writes have been idle for a while, called from keyboard_task()
+void eeprom_driver_task(void);
+#endif
@@ -6,6 +6,22 @@
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
 
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+#    include "timer.h"
+
+// Flush once no write has happened for this long...
+#    ifndef WEAR_LEVELING_FLUSH_IDLE_TIMEOUT
+#        define WEAR_LEVELING_FLUSH_IDLE_TIMEOUT 500
+#    endif
+// ...or once the oldest pending write is this old
+#    ifndef WEAR_LEVELING_FLUSH_MAX_DELAY
+#        define WEAR_LEVELING_FLUSH_MAX_DELAY 5000
+#    endif
+
+static uint32_t first_write_time;
+static uint32_t last_write_time;
+#endif
+
 void eeprom_driver_init(void) {
     wear_leveling_init();
 }
@@ -19,5 +35,23 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+    if (!wear_leveling_flush_pending()) {
+        first_write_time = timer_read32();
+    }
+    last_write_time = timer_read32();
+#endif
     wear_leveling_write((uint32_t)addr, buf, len);
 }
+
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+void eeprom_driver_flush(void) {
+    wear_leveling_flush();
+}
+
+void eeprom_driver_task(void) {
+    if (wear_leveling_flush_pending() && (timer_elapsed32(last_write_time) >= WEAR_LEVELING_FLUSH_IDLE_TIMEOUT || timer_elapsed32(first_write_time) >= WEAR_LEVELING_FLUSH_MAX_DELAY)) {
+        wear_leveling_flush();
+    }
+}
+#endif
@@ -0,0 +1,149 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_async.h"
+
+#include <stddef.h>
+
+// Queued transactions, in the order they were submitted
+static i2c_async_transaction_t *queue[I2C_ASYNC_QUEUE_LENGTH];
+static uint8_t                  queue_count = 0;
+
+// The transaction on the bus. Only the platform writes active_done, so that it can finish a transfer from an
+// interrupt or another thread; everything else happens in i2c_async_task() and the submit functions.
+static i2c_async_transaction_t *active      = NULL;
+static volatile bool            active_done = false;
+
+static void start_next(void) {
+    if (active != NULL || queue_count == 0) {
+        return;
+    }
+
+    uint8_t next = 0;
+    for (uint8_t i = 1; i < queue_count; i++) {
+        if (queue[i]->priority > queue[next]->priority) {
+            next = i;
+        }
+    }
+
+    active = queue[next];
+    queue_count--;
+    for (uint8_t i = next; i < queue_count; i++) {
+        queue[i] = queue[i + 1];
+    }
+
+    active->state = I2C_ASYNC_ACTIVE;
+    i2c_async_transfer_start(active);
+}
+
+bool i2c_async_submit(i2c_async_transaction_t *transaction) {
+    if (transaction->state != I2C_ASYNC_IDLE || queue_count >= I2C_ASYNC_QUEUE_LENGTH) {
+        return false;
+    }
+
+    transaction->state   = I2C_ASYNC_QUEUED;
+    queue[queue_count++] = transaction;
+    start_next();
+    return true;
+}
+
+static bool submit(i2c_async_transaction_t *transaction, i2c_async_type_t type, uint8_t address, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    if (transaction->state != I2C_ASYNC_IDLE) {
+        return false;
+    }
+
+    transaction->type    = type;
+    transaction->address = address;
+    transaction->regaddr = regaddr;
+    transaction->data    = data;
+    transaction->length  = length;
+    transaction->timeout = timeout;
+    return i2c_async_submit(transaction);
+}
+
+bool i2c_async_transmit(i2c_async_transaction_t *transaction, uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return submit(transaction, I2C_ASYNC_TRANSMIT, address, 0, (uint8_t *)data, length, timeout);
+}
+
+bool i2c_async_receive(i2c_async_transaction_t *transaction, uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    return submit(transaction, I2C_ASYNC_RECEIVE, address, 0, data, length, timeout);
+}
+
+bool i2c_async_write_register(i2c_async_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return submit(transaction, I2C_ASYNC_WRITE_REGISTER, devaddr, regaddr, (uint8_t *)data, length, timeout);
+}
+
+bool i2c_async_write_register16(i2c_async_transaction_t *transaction, uint8_t devaddr, uint16_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return submit(transaction, I2C_ASYNC_WRITE_REGISTER16, devaddr, regaddr, (uint8_t *)data, length, timeout);
+}
+
+bool i2c_async_read_register(i2c_async_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    return submit(transaction, I2C_ASYNC_READ_REGISTER, devaddr, regaddr, data, length, timeout);
+}
+
+bool i2c_async_read_register16(i2c_async_transaction_t *transaction, uint8_t devaddr, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    return submit(transaction, I2C_ASYNC_READ_REGISTER16, devaddr, regaddr, data, length, timeout);
+}
+
+bool i2c_async_is_pending(const i2c_async_transaction_t *transaction) {
+    return transaction->state != I2C_ASYNC_IDLE;
+}
+
+void i2c_async_task(void) {
+    // Callbacks may submit again, and the next transfer may finish before it returns
+    while (active != NULL && active_done) {
+        i2c_async_transaction_t *transaction = active;
+
+        active             = NULL;
+        active_done        = false;
+        transaction->state = I2C_ASYNC_IDLE;
+        if (transaction->callback != NULL) {
+            transaction->callback(transaction, transaction->status);
+        }
+
+        start_next();
+    }
+}
+
+void i2c_async_wait(const i2c_async_transaction_t *transaction) {
+    while (transaction->state != I2C_ASYNC_IDLE) {
+        i2c_async_task();
+    }
+}
+
+void i2c_async_flush(void) {
+    while (active != NULL) {
+        i2c_async_task();
+    }
+}
+
+uint8_t i2c_async_queue_depth(void) {
+    return queue_count;
+}
+
+void i2c_async_transfer_done(i2c_async_transaction_t *transaction, i2c_status_t status) {
+    transaction->status = status;
+    active_done         = true;
+}
+
+i2c_status_t i2c_async_execute(i2c_async_transaction_t *transaction) {
+    switch (transaction->type) {
+        case I2C_ASYNC_TRANSMIT:
+            return i2c_transmit(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_RECEIVE:
+            return i2c_receive(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_WRITE_REGISTER:
+            return i2c_write_register(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_WRITE_REGISTER16:
+            return i2c_write_register16(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_READ_REGISTER:
+            return i2c_read_register(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_READ_REGISTER16:
+            return i2c_read_register16(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+    }
+    return I2C_STATUS_ERROR;
+}
+
+__attribute__((weak)) void i2c_async_transfer_start(i2c_async_transaction_t *transaction) {
+    i2c_async_transfer_done(transaction, i2c_async_execute(transaction));
+}
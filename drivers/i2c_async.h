@@ -0,0 +1,111 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "i2c_master.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Transactions waiting for the bus are kept in a queue of this many entries */
+#ifndef I2C_ASYNC_QUEUE_LENGTH
+#    define I2C_ASYNC_QUEUE_LENGTH 8
+#endif
+
+/** \brief Queued transactions with a higher priority are started first. Transactions of the same priority are started
+ * in the order they were submitted. A transaction already on the bus is never interrupted.
+ */
+typedef enum {
+    I2C_ASYNC_PRIORITY_LOW,    // LED driver flushes
+    I2C_ASYNC_PRIORITY_NORMAL, // displays, EEPROM
+    I2C_ASYNC_PRIORITY_HIGH,   // sensor reads
+} i2c_async_priority_t;
+
+typedef enum {
+    I2C_ASYNC_TRANSMIT,
+    I2C_ASYNC_RECEIVE,
+    I2C_ASYNC_WRITE_REGISTER,
+    I2C_ASYNC_WRITE_REGISTER16,
+    I2C_ASYNC_READ_REGISTER,
+    I2C_ASYNC_READ_REGISTER16,
+} i2c_async_type_t;
+
+typedef enum {
+    I2C_ASYNC_IDLE,
+    I2C_ASYNC_QUEUED,
+    I2C_ASYNC_ACTIVE,
+} i2c_async_state_t;
+
+typedef struct i2c_async_transaction_t i2c_async_transaction_t;
+
+/** \brief Invoked from i2c_async_task() once a transaction has finished. The transaction may be submitted again from
+ * the callback.
+ */
+typedef void (*i2c_async_callback_t)(i2c_async_transaction_t *transaction, i2c_status_t status);
+
+/** \brief A transaction, owned by the caller. It and its data must stay valid until the callback was invoked.
+ *
+ * Set `priority`, `callback` and `context` before submitting it; the other fields are filled in by the submit
+ * functions below.
+ */
+struct i2c_async_transaction_t {
+    i2c_async_priority_t       priority;
+    i2c_async_callback_t       callback; // optional
+    void *                     context;  // free for the owner to use
+    i2c_async_type_t           type;
+    uint8_t                    address;
+    uint16_t                   regaddr;
+    uint8_t *                  data;
+    uint16_t                   length;
+    uint16_t                   timeout;
+    volatile i2c_async_state_t state;
+    volatile i2c_status_t      status;
+};
+
+/** \brief Queues a transaction, starting it right away if the bus is idle.
+ *
+ * \return false if the transaction is still queued or active, or if the queue is full. Nothing is queued then, so the
+ * caller should keep its data and try again later.
+ */
+bool i2c_async_submit(i2c_async_transaction_t *transaction);
+
+bool i2c_async_transmit(i2c_async_transaction_t *transaction, uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout);
+bool i2c_async_receive(i2c_async_transaction_t *transaction, uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout);
+bool i2c_async_write_register(i2c_async_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout);
+bool i2c_async_write_register16(i2c_async_transaction_t *transaction, uint8_t devaddr, uint16_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout);
+bool i2c_async_read_register(i2c_async_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout);
+bool i2c_async_read_register16(i2c_async_transaction_t *transaction, uint8_t devaddr, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout);
+
+/** \brief Whether a transaction is queued or on the bus. */
+bool i2c_async_is_pending(const i2c_async_transaction_t *transaction);
+
+/** \brief Invokes the callbacks of finished transactions and starts the next queued one. Called from keyboard_task(). */
+void i2c_async_task(void);
+
+/** \brief Blocks until a transaction has finished and its callback was invoked. */
+void i2c_async_wait(const i2c_async_transaction_t *transaction);
+
+/** \brief Blocks until every queued transaction has finished. */
+void i2c_async_flush(void);
+
+uint8_t i2c_async_queue_depth(void);
+
+/** \brief Starts a transaction on the bus. The platform calls i2c_async_transfer_done() once it has finished, from
+ * any context.
+ *
+ * The default implementation runs the transaction with the blocking i2c_master functions before returning.
+ */
+void i2c_async_transfer_start(i2c_async_transaction_t *transaction);
+
+void i2c_async_transfer_done(i2c_async_transaction_t *transaction, i2c_status_t status);
+
+/** \brief Runs a transaction with the blocking i2c_master functions. */
+i2c_status_t i2c_async_execute(i2c_async_transaction_t *transaction);
+
+#ifdef __cplusplus
+}
+#endif
@@ -22,6 +22,7 @@
 #include "wait.h"
 
 #define IS31FL3731_PWM_REGISTER_COUNT 144
+#define IS31FL3731_PWM_TRANSFER_SIZE 16
 #define IS31FL3731_LED_CONTROL_REGISTER_COUNT 18
 
 #ifndef IS31FL3731_I2C_TIMEOUT
@@ -32,6 +33,13 @@
 #    define IS31FL3731_I2C_PERSISTENCE 0
 #endif
 
+#ifdef IS31FL3731_I2C_ASYNC
+#    ifndef I2C_ASYNC_ENABLE
+#        error "IS31FL3731_I2C_ASYNC requires I2C_ASYNC_ENABLE = yes"
+#    endif
+#    include "i2c_async.h"
+#endif
+
 const uint8_t i2c_addresses[IS31FL3731_DRIVER_COUNT] = {
     IS31FL3731_I2C_ADDRESS_1,
 #ifdef IS31FL3731_I2C_ADDRESS_2
@@ -51,19 +59,57 @@ const uint8_t i2c_addresses[IS31FL3731_DRIVER_COUNT] = {
 // buffers and the transfers in is31fl3731_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3731_driver_t {
-    uint8_t pwm_buffer[IS31FL3731_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[IS31FL3731_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t  pwm_buffer[IS31FL3731_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty; // one bit per PWM register transfer
+    uint8_t  led_control_buffer[IS31FL3731_LED_CONTROL_REGISTER_COUNT];
+    bool     led_control_buffer_dirty;
 } PACKED is31fl3731_driver_t;
 
 is31fl3731_driver_t driver_buffers[IS31FL3731_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
 
+#ifdef IS31FL3731_I2C_ASYNC
+// One transaction per driver, sending the dirty PWM chunks one after another
+static i2c_async_transaction_t pwm_transactions[IS31FL3731_DRIVER_COUNT];
+
+static void is31fl3731_pwm_chunk_done(i2c_async_transaction_t *transaction, i2c_status_t status);
+
+// A chunk is no longer dirty once it is queued, so changes made while it is
+// on the bus are sent again by the next flush.
+static void is31fl3731_write_next_pwm_chunk(uint8_t index) {
+    uint16_t dirty = driver_buffers[index].pwm_buffer_dirty;
+    if (!dirty) {
+        return;
+    }
+
+    uint8_t chunk = 0;
+    while (!(dirty & (1 << chunk))) {
+        chunk++;
+    }
+
+    i2c_async_transaction_t *transaction = &pwm_transactions[index];
+    transaction->priority                = I2C_ASYNC_PRIORITY_LOW;
+    transaction->callback                = is31fl3731_pwm_chunk_done;
+    if (i2c_async_write_register(transaction, i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + chunk * IS31FL3731_PWM_TRANSFER_SIZE, driver_buffers[index].pwm_buffer + chunk * IS31FL3731_PWM_TRANSFER_SIZE, IS31FL3731_PWM_TRANSFER_SIZE, IS31FL3731_I2C_TIMEOUT)) {
+        driver_buffers[index].pwm_buffer_dirty &= ~(1 << chunk);
+    }
+}
+
+static void is31fl3731_pwm_chunk_done(i2c_async_transaction_t *transaction, i2c_status_t status) {
+    uint8_t index = transaction - pwm_transactions;
+    if (status != I2C_STATUS_SUCCESS) {
+        // Retried by the next flush, instead of IS31FL3731_I2C_PERSISTENCE
+        driver_buffers[index].pwm_buffer_dirty |= 1 << ((transaction->regaddr - IS31FL3731_FRAME_REG_PWM) / IS31FL3731_PWM_TRANSFER_SIZE);
+        return;
+    }
+    is31fl3731_write_next_pwm_chunk(index);
+}
+#endif
+
 void is31fl3731_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3731_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3731_I2C_PERSISTENCE; i++) {
@@ -80,16 +126,20 @@ void is31fl3731_select_page(uint8_t index, uint8_t page) {
 
 void is31fl3731_write_pwm_buffer(uint8_t index) {
     // Assumes page 0 is already selected.
-    // Transmit PWM registers in 9 transfers of 16 bytes.
+    // Transmit the changed PWM registers in up to 9 transfers of 16 bytes.
+
+    // Iterate over the pwm_buffer contents at 16 byte intervals, skipping unchanged ones.
+    for (uint8_t i = 0; i < IS31FL3731_PWM_REGISTER_COUNT; i += IS31FL3731_PWM_TRANSFER_SIZE) {
+        if (!(driver_buffers[index].pwm_buffer_dirty & (1 << (i / IS31FL3731_PWM_TRANSFER_SIZE)))) {
+            continue;
+        }
 
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3731_PWM_REGISTER_COUNT; i += 16) {
 #if IS31FL3731_I2C_PERSISTENCE > 0
         for (uint8_t j = 0; j < IS31FL3731_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3731_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+            if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, IS31FL3731_PWM_TRANSFER_SIZE, IS31FL3731_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
 #else
-        i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3731_I2C_TIMEOUT);
+        i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, IS31FL3731_PWM_TRANSFER_SIZE, IS31FL3731_I2C_TIMEOUT);
 #endif
     }
 }
@@ -180,7 +230,8 @@ void is31fl3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         driver_buffers[led.driver].pwm_buffer[led.r] = red;
         driver_buffers[led.driver].pwm_buffer[led.g] = green;
         driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+
+        driver_buffers[led.driver].pwm_buffer_dirty |= (1 << (led.r / IS31FL3731_PWM_TRANSFER_SIZE)) | (1 << (led.g / IS31FL3731_PWM_TRANSFER_SIZE)) | (1 << (led.b / IS31FL3731_PWM_TRANSFER_SIZE));
     }
 }
 
@@ -222,9 +273,16 @@ void is31fl3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void is31fl3731_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
+#ifdef IS31FL3731_I2C_ASYNC
+        // Otherwise the chunks still dirty are sent once the one on the bus has finished
+        if (!i2c_async_is_pending(&pwm_transactions[index])) {
+            is31fl3731_write_next_pwm_chunk(index);
+        }
+#else
         is31fl3731_write_pwm_buffer(index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
+#endif
     }
 }
 
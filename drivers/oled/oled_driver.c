@@ -23,6 +23,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        include "keyboard.h"
 #    endif
 #endif
+#if defined(OLED_I2C_ASYNC)
+#    if !defined(OLED_TRANSPORT_I2C) || !defined(I2C_ASYNC_ENABLE)
+#        error "OLED_I2C_ASYNC requires OLED_TRANSPORT = i2c and I2C_ASYNC_ENABLE = yes"
+#    endif
+#    include "i2c_async.h"
+#endif
 #include "oled_driver.h"
 #include OLED_FONT_H
 #include "timer.h"
@@ -185,8 +191,37 @@ uint16_t oled_update_timeout;
 #    endif
 #endif
 
+#if defined(OLED_I2C_ASYNC)
+static void oled_render_block_done(i2c_async_transaction_t *transaction, i2c_status_t status);
+
+// A block is rendered by queueing its position and its data, sent from
+// display_start and oled_buffer or temp_buffer in oled_render_dirty().
+static i2c_async_transaction_t oled_position_transaction = {.priority = I2C_ASYNC_PRIORITY_NORMAL, .callback = oled_render_block_done};
+static i2c_async_transaction_t oled_data_transaction     = {.priority = I2C_ASYNC_PRIORITY_NORMAL, .callback = oled_render_block_done};
+
+static void oled_render_block_done(i2c_async_transaction_t *transaction, i2c_status_t status) {
+    if (status != I2C_STATUS_SUCCESS) {
+        // context holds the block, render it again
+        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (uintptr_t)transaction->context);
+    }
+}
+
+static bool oled_render_pending(void) {
+    return i2c_async_is_pending(&oled_position_transaction) || i2c_async_is_pending(&oled_data_transaction);
+}
+
+// Commands must not overtake a block still being rendered
+static void oled_render_wait(void) {
+    i2c_async_wait(&oled_position_transaction);
+    i2c_async_wait(&oled_data_transaction);
+}
+#endif
+
 // Transmit/Write Funcs.
 __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
+#if defined(OLED_I2C_ASYNC)
+    oled_render_wait();
+#endif
 #if defined(OLED_TRANSPORT_SPI)
     if (!spi_start(OLED_CS_PIN, false, OLED_SPI_MODE, OLED_SPI_DIVISOR)) {
         return false;
@@ -223,6 +258,9 @@ __attribute__((weak)) bool oled_send_cmd_P(const uint8_t *data, uint16_t size) {
     spi_stop();
     return (status >= 0);
 #    elif defined(OLED_TRANSPORT_I2C)
+#        if defined(OLED_I2C_ASYNC)
+    oled_render_wait();
+#        endif
 
     i2c_status_t status = i2c_transmit_P((OLED_DISPLAY_ADDRESS << 1), data, size, OLED_I2C_TIMEOUT);
 
@@ -234,6 +272,9 @@ __attribute__((weak)) bool oled_send_cmd_P(const uint8_t *data, uint16_t size) {
 }
 
 __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
+#if defined(OLED_I2C_ASYNC)
+    oled_render_wait();
+#endif
 #if defined(OLED_TRANSPORT_SPI)
     if (!spi_start(OLED_CS_PIN, false, OLED_SPI_MODE, OLED_SPI_DIVISOR)) {
         return false;
@@ -453,6 +494,17 @@ void oled_render_dirty(bool all) {
         return;
     }
 
+#if defined(OLED_I2C_ASYNC)
+    // The buffers of the block on the bus are reused below. Unless everything has to be rendered now, a single block
+    // is queued once the previous one has been sent; SH1106/SH1107 need several transfers per rotated block.
+    if (all) {
+        oled_render_wait();
+    } else if (oled_render_pending() || I2C_ASYNC_QUEUE_LENGTH - i2c_async_queue_depth() < 2) {
+        return;
+    }
+    bool async = !all && (OLED_IC_HAS_HORIZONTAL_MODE || !HAS_FLAGS(oled_rotation, OLED_ROTATION_90));
+#endif
+
     // Turn on display if it is off
     oled_on();
 
@@ -476,6 +528,34 @@ void oled_render_dirty(bool all) {
             calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
         }
 
+#if defined(OLED_I2C_ASYNC)
+        if (async) {
+            const uint8_t *block_data = &oled_buffer[OLED_BLOCK_SIZE * update_start];
+            if (HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+                // Rotate the render chunks
+                const static uint8_t source_map[] = OLED_SOURCE_MAP;
+                const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+                static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+                memset(temp_buffer, 0, sizeof(temp_buffer));
+                for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+                    rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+                }
+                block_data = temp_buffer;
+            }
+
+            // Both fit in the queue, checked above
+            oled_position_transaction.context = (void *)(uintptr_t)update_start;
+            oled_data_transaction.context     = (void *)(uintptr_t)update_start;
+            i2c_async_transmit(&oled_position_transaction, (OLED_DISPLAY_ADDRESS << 1), display_start, ARRAY_SIZE(display_start), OLED_I2C_TIMEOUT);
+            i2c_async_write_register(&oled_data_transaction, (OLED_DISPLAY_ADDRESS << 1), I2C_DATA, block_data, OLED_BLOCK_SIZE, OLED_I2C_TIMEOUT);
+
+            // Cleared now, so that changes made while the block is on the bus render it again
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+            return;
+        }
+#endif
+
         // Send column & page position
         if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
             print("oled_render offset command failed\n");
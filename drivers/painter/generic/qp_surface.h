@@ -21,6 +21,14 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_NUM_DIRTY_RECTS
+/**
+ * @def This controls the maximum number of separate dirty rectangles tracked by each surface.
+ *      Once exceeded, the two rectangles whose union adds the least area are merged.
+ */
+#    define SURFACE_NUM_DIRTY_RECTS 4
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -64,4 +72,17 @@ painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_h
  */
 bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface);
 
+/**
+ * Attaches the surface to a target device, so that flushing the surface draws its dirty regions to the target.
+ *
+ * Once attached, `qp_flush(surface)` draws the surface to the target as per `qp_surface_draw(surface, target, x, y, false)`, then flushes the target.
+ *
+ * @param surface[in] the surface to attach
+ * @param target[in] the target device to draw into, or NULL to detach
+ * @param x[in] the x-location of the surface on the target
+ * @param y[in] the y-location of the surface on the target
+ * @return whether the surface could be attached to the target
+ */
+bool qp_surface_attach(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y);
+
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
@@ -49,6 +49,74 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
     }
 }
 
+void qp_surface_mark_dirty(surface_painter_device_t *surface, uint16_t x, uint16_t y) {
+    qp_surface_update_dirty(&surface->dirty, x, y);
+    qp_surface_update_dirty(&surface->viewport_dirty, x, y);
+}
+
+static inline void qp_surface_reset_dirty_data(surface_dirty_data_t *dirty) {
+    dirty->l = dirty->t = UINT16_MAX;
+    dirty->r = dirty->b = 0;
+    dirty->is_dirty     = false;
+}
+
+static void qp_surface_reset_dirty(surface_painter_device_t *surface) {
+    qp_surface_reset_dirty_data(&surface->dirty);
+    qp_surface_reset_dirty_data(&surface->viewport_dirty);
+    surface->dirty_rect_count = 0;
+}
+
+static inline uint32_t qp_surface_dirty_area(const surface_dirty_data_t *dirty) {
+    return ((uint32_t)(dirty->r - dirty->l + 1)) * (dirty->b - dirty->t + 1);
+}
+
+static inline surface_dirty_data_t qp_surface_dirty_union(const surface_dirty_data_t *a, const surface_dirty_data_t *b) {
+    return (surface_dirty_data_t){.is_dirty = true, .l = QP_MIN(a->l, b->l), .t = QP_MIN(a->t, b->t), .r = QP_MAX(a->r, b->r), .b = QP_MAX(a->b, b->b)};
+}
+
+// Folds the dirty region of the current viewport into the list of dirty rectangles
+static void qp_surface_commit_viewport_dirty(surface_painter_device_t *surface) {
+    if (!surface->viewport_dirty.is_dirty) {
+        return;
+    }
+
+    surface_dirty_data_t rect = surface->viewport_dirty;
+    qp_surface_reset_dirty_data(&surface->viewport_dirty);
+
+    // Absorb any rectangles whose union with this one is no larger than both areas summed, restarting each time the rectangle grows
+    for (uint8_t i = 0; i < surface->dirty_rect_count;) {
+        surface_dirty_data_t merged = qp_surface_dirty_union(&rect, &surface->dirty_rects[i]);
+        if (qp_surface_dirty_area(&merged) <= qp_surface_dirty_area(&rect) + qp_surface_dirty_area(&surface->dirty_rects[i])) {
+            rect                     = merged;
+            surface->dirty_rects[i] = surface->dirty_rects[--surface->dirty_rect_count];
+            i                        = 0;
+        } else {
+            ++i;
+        }
+    }
+    surface->dirty_rects[surface->dirty_rect_count++] = rect;
+
+    // If we've run out of rectangles, merge the pair which adds the least area
+    if (surface->dirty_rect_count > SURFACE_NUM_DIRTY_RECTS) {
+        uint8_t best_i    = 0;
+        uint8_t best_j    = 1;
+        int32_t best_cost = INT32_MAX;
+        for (uint8_t i = 0; i < surface->dirty_rect_count; ++i) {
+            for (uint8_t j = i + 1; j < surface->dirty_rect_count; ++j) {
+                surface_dirty_data_t merged = qp_surface_dirty_union(&surface->dirty_rects[i], &surface->dirty_rects[j]);
+                int32_t              cost   = (int32_t)qp_surface_dirty_area(&merged) - (int32_t)qp_surface_dirty_area(&surface->dirty_rects[i]) - (int32_t)qp_surface_dirty_area(&surface->dirty_rects[j]);
+                if (cost < best_cost) {
+                    best_i    = i;
+                    best_j    = j;
+                    best_cost = cost;
+                }
+            }
+        }
+        surface->dirty_rects[best_i] = qp_surface_dirty_union(&surface->dirty_rects[best_i], &surface->dirty_rects[best_j]);
+        surface->dirty_rects[best_j] = surface->dirty_rects[--surface->dirty_rect_count];
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver vtable
 
@@ -63,6 +131,10 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface->dirty.b        = surface->base.panel_height - 1;
     surface->dirty.is_dirty = true;
 
+    qp_surface_reset_dirty_data(&surface->viewport_dirty);
+    surface->dirty_rects[0]   = surface->dirty;
+    surface->dirty_rect_count = 1;
+
     return true;
 }
 
@@ -80,9 +152,13 @@ bool qp_surface_clear(painter_device_t device) {
 bool qp_surface_flush(painter_device_t device) {
     painter_driver_t *        driver  = (painter_driver_t *)device;
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
-    surface->dirty.l = surface->dirty.t = UINT16_MAX;
-    surface->dirty.r = surface->dirty.b = 0;
-    surface->dirty.is_dirty             = false;
+
+    // Attached surfaces push their dirty regions to the target, which resets them
+    if (surface->target) {
+        return qp_surface_draw(device, surface->target, surface->target_x, surface->target_y, false) && qp_flush(surface->target);
+    }
+
+    qp_surface_reset_dirty(surface);
     return true;
 }
 
@@ -90,6 +166,9 @@ bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, u
     painter_driver_t *        driver  = (painter_driver_t *)device;
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
 
+    // Anything drawn in the previous viewport is complete
+    qp_surface_commit_viewport_dirty(surface);
+
     // Set the viewport locations
     surface->viewport.viewport_l = left;
     surface->viewport.viewport_t = top;
@@ -122,20 +201,46 @@ bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t
         return false;
     }
 
-    // Offload to the pixdata transfer function
+    // Offload to the pixdata transfer function, either for the whole surface or for each of the dirty rectangles
     surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface_driver->driver_vtable;
-    bool                             ok     = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, entire_surface);
+    bool                             ok     = true;
+    if (entire_surface) {
+        surface_dirty_data_t region = {.is_dirty = true, .l = 0, .t = 0, .r = surface_driver->panel_width - 1, .b = surface_driver->panel_height - 1};
+        ok                          = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, &region);
+    } else {
+        qp_surface_commit_viewport_dirty(surface_handle);
+        for (uint8_t i = 0; ok && i < surface_handle->dirty_rect_count; ++i) {
+            ok = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, &surface_handle->dirty_rects[i]);
+        }
+    }
     if (!ok) {
         qp_dprintf("qp_surface_draw: fail (could not transfer pixel data)\n");
         return false;
     }
 
     // Clear the dirty info for the surface
-    ok = qp_flush(surface);
-    if (!ok) {
-        qp_dprintf("qp_surface_draw: fail (could not flush)\n");
+    qp_surface_reset_dirty(surface_handle);
+    qp_dprintf("qp_surface_draw: ok\n");
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pairing a surface with a target device, so that flushing the surface draws it to the target
+
+bool qp_surface_attach(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y) {
+    painter_driver_t *        surface_driver = (painter_driver_t *)surface;
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+    painter_driver_t *        target_driver  = (painter_driver_t *)target;
+
+    // If we have incompatible bit depths, drop out
+    if (target_driver && surface_driver->native_bits_per_pixel != target_driver->native_bits_per_pixel) {
+        qp_dprintf("qp_surface_attach: fail (incompatible bpp: surface=%d, target=%d)\n", (int)surface_driver->native_bits_per_pixel, (int)target_driver->native_bits_per_pixel);
         return false;
     }
-    qp_dprintf("qp_surface_draw: ok\n");
+
+    surface_handle->target   = target;
+    surface_handle->target_x = x;
+    surface_handle->target_y = y;
+    qp_dprintf("qp_surface_attach: ok\n");
     return true;
 }
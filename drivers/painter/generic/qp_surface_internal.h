@@ -9,13 +9,6 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Internal declarations
 
-// Surface vtable
-typedef struct surface_painter_driver_vtable_t {
-    painter_driver_vtable_t base; // must be first, so it can be cast to/from the painter_driver_vtable_t* type
-
-    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
-} surface_painter_driver_vtable_t;
-
 typedef struct surface_dirty_data_t {
     bool     is_dirty;
     uint16_t l;
@@ -24,6 +17,13 @@ typedef struct surface_dirty_data_t {
     uint16_t b;
 } surface_dirty_data_t;
 
+// Surface vtable
+typedef struct surface_painter_driver_vtable_t {
+    painter_driver_vtable_t base; // must be first, so it can be cast to/from the painter_driver_vtable_t* type
+
+    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, const surface_dirty_data_t *region);
+} surface_painter_driver_vtable_t;
+
 typedef struct surface_viewport_data_t {
     // Manually manage the viewport for streaming pixel data to the display
     uint16_t viewport_l;
@@ -52,6 +52,18 @@ typedef struct surface_painter_device_t {
 
     // Maintain a dirty region so we can stream only what we need
     surface_dirty_data_t dirty;
+
+    // Dirty region of the current viewport, folded into the dirty rectangles when the viewport changes
+    surface_dirty_data_t viewport_dirty;
+
+    // Dirty rectangles, which may overlap; two are merged when their union is no larger than their summed areas. The last one is scratch space for merging
+    surface_dirty_data_t dirty_rects[SURFACE_NUM_DIRTY_RECTS + 1];
+    uint8_t              dirty_rect_count;
+
+    // Attached target device, drawn to when the surface is flushed
+    painter_device_t target;
+    uint16_t         target_x;
+    uint16_t         target_y;
 } surface_painter_device_t;
 
 /**
@@ -89,6 +101,7 @@ bool qp_surface_flush(painter_device_t device);
 bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
+void qp_surface_mark_dirty(surface_painter_device_t *surface, uint16_t x, uint16_t y);
 
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
@@ -29,7 +29,7 @@ static inline void setpixel_mono1bpp(surface_painter_device_t *surface, uint16_t
     // Skip messing with the dirty info if the original value already matches
     if (curr_val != mono_pixel) {
         // Update the dirty region
-        qp_surface_update_dirty(&surface->dirty, x, y);
+        qp_surface_mark_dirty(surface, x, y);
 
         // Update the pixel data in the buffer
         if (mono_pixel) {
@@ -84,7 +84,7 @@ static bool qp_surface_append_pixels_mono1bpp(painter_device_t device, uint8_t *
     return true;
 }
 
-static bool mono1bpp_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+static bool mono1bpp_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, const surface_dirty_data_t *region) {
     return false; // Not yet supported.
 }
 
@@ -23,7 +23,7 @@ static inline void setpixel_rgb565(surface_painter_device_t *surface, uint16_t x
     // Skip messing with the dirty info if the original value already matches
     if (surface->u16buffer[y * w + x] != rgb565) {
         // Update the dirty region
-        qp_surface_update_dirty(&surface->dirty, x, y);
+        qp_surface_mark_dirty(surface, x, y);
 
         // Update the pixel data in the buffer
         surface->u16buffer[y * w + x] = rgb565;
@@ -68,13 +68,13 @@ static bool qp_surface_append_pixels_rgb565(painter_device_t device, uint8_t *ta
     return true;
 }
 
-static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, const surface_dirty_data_t *region) {
     surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
 
-    uint16_t l = entire_surface ? 0 : surface_handle->dirty.l;
-    uint16_t t = entire_surface ? 0 : surface_handle->dirty.t;
-    uint16_t r = entire_surface ? (surface_handle->base.panel_width - 1) : surface_handle->dirty.r;
-    uint16_t b = entire_surface ? (surface_handle->base.panel_height - 1) : surface_handle->dirty.b;
+    uint16_t l = region->l;
+    uint16_t t = region->t;
+    uint16_t r = region->r;
+    uint16_t b = region->b;
 
     // Set the target drawing area
     bool ok = qp_viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
@@ -83,6 +83,15 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
         return false;
     }
 
+    // Full-width regions are contiguous in the framebuffer, so they can be sent straight from it in one go
+    if (l == 0 && r == surface_handle->base.panel_width - 1) {
+        ok = qp_pixdata((painter_device_t)target_driver, &surface_handle->u16buffer[t * surface_handle->base.panel_width], ((uint32_t)(b - t + 1)) * surface_handle->base.panel_width);
+        if (!ok) {
+            qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
+        }
+        return ok;
+    }
+
     // Housekeeping of the amount of pixels to transfer
     uint32_t  total_pixel_count = (8 * QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE) / surface_driver->native_bits_per_pixel;
     uint32_t  pixel_counter     = 0;
@@ -198,6 +198,9 @@ void winry315_set_orientation(uint8_t orientation) {
                 break;
         }
     }
+#    if defined(RGB_MATRIX_LED_GEOMETRY_CACHE)
+    rgb_matrix_update_led_geometry();
+#    endif
 #endif // defined(RGB_MATRIX_ENABLE)
 }
 
@@ -56,6 +56,7 @@ subcommands = [
     'qmk.cli.generate.info_json',
     'qmk.cli.generate.keyboard_c',
     'qmk.cli.generate.keyboard_h',
+    'qmk.cli.generate.keycode_dispatch',
     'qmk.cli.generate.keycodes',
     'qmk.cli.generate.keycodes_tests',
     'qmk.cli.generate.make_dependencies',
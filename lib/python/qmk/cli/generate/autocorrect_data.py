@@ -24,11 +24,19 @@ Example:
   lenght        -> length
   ouput         -> output
   widht         -> width
+With --external-flash, the trie is written to "autocorrect_data.bin" instead,
+to be stored in external SPI flash, and "autocorrect_data.h" only holds its
+parameters. This format has 24-bit links, so it is not limited to 64KB, and
+identical subtrees are stored once.
 For full documentation, see QMK Docs
 """
 
+import struct
 import sys
 import textwrap
+from bisect import bisect_left
+from collections import defaultdict
+from pathlib import Path
 from typing import Any, Dict, Iterator, List, Tuple
 
 from milc import cli
@@ -43,6 +51,17 @@ KC_A = 4
 KC_SPC = 0x2c
 KC_QUOT = 0x34
 
+# Ends a chain node whose child is stored elsewhere, followed by a link to it.
+# Only used in the external flash format.
+CHAIN_LINK = 1
+
+EXTERNAL_FLASH_MAGIC = b'QAC'
+EXTERNAL_FLASH_VERSION = 1
+EXTERNAL_FLASH_HEADER_SIZE = 8
+EXTERNAL_FLASH_LINK_SIZE = 3
+# Size of the reads the firmware caches, see AUTOCORRECT_FLASH_CACHE_LINE_SIZE.
+EXTERNAL_FLASH_CACHE_LINE_SIZE = 32
+
 TYPO_CHARS = dict([
     ("'", KC_QUOT),
     (':', KC_SPC),  # "Word break" character.
@@ -78,8 +97,9 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
         # Use a minimal word list as a fallback.
         correct_words = ('information', 'available', 'international', 'language', 'loosest', 'reference', 'wealthier', 'entertainment', 'association', 'provides', 'technology', 'statehood')
 
+    correct_words = CorrectWords(correct_words)
     autocorrections = []
-    typos = set()
+    typos = {}
     for line_number, typo, correction in parse_file_lines(file_name):
         if typo in typos:
             cli.log.warning('{fg_red}Error:%d:{fg_reset} Ignoring duplicate typo: "{fg_cyan}%s{fg_reset}"', line_number, typo)
@@ -89,10 +109,6 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
         if not (all([c in TYPO_CHARS for c in typo])):
             cli.log.error('{fg_red}Error:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" has characters other than a-z, \' and :.', line_number, typo)
             sys.exit(1)
-        for other_typo in typos:
-            if typo in other_typo or other_typo in typo:
-                cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', line_number, typo, other_typo)
-                sys.exit(1)
         if len(typo) < 5:
             cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} It is suggested that typos are at least 5 characters long to avoid false triggers: "{fg_cyan}%s{fg_reset}"', line_number, typo)
         if len(typo) > 127:
@@ -102,11 +118,55 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
         check_typo_against_dictionary(typo, line_number, correct_words)
 
         autocorrections.append((typo, correction))
-        typos.add(typo)
+        typos[typo] = line_number
+
+    # Look up the substrings of each typo rather than comparing every pair, so large dictionaries stay fast.
+    for typo, line_number in typos.items():
+        for start in range(len(typo)):
+            for end in range(start + 1, len(typo) + 1):
+                other_typo = typo[start:end]
+                if other_typo != typo and other_typo in typos:
+                    cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', max(line_number, typos[other_typo]), typo, other_typo)
+                    sys.exit(1)
 
     return autocorrections
 
 
+class CorrectWords:
+    """Correctly spelled words, indexed to find the words starting with, ending with or containing a typo."""
+    def __init__(self, words):
+        self.words = sorted(words)
+        self.reversed_words = sorted(word[::-1] for word in self.words)
+        self.trigrams = defaultdict(list)
+        for i, word in enumerate(self.words):
+            for trigram in {word[j:j + 3] for j in range(len(word) - 2)}:
+                self.trigrams[trigram].append(i)
+
+    @staticmethod
+    def _with_prefix(sorted_words, prefix):
+        for i in range(bisect_left(sorted_words, prefix), len(sorted_words)):
+            if not sorted_words[i].startswith(prefix):
+                break
+            yield sorted_words[i]
+
+    def __contains__(self, word):
+        i = bisect_left(self.words, word)
+        return i < len(self.words) and self.words[i] == word
+
+    def starting_with(self, prefix):
+        return self._with_prefix(self.words, prefix)
+
+    def ending_with(self, suffix):
+        return (word[::-1] for word in self._with_prefix(self.reversed_words, suffix[::-1]))
+
+    def containing(self, text):
+        if len(text) < 3:
+            return (word for word in self.words if text in word)
+        # only the words that have the typo's rarest trigram can contain it
+        candidates = min((self.trigrams.get(text[j:j + 3], []) for j in range(len(text) - 2)), key=len)
+        return (self.words[i] for i in candidates if text in self.words[i])
+
+
 def make_trie(autocorrections: List[Tuple[str, str]]) -> Dict[str, Any]:
     """Makes a trie from the the typos, writing in reverse.
   Args:
@@ -152,31 +212,33 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
         if typo[1:-1] in correct_words:
             cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" is a correctly spelled dictionary word.', line_number, typo)
     elif typo.startswith(':') and not typo.endswith(':'):
-        for word in correct_words:
-            if word.startswith(typo[1:]):
-                cli.log.warning('{fg_yellow}Warning:%d: {fg_reset}Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
+        for word in correct_words.starting_with(typo[1:]):
+            cli.log.warning('{fg_yellow}Warning:%d: {fg_reset}Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
     elif not typo.startswith(':') and typo.endswith(':'):
-        for word in correct_words:
-            if word.endswith(typo[:-1]):
-                cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
+        for word in correct_words.ending_with(typo[:-1]):
+            cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
     elif not typo.startswith(':') and not typo.endswith(':'):
-        for word in correct_words:
-            if typo in word:
-                cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
+        for word in correct_words.containing(typo):
+            cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any], link_size: int = 2) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
+    link_size: Bytes per node link. With 3 byte links (the external flash
+      format), identical subtrees are only serialized once.
   Returns:
     List of ints in the range 0-255.
   """
     table = []
+    shared = {}
+    share_subtrees = link_size > 2
 
     # Traverse trie in depth first order.
     def traverse(trie_node):
+        position = len(table)
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
             typo, correction = trie_node['LEAF']
             word_boundary_ending = typo[-1] == ':'
@@ -190,7 +252,7 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
             bs_count = [backspaces + 128]
             data = bs_count + list(bytes(correction, 'ascii')) + [0]
 
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
+            entry = {'data': data, 'links': [], 'byte_offset': 0, 'key': ('LEAF', tuple(data))}
             table.append(entry)
         elif len(trie_node) == 1:  # Handle trie node with a single child.
             c, trie_node = next(iter(trie_node.items()))
@@ -204,41 +266,132 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
 
             table.append(entry)
             entry['links'] = [traverse(trie_node)]
+            entry['key'] = ('CHAIN', entry['chars'], id(entry['links'][0]))
         else:  # Handle trie node with multiple children.
             entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
             table.append(entry)
             entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
+            entry['key'] = ('BRANCH', entry['chars'], tuple(id(link) for link in entry['links']))
+
+        if share_subtrees:
+            if entry['key'] in shared:
+                # An identical subtree was serialized already, drop this one.
+                del table[position:]
+                return shared[entry['key']]
+            shared[entry['key']] = entry
         return entry
 
     traverse(trie)
 
+    # A chain is followed by its child, unless the child was serialized elsewhere.
+    for position, e in enumerate(table):
+        e['link_child'] = len(e['links']) == 1 and (position + 1 == len(table) or table[position + 1] is not e['links'][0])
+    assert share_subtrees or not any(e['link_child'] for e in table)
+
     def serialize(e: Dict[str, Any]) -> List[int]:
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
         elif len(e['links']) == 1:  # Handle a chain table entry.
+            if e['link_child']:
+                return [TYPO_CHARS[c] for c in e['chars']] + [CHAIN_LINK] + encode_link(e['links'][0], link_size)
             return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
+                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link, link_size)
             return data + [0]
 
     byte_offset = 0
     for e in table:  # To encode links, first compute byte offset of each entry.
         e['byte_offset'] = byte_offset
+        check_byte_offset(e['byte_offset'], link_size)
         byte_offset += len(serialize(e))
-        assert 0 <= byte_offset <= 0xffff
 
     return [b for e in table for b in serialize(e)]  # Serialize final table.
 
 
-def encode_link(link: Dict[str, Any]) -> List[int]:
-    """Encodes a node link as two bytes."""
-    byte_offset = link['byte_offset']
-    if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
+def check_byte_offset(byte_offset: int, link_size: int) -> None:
+    """Exits if a node at `byte_offset` can't be linked to."""
+    if not (0 <= byte_offset < 1 << (8 * link_size)):
+        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds the %dKB limit. Try reducing the autocorrection dict to fewer entries, or use --external-flash.', (1 << (8 * link_size)) // 1024)
         sys.exit(1)
-    return [byte_offset & 255, byte_offset >> 8]
+
+
+def encode_link(link: Dict[str, Any], link_size: int = 2) -> List[int]:
+    """Encodes a node link as `link_size` little endian bytes."""
+    byte_offset = link['byte_offset']
+    check_byte_offset(byte_offset, link_size)
+    return [(byte_offset >> (8 * i)) & 255 for i in range(link_size)]
+
+
+def lookup_cost(data: List[int], typo: str, link_size: int) -> Tuple[int, List[int]]:
+    """Walks the serialized trie like the firmware does when `typo` has just been typed.
+  Returns:
+    The offsets of the bytes read, and the correction data of the leaf found.
+  """
+    reads = []
+
+    def read(offset):
+        reads.append(offset)
+        return data[offset]
+
+    def read_link(offset):
+        return sum(read(offset + i) << (8 * i) for i in range(link_size))
+
+    state = 0
+    code = read(state)
+    for key in reversed([TYPO_CHARS[c] for c in typo]):
+        if code & 64:
+            code &= 63
+            while code != key:
+                assert code, f'"{typo}" is not in the trie'
+                state += 1 + link_size
+                code = read(state)
+            state = read_link(state + 1)
+        else:
+            assert code == key, f'"{typo}" is not in the trie'
+            state += 1
+            code = read(state)
+            if code == 0:
+                state += 1
+            elif code == CHAIN_LINK:
+                state = read_link(state + 1)
+        code = read(state)
+        if code & 128:
+            end = data.index(0, state + 1)
+            return reads, data[state:end + 1]
+    assert False, f'"{typo}" did not reach a leaf'
+
+
+def report_lookup_cost(autocorrections: List[Tuple[str, str]], data: List[int], link_size: int) -> None:
+    """Logs how many bytes, and cache lines in external flash, a keystroke reads from the trie."""
+    root_size = root_node_size(data, link_size)
+    byte_counts = []
+    line_counts = []
+    for typo, _ in autocorrections:
+        reads, _ = lookup_cost(data, typo, link_size)
+        byte_counts.append(len(reads))
+        line_counts.append(len({(EXTERNAL_FLASH_HEADER_SIZE + offset) // EXTERNAL_FLASH_CACHE_LINE_SIZE for offset in reads if offset >= root_size}))
+
+    # The root is usually a branch over every last letter of a typo, and is scanned on every keystroke.
+    root_width = (root_node_size(data, link_size) - 1) // (1 + link_size) if data[0] & 64 else 1
+
+    cli.log.info('Lookup cost per keystroke: %.1f bytes read on average, %d at most, root branch of %d letters.', sum(byte_counts) / len(byte_counts), max(byte_counts), root_width)
+    if link_size > 2:
+        cli.log.info('Flash cache lines of %d bytes read per correction, besides the root kept in RAM: %.1f on average, %d at most.', EXTERNAL_FLASH_CACHE_LINE_SIZE, sum(line_counts) / len(line_counts), max(line_counts))
+
+
+def root_node_size(data: List[int], link_size: int) -> int:
+    """Returns the size of the node the serialized trie starts with."""
+    if data[0] & 64:  # A branch node.
+        size = 0
+        while data[size]:
+            size += 1 + link_size
+        return size + 1
+    size = 1  # A chain node.
+    while data[size] > CHAIN_LINK:
+        size += 1
+    return size + 1 + (link_size if data[size] == CHAIN_LINK else 0)
 
 
 def typo_len(e: Tuple[str, str]) -> int:
@@ -253,12 +406,14 @@ def to_hex(b: int) -> str:
 @cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-e', '--external-flash', arg_only=True, action='store_true', help='Write the trie to autocorrect_data.bin, to be stored in external SPI flash')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+    link_size = EXTERNAL_FLASH_LINK_SIZE if cli.args.external_flash else 2
+    data = serialize_trie(autocorrections, trie, link_size)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -271,21 +426,42 @@ def generate_autocorrect_data(cli):
     min_typo = min(autocorrections, key=typo_len)[0]
     max_typo = max(autocorrections, key=typo_len)[0]
 
+    if not cli.args.quiet:
+        report_lookup_cost(autocorrections, data, link_size)
+
     # Build the autocorrect_data.h file.
     autocorrect_data_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
 
-    autocorrect_data_h_lines.append(f'// Autocorrection dictionary ({len(autocorrections)} entries):')
-    for typo, correction in autocorrections:
-        autocorrect_data_h_lines.append(f'//   {typo:<{len(max_typo)}} -> {correction}')
+    if cli.args.external_flash:
+        # Listing tens of thousands of entries would only slow down the build.
+        autocorrect_data_h_lines.append(f'// Autocorrection dictionary ({len(autocorrections)} entries), stored in external flash.')
+    else:
+        autocorrect_data_h_lines.append(f'// Autocorrection dictionary ({len(autocorrections)} entries):')
+        for typo, correction in autocorrections:
+            autocorrect_data_h_lines.append(f'//   {typo:<{len(max_typo)}} -> {correction}')
 
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
-    autocorrect_data_h_lines.append('')
-    autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
-    autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
-    autocorrect_data_h_lines.append('};')
+
+    if cli.args.external_flash:
+        max_correction = max(len(correction) for _, correction in autocorrections)
+        autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_CORRECTION_LENGTH {max_correction}')
+        autocorrect_data_h_lines.append(f'#define AUTOCORRECT_ROOT_SIZE {root_node_size(data, link_size)}')
+        autocorrect_data_h_lines.append('#define AUTOCORRECT_DATA_EXTERNAL_FLASH')
+
+        # The data is prefixed with a header, so the firmware can check that the flash holds the matching dictionary.
+        bin_file = cli.args.output.with_suffix('.bin') if cli.args.output else Path('autocorrect_data.bin')
+        bin_file.parent.mkdir(parents=True, exist_ok=True)
+        bin_file.write_bytes(EXTERNAL_FLASH_MAGIC + struct.pack('<BI', EXTERNAL_FLASH_VERSION, len(data)) + bytes(data))
+        if not cli.args.quiet:
+            cli.log.info('Wrote %d bytes of autocorrect data to %s, to be written at AUTOCORRECT_FLASH_ADDRESS.', EXTERNAL_FLASH_HEADER_SIZE + len(data), bin_file)
+    else:
+        autocorrect_data_h_lines.append('')
+        autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
+        autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
+        autocorrect_data_h_lines.append('};')
 
     # Show the results
     dump_lines(cli.args.output, autocorrect_data_h_lines, cli.args.quiet)
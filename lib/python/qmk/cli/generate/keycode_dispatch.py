@@ -0,0 +1,104 @@
+"""Used by the make system to generate keycode_dispatch.h from keycodes_{version}.json
+"""
+from pathlib import Path
+
+from milc import cli
+
+from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
+from qmk.commands import dump_lines
+from qmk.path import normpath
+from qmk.keycodes import load_spec
+from qmk.json_schema import json_load
+
+
+def _handler_id(handler):
+    return 'KEYCODE_DISPATCH_' + handler.replace('process_', '', 1).upper()
+
+
+def _resolve_ranges(keycodes, handler, value):
+    """Resolve the ranges, groups and keycodes of a handler to a list of (lo, hi, case label)
+    """
+    ranges = {v['define']: k for k, v in keycodes['ranges'].items()}
+    lookup = {v['key']: int(k, 16) for k, v in keycodes['keycodes'].items()}
+
+    ret = []
+    for define in value.get('ranges', []):
+        if define not in ranges:
+            raise ValueError(f'{handler}: unknown keycode range {define}')
+        lo, mask = map(lambda x: int(x, 16), ranges[define].split('/'))
+        ret.append((lo, lo + mask, f'{define} ... {define}_MAX'))
+
+    for group in value.get('groups', []):
+        codes = sorted(int(k, 16) for k, v in keycodes['keycodes'].items() if v.get('group') == group)
+        if not codes:
+            raise ValueError(f'{handler}: unknown keycode group {group}')
+        lo = keycodes['keycodes'][f'0x{codes[0]:04X}']['key']
+        hi = keycodes['keycodes'][f'0x{codes[-1]:04X}']['key']
+        ret.append((codes[0], codes[-1], f'{lo} ... {hi}'))
+
+    for key in value.get('keycodes', []):
+        if key not in lookup:
+            raise ValueError(f'{handler}: unknown keycode {key}')
+        ret.append((lookup[key], lookup[key], key))
+
+    return ret
+
+
+def _check_overlaps(dispatch):
+    spans = sorted((lo, hi, handler) for handler, value in dispatch.items() for lo, hi, _ in value['spans'])
+    for (_, hi, a), (lo, _, b) in zip(spans, spans[1:]):
+        if lo <= hi:
+            raise ValueError(f'Keycodes of {a} and {b} overlap at 0x{lo:04X}')
+
+
+def _generate_enum(lines, dispatch):
+    lines.append('')
+    lines.append('enum keycode_dispatch_handler {')
+    lines.append('    KEYCODE_DISPATCH_NONE,')
+    for handler in dispatch:
+        lines.append(f'    {_handler_id(handler)},')
+    lines.append('};')
+
+
+def _generate_lookup(lines, dispatch):
+    lines.append('')
+    lines.append('// Returns the handler that has to see the keycode, or KEYCODE_DISPATCH_NONE')
+    lines.append('static inline uint8_t keycode_dispatch_handler(uint16_t keycode) {')
+    lines.append('    switch (keycode) {')
+    for handler, value in dispatch.items():
+        lines.append(f'#if {value["condition"]}')
+        for _, _, label in value['spans']:
+            lines.append(f'        case {label}:')
+        lines.append(f'            return {_handler_id(handler)};')
+        lines.append('#endif')
+    lines.append('    }')
+    lines.append('    return KEYCODE_DISPATCH_NONE;')
+    lines.append('}')
+
+
+@cli.argument('-v', '--version', arg_only=True, required=True, help='Version of keycodes to generate.')
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.subcommand('Used by the make system to generate keycode_dispatch.h from keycodes_{version}.json', hidden=True)
+def generate_keycode_dispatch(cli):
+    """Generates the keycode_dispatch.h file.
+    """
+
+    # Build the keycode_dispatch.h file.
+    keycode_dispatch_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '// clang-format off']
+    keycode_dispatch_h_lines.append('')
+    keycode_dispatch_h_lines.append('#include <stdint.h>')
+    keycode_dispatch_h_lines.append('#include "keycodes.h"')
+
+    keycodes = load_spec(cli.args.version)
+    dispatch = json_load(Path('data/mappings/keycode_dispatch.hjson'))
+
+    for handler, value in dispatch.items():
+        value['spans'] = _resolve_ranges(keycodes, handler, value)
+    _check_overlaps(dispatch)
+
+    _generate_enum(keycode_dispatch_h_lines, dispatch)
+    _generate_lookup(keycode_dispatch_h_lines, dispatch)
+
+    # Show the results
+    dump_lines(cli.args.output, keycode_dispatch_h_lines, cli.args.quiet)
@@ -1,4 +1,5 @@
 import platform
+from pathlib import Path
 from subprocess import DEVNULL
 
 from milc import cli
@@ -264,6 +265,13 @@ def test_generate_rgb_breathe_table():
     assert 'Breathing max:    127' in result.stdout
 
 
+def test_generate_keycode_dispatch():
+    result = check_subcommand('generate-keycode-dispatch', '--version', 'latest')
+    check_returncode(result)
+    assert 'static inline uint8_t keycode_dispatch_handler(uint16_t keycode) {' in result.stdout
+    assert 'case QK_MAGIC ... QK_MAGIC_MAX:' in result.stdout
+
+
 def test_generate_config_h():
     result = check_subcommand('generate-config-h', '-kb', 'handwired/pytest/basic')
     check_returncode(result)
@@ -286,6 +294,19 @@ def test_generate_rules_mk():
     assert 'MCU ?= atmega32u4' in result.stdout
 
 
+def test_generate_autocorrect_data_external_flash(tmp_path):
+    fixture = Path('tests/autocorrect/autocorrect_external_flash')
+    output = tmp_path / 'autocorrect_data.h'
+    result = check_subcommand('generate-autocorrect-data', '--external-flash', '-q', '-o', str(output), str(fixture / 'autocorrect_dict.txt'))
+    check_returncode(result)
+    assert output.with_suffix('.bin').read_bytes() == (fixture / 'autocorrect_data.bin').read_bytes()
+
+    # The copyright line carries the year of generation
+    generated = [line for line in output.read_text().splitlines() if not line.startswith('// Copyright')]
+    committed = [line for line in (fixture / 'autocorrect_data.h').read_text().splitlines() if not line.startswith('// Copyright')]
+    assert generated == committed
+
+
 def test_generate_version_h():
     result = check_subcommand('generate-version-h')
     check_returncode(result)
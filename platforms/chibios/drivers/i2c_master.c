@@ -91,6 +91,20 @@
 #    endif
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#    if I2C_USE_MUTUAL_EXCLUSION != TRUE
+#        error "I2C_ASYNC_ENABLE requires I2C_USE_MUTUAL_EXCLUSION to be TRUE in halconf.h"
+#    endif
+// Must fit a copy of the largest register write, see i2c_write_register()
+#    ifndef I2C_ASYNC_THREAD_STACK_SIZE
+#        define I2C_ASYNC_THREAD_STACK_SIZE 512
+#    endif
+#    ifndef I2C_ASYNC_THREAD_PRIORITY
+#        define I2C_ASYNC_THREAD_PRIORITY (NORMALPRIO + 1)
+#    endif
+#endif
+
 static const I2CConfig i2cconfig = {
 #if defined(USE_I2CV1_CONTRIB)
     I2C1_CLOCK_SPEED,
@@ -118,6 +132,9 @@ static const I2CConfig i2cconfig = {
  */
 static i2c_status_t i2c_epilogue(const msg_t status) {
     if (status == MSG_OK) {
+#ifdef I2C_ASYNC_ENABLE
+        i2cReleaseBus(&I2C_DRIVER);
+#endif
         return I2C_STATUS_SUCCESS;
     }
 
@@ -125,10 +142,25 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
     // restarted because the bus is in an uncertain state." We also issue that
     // hard stop in case of any error.
     i2cStop(&I2C_DRIVER);
+#ifdef I2C_ASYNC_ENABLE
+    i2cReleaseBus(&I2C_DRIVER);
+#endif
 
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
 
+/**
+ * @brief Starts the I2C peripheral. With I2C_ASYNC_ENABLE, the bus is
+ * acquired first, as the async thread may be using it. It is released by
+ * i2c_epilogue().
+ */
+static void i2c_prologue(void) {
+#ifdef I2C_ASYNC_ENABLE
+    i2cAcquireBus(&I2C_DRIVER);
+#endif
+    i2cStart(&I2C_DRIVER, &i2cconfig);
+}
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -150,19 +182,19 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
 
     uint8_t complete_packet[length + 1];
     for (uint16_t i = 0; i < length; i++) {
@@ -175,7 +207,7 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
 
     uint8_t complete_packet[length + 2];
     for (uint16_t i = 0; i < length; i++) {
@@ -189,13 +221,13 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
@@ -207,4 +239,35 @@ __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t ti
     // This approach may produce false negative results for I2C devices that do not respond to a register 0 read request.
     uint8_t data = 0;
     return i2c_readReg(address, 0, &data, sizeof(data), timeout);
-}
\ No newline at end of file
+}
+
+#ifdef I2C_ASYNC_ENABLE
+// Transfers are run with the blocking functions above on a separate thread.
+// The I2C driver waits for its interrupts with the thread suspended, so
+// keyboard_task() keeps running in the meantime.
+static THD_WORKING_AREA(i2c_async_thread_wa, I2C_ASYNC_THREAD_STACK_SIZE);
+static BSEMAPHORE_DECL(i2c_async_start, true);
+static i2c_async_transaction_t *volatile i2c_async_next = NULL;
+
+static THD_FUNCTION(i2c_async_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chBSemWait(&i2c_async_start);
+        i2c_async_transaction_t *transaction = i2c_async_next;
+        i2c_async_transfer_done(transaction, i2c_async_execute(transaction));
+    }
+}
+
+void i2c_async_transfer_start(i2c_async_transaction_t *transaction) {
+    static bool thread_started = false;
+    if (!thread_started) {
+        thread_started = true;
+        chThdCreateStatic(i2c_async_thread_wa, sizeof(i2c_async_thread_wa), I2C_ASYNC_THREAD_PRIORITY, i2c_async_thread, NULL);
+    }
+
+    i2c_async_next = transaction;
+    chBSemSignal(&i2c_async_start);
+}
+#endif
@@ -3,6 +3,8 @@
 #include "util.h"
 #include "chibios_config.h"
 
+#include <string.h>
+
 /* Adapted from https://github.com/gamazeps/ws2812b-chibios-SPIDMA/ */
 
 // Define the spi your LEDs are plugged to here
@@ -86,57 +88,105 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// With WS2812_SPI_DOUBLE_BUFFER a frame is encoded into one buffer while the previous one is still being sent from the
+// other. The circular buffer is sent continuously, and a synchronous send returns once done, so both use one buffer.
+#if defined(WS2812_SPI_DOUBLE_BUFFER) && !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+#    define WS2812_SPI_BUFFER_COUNT 2
+#else
+#    define WS2812_SPI_BUFFER_COUNT 1
+#endif
+
+static uint8_t txbuf[WS2812_SPI_BUFFER_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+
+// The colors encoded in each buffer, so that only changed LEDs are encoded again
+static rgb_led_t encoded[WS2812_SPI_BUFFER_COUNT][WS2812_LED_COUNT];
+static bool      encoded_valid[WS2812_SPI_BUFFER_COUNT] = {0};
+
+#if WS2812_SPI_BUFFER_COUNT > 1
+// The buffer being sent, or sent last, and whether the other one is waiting for it to finish
+static volatile uint8_t tx_front   = 0;
+static volatile bool    tx_pending = false;
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, every byte is translated into 4 SPI bytes, one for
+ * each pair of bits starting from the most significant: 0b1000 for a 0 and
+ * 0b1110 for a 1 (with the appropriate timing).
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+#define WS2812_SPI_PAIR(data, pos) ((((data) >> (7 - 2 * (pos))) & 1 ? 0b11100000 : 0b10000000) | (((data) >> (6 - 2 * (pos))) & 1 ? 0b1110 : 0b1000))
+#define WS2812_SPI_BYTE(data) \
+    { WS2812_SPI_PAIR(data, 0), WS2812_SPI_PAIR(data, 1), WS2812_SPI_PAIR(data, 2), WS2812_SPI_PAIR(data, 3) }
+#define WS2812_SPI_BYTES_4(data) WS2812_SPI_BYTE(data), WS2812_SPI_BYTE(data + 1), WS2812_SPI_BYTE(data + 2), WS2812_SPI_BYTE(data + 3)
+#define WS2812_SPI_BYTES_16(data) WS2812_SPI_BYTES_4(data), WS2812_SPI_BYTES_4(data + 4), WS2812_SPI_BYTES_4(data + 8), WS2812_SPI_BYTES_4(data + 12)
+#define WS2812_SPI_BYTES_64(data) WS2812_SPI_BYTES_16(data), WS2812_SPI_BYTES_16(data + 16), WS2812_SPI_BYTES_16(data + 32), WS2812_SPI_BYTES_16(data + 48)
+
+static const uint8_t protocol_eq[256][BYTES_FOR_LED_BYTE] = {
+    WS2812_SPI_BYTES_64(0),
+    WS2812_SPI_BYTES_64(64),
+    WS2812_SPI_BYTES_64(128),
+    WS2812_SPI_BYTES_64(192),
+};
+
+static inline void set_led_byte(uint8_t* tx, uint8_t data) {
+    memcpy(tx, protocol_eq[data], BYTES_FOR_LED_BYTE);
 }
 
-static void set_led_color_rgb(rgb_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+static void set_led_color_rgb(uint8_t* buffer, rgb_led_t color, int pos) {
+    uint8_t* tx_start = &buffer[PREAMBLE_SIZE + BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(tx_start, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.r);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(tx_start, color.r);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    set_led_byte(tx_start, color.b);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.r);
 #endif
 #ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 3, color.w);
 #endif
 }
 
+static void encode_leds(uint8_t index, rgb_led_t* ledarray, uint16_t leds) {
+    if (leds > WS2812_LED_COUNT) {
+        leds = WS2812_LED_COUNT;
+    }
+
+    for (uint16_t i = 0; i < leds; i++) {
+        if (encoded_valid[index] && memcmp(&encoded[index][i], &ledarray[i], sizeof(rgb_led_t)) == 0) {
+            continue;
+        }
+        set_led_color_rgb(txbuf[index], ledarray[i], i);
+        encoded[index][i] = ledarray[i];
+    }
+    // LEDs past the end were not encoded on the first call
+    encoded_valid[index] = encoded_valid[index] || leds == WS2812_LED_COUNT;
+}
+
+#if WS2812_SPI_BUFFER_COUNT > 1
+// Sends the buffer encoded while the previous one was on the wire
+static void spi_end_cb(SPIDriver* spip) {
+    chSysLockFromISR();
+    if (tx_pending) {
+        tx_pending = false;
+        tx_front   = 1 - tx_front;
+        // The HAL keeps the driver in SPI_COMPLETE during the callback and only makes it ready afterwards if the
+        // callback did not start another transfer, but spiStartSendI() expects it to be ready
+        spip->state = SPI_READY;
+        spiStartSendI(spip, ARRAY_SIZE(txbuf[0]), txbuf[tx_front]);
+    }
+    chSysUnlockFromISR();
+}
+#else
+#    define spi_end_cb NULL
+#endif
+
 void ws2812_init(void) {
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
@@ -151,7 +201,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        spi_end_cb, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -170,8 +220,8 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
-        NULL, // error_cb
+        spi_end_cb, // data_cb
+        NULL,       // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
         WS2812_SPI_DIVISOR_CR1_BR_X,
@@ -183,7 +233,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
 #endif
 }
 
@@ -194,17 +244,36 @@ void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
         s_init = true;
     }
 
-    for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
+#if WS2812_SPI_BUFFER_COUNT > 1
+    // Take the queued buffer back if it has not been started yet, as its frame is out of date by now
+    chSysLock();
+    tx_pending   = false;
+    uint8_t back = 1 - tx_front;
+    chSysUnlock();
+
+    encode_leds(back, ledarray, leds);
+
+    // Never wait for the strip: if the previous frame is still being sent, spi_end_cb() sends this one after it.
+    // Frames rendered faster than the strip can take them are dropped, but the latest one is always sent.
+    chSysLock();
+    if (WS2812_SPI_DRIVER.state == SPI_READY) {
+        tx_front = back;
+        spiStartSendI(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[back]);
+    } else {
+        tx_pending = true;
     }
+    chSysUnlock();
+#else
+    encode_leds(0, ledarray, leds);
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
-#ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
-#    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
-#    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    // Instead spiSend can be used to send synchronously, or WS2812_SPI_DOUBLE_BUFFER to queue the next frame.
+#    ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
+#        ifdef WS2812_SPI_SYNC
+    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
+#        else
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
+#        endif
 #    endif
 #endif
 }
@@ -0,0 +1,125 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "i2c_master.h"
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
+
+static uint8_t             mock_registers[256];
+static i2c_mock_transfer_t mock_log[I2C_MOCK_LOG_LENGTH];
+static uint16_t            mock_log_count = 0;
+static i2c_status_t        mock_status    = I2C_STATUS_SUCCESS;
+
+static i2c_status_t mock_transfer(uint8_t address, uint16_t regaddr, uint16_t length, bool read) {
+    if (mock_log_count < I2C_MOCK_LOG_LENGTH) {
+        mock_log[mock_log_count] = (i2c_mock_transfer_t){.address = address, .regaddr = regaddr, .length = length, .read = read};
+    }
+    mock_log_count++;
+    return mock_status;
+}
+
+static void mock_write(uint16_t regaddr, const uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        mock_registers[(uint8_t)(regaddr + i)] = data[i];
+    }
+}
+
+static void mock_read(uint16_t regaddr, uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = mock_registers[(uint8_t)(regaddr + i)];
+    }
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    return mock_transfer(address, 0, length, false);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    mock_read(0, data, length);
+    return mock_transfer(address, 0, length, true);
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    mock_write(regaddr, data, length);
+    return mock_transfer(devaddr, regaddr, length, false);
+}
+
+i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    mock_write(regaddr, data, length);
+    return mock_transfer(devaddr, regaddr, length, false);
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    mock_read(regaddr, data, length);
+    return mock_transfer(devaddr, regaddr, length, true);
+}
+
+i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    mock_read(regaddr, data, length);
+    return mock_transfer(devaddr, regaddr, length, true);
+}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    return mock_transfer(address, 0, 0, false);
+}
+
+#ifdef I2C_ASYNC_ENABLE
+static bool                     mock_hold = false;
+static i2c_async_transaction_t* mock_held = NULL;
+
+void i2c_async_transfer_start(i2c_async_transaction_t* transaction) {
+    if (mock_hold) {
+        mock_held = transaction;
+    } else {
+        i2c_async_transfer_done(transaction, i2c_async_execute(transaction));
+    }
+}
+
+bool i2c_mock_complete_transfer(void) {
+    i2c_async_transaction_t* transaction = mock_held;
+    if (transaction == NULL) {
+        return false;
+    }
+    mock_held = NULL;
+    i2c_async_transfer_done(transaction, i2c_async_execute(transaction));
+    return true;
+}
+
+void i2c_mock_hold_transfers(bool hold) {
+    mock_hold = hold;
+}
+#else
+bool i2c_mock_complete_transfer(void) {
+    return false;
+}
+
+void i2c_mock_hold_transfers(bool hold) {}
+#endif
+
+void i2c_mock_reset(void) {
+    memset(mock_registers, 0, sizeof(mock_registers));
+    mock_log_count = 0;
+    mock_status    = I2C_STATUS_SUCCESS;
+    i2c_mock_hold_transfers(false);
+}
+
+void i2c_mock_set_status(i2c_status_t status) {
+    mock_status = status;
+}
+
+uint8_t* i2c_mock_registers(void) {
+    return mock_registers;
+}
+
+uint16_t i2c_mock_transfer_count(void) {
+    return mock_log_count;
+}
+
+const i2c_mock_transfer_t* i2c_mock_get_transfer(uint16_t index) {
+    return index < mock_log_count && index < I2C_MOCK_LOG_LENGTH ? &mock_log[index] : NULL;
+}
@@ -0,0 +1,67 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Mock I2C bus for the test platform.
+ *
+ * Every device shares one 256 byte register file: register writes store into it, register reads return from it.
+ * Transfers are logged in the order they reach the bus. Async transfers finish immediately, unless they are held until
+ * the test calls i2c_mock_complete_transfer().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout);
+
+#ifndef I2C_MOCK_LOG_LENGTH
+#    define I2C_MOCK_LOG_LENGTH 64
+#endif
+
+typedef struct {
+    uint8_t  address;
+    uint16_t regaddr; // 0 for plain transmits and receives
+    uint16_t length;
+    bool     read;
+} i2c_mock_transfer_t;
+
+/** \brief Clears the log and the registers, and goes back to successful, immediately finishing transfers. */
+void i2c_mock_reset(void);
+
+/** \brief Sets the status returned by the following transfers. */
+void i2c_mock_set_status(i2c_status_t status);
+
+/** \brief Holds async transfers on the bus until i2c_mock_complete_transfer() is called. */
+void i2c_mock_hold_transfers(bool hold);
+
+/** \brief Finishes the held async transfer. Returns false if there is none. */
+bool i2c_mock_complete_transfer(void);
+
+uint8_t*                   i2c_mock_registers(void);
+uint16_t                   i2c_mock_transfer_count(void);
+const i2c_mock_transfer_t* i2c_mock_get_transfer(uint16_t index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,140 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_link.h"
+#include "transactions.h"
+#include "transport.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+static serial_link_config_t   link_config;
+static serial_link_stats_t    link_stats;
+static split_shared_memory_t  other_memory; // the half that is not currently running
+static bool                   link_connected = true;
+static uint32_t               link_random;
+static uint64_t               link_now_us;
+static uint32_t               link_pending_us; // not yet added to the millisecond timer
+static serial_link_observer_t link_observer;
+
+static void swap_memory(void) {
+    split_shared_memory_t temp;
+    memcpy(&temp, split_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_shmem, &other_memory, sizeof(split_shared_memory_t));
+    memcpy(&other_memory, &temp, sizeof(split_shared_memory_t));
+}
+
+static uint32_t next_random(void) {
+    // xorshift32, reproducible for a given seed
+    link_random ^= link_random << 13;
+    link_random ^= link_random >> 17;
+    link_random ^= link_random << 5;
+    return link_random;
+}
+
+static void transfer(uint8_t *destination, const uint8_t *source, uint8_t length) {
+    for (uint8_t i = 0; i < length; i++) {
+        uint8_t byte = source[i];
+        for (uint8_t bit = 0; link_config.bit_error_rate && bit < 8; bit++) {
+            if (next_random() % link_config.bit_error_rate == 0) {
+                byte ^= 1 << bit;
+                link_stats.bit_errors++;
+            }
+        }
+        destination[i] = byte;
+    }
+    link_stats.bytes += length;
+}
+
+void serial_link_reset(void) {
+    memset(&link_config, 0, sizeof(link_config));
+    memset(&link_stats, 0, sizeof(link_stats));
+    memset(&other_memory, 0, sizeof(other_memory));
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    link_connected  = true;
+    link_random     = 1;
+    link_now_us     = 0;
+    link_pending_us = 0;
+    link_observer   = NULL;
+}
+
+void serial_link_configure(const serial_link_config_t *config) {
+    link_config = *config;
+    link_random = config->seed ? config->seed : 1;
+}
+
+void serial_link_get_stats(serial_link_stats_t *stats) {
+    *stats = link_stats;
+}
+
+void serial_link_set_observer(serial_link_observer_t observer) {
+    link_observer = observer;
+}
+
+uint32_t serial_link_transaction_us(int sstd_index) {
+    split_transaction_desc_t *trans = &split_transaction_table[sstd_index];
+
+    // Transaction ID plus both buffers, ten bits per byte with start and stop bits
+    uint32_t duration = link_config.latency_us;
+    if (link_config.bitrate) {
+        duration += (uint64_t)(1 + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size) * 10 * 1000000 / link_config.bitrate;
+    }
+    return duration;
+}
+
+void serial_link_set_connected(bool connected) {
+    link_connected = connected;
+}
+
+void serial_link_enter_slave(void) {
+    swap_memory();
+}
+
+void serial_link_exit_slave(void) {
+    swap_memory();
+}
+
+void serial_link_advance_us(uint32_t us) {
+    link_now_us += us;
+    link_pending_us += us;
+    if (link_pending_us >= 1000) {
+        advance_time(link_pending_us / 1000);
+        link_pending_us %= 1000;
+    }
+}
+
+uint64_t serial_link_now_us(void) {
+    return link_now_us;
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int sstd_index) {
+    split_transaction_desc_t *trans    = &split_transaction_table[sstd_index];
+    uint32_t                  duration = serial_link_transaction_us(sstd_index);
+    link_stats.transactions++;
+    link_stats.elapsed_us += duration;
+    serial_link_advance_us(duration);
+
+    if (!link_connected) {
+        link_stats.failed++;
+        return false;
+    }
+
+    transfer(((uint8_t *)&other_memory) + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    if (trans->slave_callback) {
+        swap_memory();
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        swap_memory();
+    }
+    transfer(split_trans_target2initiator_buffer(trans), ((uint8_t *)&other_memory) + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    if (link_observer) {
+        link_observer(sstd_index, duration);
+    }
+    return true;
+}
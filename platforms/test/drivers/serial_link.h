@@ -0,0 +1,71 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief In-memory implementation of the split serial driver, connecting a master and a slave that run in the same
+ * process.
+ *
+ * Both halves share the one split_shmem, the link keeps the other half's copy and swaps the two around whenever the
+ * slave runs, either through serial_link_enter_slave() or to execute a transaction's slave callback. Transfers take
+ * simulated time, which advances the test timer.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t bitrate;        // bits per second on the wire, 0 for transfers that take no time
+    uint32_t latency_us;     // turnaround between the halves, added once per transaction
+    uint32_t bit_error_rate; // one in this many transferred bits is flipped, 0 for none
+    uint32_t seed;           // seed of the bit error generator
+} serial_link_config_t;
+
+typedef struct {
+    uint32_t transactions; // attempted, including failed ones
+    uint32_t failed;       // not answered because the link is disconnected
+    uint32_t bytes;        // payload bytes transferred in both directions, excluding the transaction ID
+    uint32_t bit_errors;
+    uint64_t elapsed_us; // simulated time spent in transactions
+} serial_link_stats_t;
+
+/** \brief Called after each answered transaction, while split_shmem still holds the master's copy of both buffers
+ */
+typedef void (*serial_link_observer_t)(int sstd_index, uint32_t duration_us);
+
+/** \brief Reconnects the link and forgets the slave's memory, the statistics and any configuration
+ */
+void serial_link_reset(void);
+
+void serial_link_configure(const serial_link_config_t *config);
+
+void serial_link_get_stats(serial_link_stats_t *stats);
+
+/** \brief Sets the function called after each transaction, until serial_link_reset()
+ */
+void serial_link_set_observer(serial_link_observer_t observer);
+
+/** \brief Simulated time a transaction takes with the current configuration, whether or not it is performed
+ */
+uint32_t serial_link_transaction_us(int sstd_index);
+
+/** \brief Makes transactions fail as if the slave was unplugged
+ */
+void serial_link_set_connected(bool connected);
+
+/** \brief Switches split_shmem over to the slave's copy, until serial_link_exit_slave()
+ */
+void serial_link_enter_slave(void);
+
+void serial_link_exit_slave(void);
+
+/** \brief Advances simulated time, used for the transactions themselves as well as for the work done between them
+ */
+void serial_link_advance_us(uint32_t us);
+
+/** \brief Simulated time since the last serial_link_reset()
+ */
+uint64_t serial_link_now_us(void);
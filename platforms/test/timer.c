@@ -20,6 +20,7 @@
 static atomic_uint_least32_t current_time      = 0;
 static atomic_uint_least32_t async_tick_amount = 0;
 static atomic_uint_least32_t access_counter    = 0;
+static atomic_uint_least32_t current_ticks     = 0;
 
 void simulate_async_tick(uint32_t t) {
     async_tick_amount = t;
@@ -39,12 +40,14 @@ void reset_access_counter(void) {
 
 void timer_init(void) {
     current_time      = 0;
+    current_ticks     = 0;
     async_tick_amount = 0;
     access_counter    = 0;
 }
 
 void timer_clear(void) {
     current_time      = 0;
+    current_ticks     = 0;
     async_tick_amount = 0;
     access_counter    = 0;
 }
@@ -81,3 +84,16 @@ void advance_time(uint32_t ms) {
 void wait_ms(uint32_t ms) {
     advance_time(ms);
 }
+
+// Microsecond counter for the profiler, following the millisecond time plus whatever advance_ticks() added
+uint32_t profiler_timer_read(void) {
+    return current_time * 1000 + current_ticks;
+}
+
+uint32_t profiler_timer_ticks_to_us(uint32_t ticks) {
+    return ticks;
+}
+
+void advance_ticks(uint32_t us) {
+    current_ticks += us;
+}
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -289,6 +290,27 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+/** \brief resolved layer cache
+ *
+ * Topmost non-transparent layer of each matrix position for layer_lookup_cache_state,
+ * LAYER_LOOKUP_CACHE_UNRESOLVED until the position is first looked up.
+ */
+#    define LAYER_LOOKUP_CACHE_UNRESOLVED 0xFF
+
+static uint8_t       layer_lookup_cache[MATRIX_ROWS * MATRIX_COLS];
+static layer_state_t layer_lookup_cache_state = 0;
+static bool          layer_lookup_cache_dirty = true;
+
+/** \brief invalidate resolved layer cache
+ *
+ * Forces every position to be resolved again on its next lookup. Must be called whenever the keymap contents change.
+ */
+void layer_lookup_cache_invalidate(void) {
+    layer_lookup_cache_dirty = true;
+}
+#endif
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -316,16 +338,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer resolve
  *
- * Gets the layer based on key info
+ * Walks the supplied layer stack from the top and returns the first layer with a non-transparent action for the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_resolve(layer_state_t layers, keypos_t key) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +358,32 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_LOOKUP_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        if (layer_lookup_cache_dirty || layers != layer_lookup_cache_state) {
+            memset(layer_lookup_cache, LAYER_LOOKUP_CACHE_UNRESOLVED, sizeof(layer_lookup_cache));
+            layer_lookup_cache_state = layers;
+            layer_lookup_cache_dirty = false;
+        }
+
+        uint8_t *entry = &layer_lookup_cache[(uint16_t)(key.row * MATRIX_COLS) + key.col];
+        if (*entry == LAYER_LOOKUP_CACHE_UNRESOLVED) {
+            *entry = layer_resolve(layers, key);
+        }
+        return *entry;
+    }
+#    endif // LAYER_LOOKUP_CACHE
+    return layer_resolve(layers, key);
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -97,16 +97,73 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     return rgb;
 }
 
+#ifdef HSV_TO_RGB_LUT
+#    if HSV_TO_RGB_LUT_SIZE != 256 && HSV_TO_RGB_LUT_SIZE != 128 && HSV_TO_RGB_LUT_SIZE != 64 && HSV_TO_RGB_LUT_SIZE != 32
+#        error "HSV_TO_RGB_LUT_SIZE must be 32, 64, 128 or 256"
+#    endif
+
+// Every channel is v * (white - s * k[h]), where k is how much of the channel saturation takes away for the hue: 0
+// for the channel at v, 255 for the one at p, and the remainder in between for q and t. The white balance scales both
+// terms, so it is folded into k and no branch or division is left at runtime.
+// clang-format off
+#    define HSV_LUT_HUE(i) ((i) * (256 / HSV_TO_RGB_LUT_SIZE))
+#    define HSV_LUT_REGION(h) ((h) * 6 / 255)
+#    define HSV_LUT_REM(h) ((((h) * 2 - HSV_LUT_REGION(h) * 85) * 3) & 0xFF)
+#    define HSV_LUT_K_R(h) (HSV_LUT_REGION(h) == 1 ? HSV_LUT_REM(h) : HSV_LUT_REGION(h) == 2 || HSV_LUT_REGION(h) == 3 ? 255 : HSV_LUT_REGION(h) == 4 ? 255 - HSV_LUT_REM(h) : 0)
+#    define HSV_LUT_K_G(h) (HSV_LUT_REGION(h) == 0 || HSV_LUT_REGION(h) == 6 ? 255 - HSV_LUT_REM(h) : HSV_LUT_REGION(h) == 3 ? HSV_LUT_REM(h) : HSV_LUT_REGION(h) >= 4 ? 255 : 0)
+#    define HSV_LUT_K_B(h) (HSV_LUT_REGION(h) <= 1 || HSV_LUT_REGION(h) == 6 ? 255 : HSV_LUT_REGION(h) == 2 ? 255 - HSV_LUT_REM(h) : HSV_LUT_REGION(h) == 5 ? HSV_LUT_REM(h) : 0)
+#    define HSV_LUT_BALANCE(k, white) (((k) * (white) + 127) / 255)
+#    define HSV_LUT_ENTRY(i) {HSV_LUT_BALANCE(HSV_LUT_K_R(HSV_LUT_HUE(i)), HSV_TO_RGB_WHITE_BALANCE_R), HSV_LUT_BALANCE(HSV_LUT_K_G(HSV_LUT_HUE(i)), HSV_TO_RGB_WHITE_BALANCE_G), HSV_LUT_BALANCE(HSV_LUT_K_B(HSV_LUT_HUE(i)), HSV_TO_RGB_WHITE_BALANCE_B)}
+#    define HSV_LUT_ENTRIES_4(i) HSV_LUT_ENTRY(i), HSV_LUT_ENTRY(i + 1), HSV_LUT_ENTRY(i + 2), HSV_LUT_ENTRY(i + 3)
+#    define HSV_LUT_ENTRIES_16(i) HSV_LUT_ENTRIES_4(i), HSV_LUT_ENTRIES_4(i + 4), HSV_LUT_ENTRIES_4(i + 8), HSV_LUT_ENTRIES_4(i + 12)
+#    define HSV_LUT_ENTRIES_32(i) HSV_LUT_ENTRIES_16(i), HSV_LUT_ENTRIES_16(i + 16)
+#    define HSV_LUT_ENTRIES_64(i) HSV_LUT_ENTRIES_32(i), HSV_LUT_ENTRIES_32(i + 32)
+#    define HSV_LUT_ENTRIES_128(i) HSV_LUT_ENTRIES_64(i), HSV_LUT_ENTRIES_64(i + 64)
+#    define HSV_LUT_ENTRIES_256(i) HSV_LUT_ENTRIES_128(i), HSV_LUT_ENTRIES_128(i + 128)
+#    define HSV_LUT_ENTRIES_N(n) HSV_LUT_ENTRIES_##n(0)
+#    define HSV_LUT_ENTRIES(n) HSV_LUT_ENTRIES_N(n)
+
+static const uint8_t hsv_to_rgb_lut[HSV_TO_RGB_LUT_SIZE][3] PROGMEM = {HSV_LUT_ENTRIES(HSV_TO_RGB_LUT_SIZE)};
+// clang-format on
+
+static inline uint8_t hsv_to_rgb_lut_channel(uint8_t v, uint8_t s, uint16_t white, uint8_t k) {
+    // Kept in 16 bits, as int is only 16 bits wide on AVR: s * k <= 65025 and v * (white + 1 - ...) <= 65280
+    uint16_t scale = white + 1 - (((uint16_t)s * k) >> 8);
+    return ((uint16_t)v * scale) >> 8;
+}
+
+RGB hsv_to_rgb_lut_impl(HSV hsv, bool use_cie) {
+    RGB            rgb;
+    const uint8_t *k = hsv_to_rgb_lut[hsv.h / (256 / HSV_TO_RGB_LUT_SIZE)];
+    uint8_t        v = hsv.v;
+
+#    ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        v = pgm_read_byte(&CIE1931_CURVE[v]);
+    }
+#    endif
+
+    rgb.r = hsv_to_rgb_lut_channel(v, hsv.s, HSV_TO_RGB_WHITE_BALANCE_R, pgm_read_byte(&k[0]));
+    rgb.g = hsv_to_rgb_lut_channel(v, hsv.s, HSV_TO_RGB_WHITE_BALANCE_G, pgm_read_byte(&k[1]));
+    rgb.b = hsv_to_rgb_lut_channel(v, hsv.s, HSV_TO_RGB_WHITE_BALANCE_B, pgm_read_byte(&k[2]));
+    return rgb;
+}
+
+#    define HSV_TO_RGB_IMPL hsv_to_rgb_lut_impl
+#else
+#    define HSV_TO_RGB_IMPL hsv_to_rgb_impl
+#endif // HSV_TO_RGB_LUT
+
 RGB hsv_to_rgb(HSV hsv) {
 #ifdef USE_CIE1931_CURVE
-    return hsv_to_rgb_impl(hsv, true);
+    return HSV_TO_RGB_IMPL(hsv, true);
 #else
-    return hsv_to_rgb_impl(hsv, false);
+    return HSV_TO_RGB_IMPL(hsv, false);
 #endif
 }
 
 RGB hsv_to_rgb_nocie(HSV hsv) {
-    return hsv_to_rgb_impl(hsv, false);
+    return HSV_TO_RGB_IMPL(hsv, false);
 }
 
 #ifdef RGBW
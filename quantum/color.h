@@ -109,6 +109,23 @@ typedef struct PACKED HSV {
     uint8_t v;
 } HSV;
 
+#ifdef HSV_TO_RGB_LUT
+// Number of hues in the conversion table, which takes 3 bytes of flash per hue
+#    ifndef HSV_TO_RGB_LUT_SIZE
+#        define HSV_TO_RGB_LUT_SIZE 256
+#    endif
+// Output of each channel for white at full brightness
+#    ifndef HSV_TO_RGB_WHITE_BALANCE_R
+#        define HSV_TO_RGB_WHITE_BALANCE_R 255
+#    endif
+#    ifndef HSV_TO_RGB_WHITE_BALANCE_G
+#        define HSV_TO_RGB_WHITE_BALANCE_G 255
+#    endif
+#    ifndef HSV_TO_RGB_WHITE_BALANCE_B
+#        define HSV_TO_RGB_WHITE_BALANCE_B 255
+#    endif
+#endif
+
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
 #ifdef RGBW
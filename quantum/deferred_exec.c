@@ -15,6 +15,7 @@
 
 static deferred_token current_token = 0;
 
+#ifndef DEFERRED_EXEC_HEAP_SCHEDULER
 static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
     if (token == INVALID_DEFERRED_TOKEN) {
         return false;
@@ -38,11 +39,304 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
     }
     return current_token;
 }
+#endif // DEFERRED_EXEC_HEAP_SCHEDULER
 
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //
 
+#ifdef DEFERRED_EXEC_HEAP_SCHEDULER
+
+// Entries never move once queued: a token always maps to the same slot, slot = (token - 1) % table_count, so it is
+// found without searching. The heap ordering the entries on trigger_time is kept as a permutation of slot numbers,
+// spread over the entries themselves: heap_slot of entry i holds the slot at heap position i, and heap_pos of entry i
+// holds the heap position of slot i. Both are stored XOR'ed with i so that a zeroed table is the identity permutation.
+//
+// Positions [0, used) of the permutation hold the queued entries as a binary min-heap, and the remaining positions
+// hold the free slots, so queueing takes the slot at position used. The task only has to check the root to know
+// whether anything is due.
+//
+// While deferred_exec_advanced_task() is running callbacks, the due entries are "parked" directly after the heap so
+// that their positions are not moved around by callbacks queueing or cancelling other entries. Entries queued from within a
+// callback are appended after the parked region, and everything is merged back into the heap once the pass completes.
+
+_Static_assert(MAX_DEFERRED_EXECUTORS <= UINT8_MAX, "The heap scheduler supports at most 255 deferred executors per table");
+
+static deferred_executor_t *pass_table      = NULL; // table currently executing callbacks, if any
+static size_t               pass_heap_count = 0;    // heap region of pass_table is [0, pass_heap_count)
+static size_t               pass_used_count = 0;    // parked region of pass_table is [pass_heap_count, pass_used_count)
+
+static inline size_t slot_at(const deferred_executor_t *table, size_t pos) {
+    return table[pos].heap_slot ^ (uint8_t)pos;
+}
+
+static inline size_t pos_of(const deferred_executor_t *table, size_t slot) {
+    return table[slot].heap_pos ^ (uint8_t)slot;
+}
+
+static inline deferred_executor_t *entry_at(deferred_executor_t *table, size_t pos) {
+    return &table[slot_at(table, pos)];
+}
+
+static inline void heap_place(deferred_executor_t *table, size_t pos, size_t slot) {
+    table[pos].heap_slot = (uint8_t)(slot ^ pos);
+    table[slot].heap_pos = (uint8_t)(pos ^ slot);
+}
+
+static inline bool entry_before(deferred_executor_t *table, size_t a, size_t b) {
+    return ((int32_t)TIMER_DIFF_32(entry_at(table, a)->trigger_time, entry_at(table, b)->trigger_time)) < 0;
+}
+
+static inline void entry_clear(deferred_executor_t *entry) {
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+}
+
+static inline void heap_swap(deferred_executor_t *table, size_t a, size_t b) {
+    size_t slot_a = slot_at(table, a);
+    heap_place(table, a, slot_at(table, b));
+    heap_place(table, b, slot_a);
+}
+
+static void heap_sift_up(deferred_executor_t *table, size_t pos) {
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!entry_before(table, pos, parent)) {
+            break;
+        }
+        heap_swap(table, pos, parent);
+        pos = parent;
+    }
+}
+
+static void heap_sift_down(deferred_executor_t *table, size_t heap_count, size_t pos) {
+    while (true) {
+        size_t smallest = pos;
+        size_t left     = 2 * pos + 1;
+        size_t right    = left + 1;
+        if (left < heap_count && entry_before(table, left, smallest)) {
+            smallest = left;
+        }
+        if (right < heap_count && entry_before(table, right, smallest)) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+        heap_swap(table, pos, smallest);
+        pos = smallest;
+    }
+}
+
+// Removes the entry at pos from a heap of heap_count entries, leaving its cleared slot at position heap_count-1.
+static void heap_remove(deferred_executor_t *table, size_t heap_count, size_t pos) {
+    size_t last = heap_count - 1;
+    entry_clear(entry_at(table, pos));
+    if (pos != last) {
+        heap_swap(table, pos, last);
+        heap_sift_up(table, pos);
+        heap_sift_down(table, last, pos);
+    }
+}
+
+static size_t used_count(deferred_executor_t *table, size_t table_count) {
+    if (table == pass_table) {
+        return pass_used_count;
+    }
+
+    // Queued entries are at the start of the permutation, so binary search for the first free slot
+    size_t lo = 0;
+    size_t hi = table_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (entry_at(table, mid)->token != INVALID_DEFERRED_TOKEN) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static inline size_t heap_count(deferred_executor_t *table, size_t table_count) {
+    return table == pass_table ? pass_heap_count : used_count(table, table_count);
+}
+
+static bool find_entry(deferred_executor_t *table, size_t table_count, deferred_token token, size_t *pos) {
+    size_t slot = (token - 1) % table_count;
+    if (table[slot].token != token) {
+        return false;
+    }
+    *pos = pos_of(table, slot);
+    return true;
+}
+
+static inline deferred_token allocate_slot_token(size_t table_count, size_t slot) {
+    // The next token after the last one handed out that maps to this slot, wrapping around
+    size_t token = current_token + 1 + (slot + table_count - current_token % table_count) % table_count;
+    if (token > UINT8_MAX) {
+        token = slot + 1;
+    }
+    current_token = (deferred_token)token;
+    return current_token;
+}
+
+deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
+    // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
+    if (!table || table_count == 0 || table_count > UINT8_MAX || delay_ms == 0 || !callback) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // Claim the first unused slot, none available if the table is full
+    size_t used = used_count(table, table_count);
+    if (used >= table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // Set up the executor table entry
+    size_t               slot  = slot_at(table, used);
+    deferred_executor_t *entry = &table[slot];
+    entry->token               = allocate_slot_token(table_count, slot);
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+
+    if (table == pass_table) {
+        // Queued from a callback, merged into the heap at the end of the pass
+        ++pass_used_count;
+    } else {
+        heap_sift_up(table, used);
+    }
+    return entry->token;
+}
+
+bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
+    // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
+    if (!table || table_count == 0 || delay_ms == 0 || token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+
+    // Find the entry corresponding to the token
+    size_t pos;
+    if (!find_entry(table, table_count, token, &pos)) {
+        return false;
+    }
+
+    // Found it, extend the delay and restore heap order -- parked entries are reordered at the end of the pass
+    entry_at(table, pos)->trigger_time = timer_read32() + delay_ms;
+    size_t heap                        = heap_count(table, table_count);
+    if (pos < heap) {
+        heap_sift_up(table, pos);
+        heap_sift_down(table, heap, pos);
+    }
+    return true;
+}
+
+bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    // Ignore request if the table/token are not valid
+    if (!table || table_count == 0 || token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+
+    // Find the entry corresponding to the token
+    size_t pos;
+    if (!find_entry(table, table_count, token, &pos)) {
+        return false;
+    }
+
+    size_t heap = heap_count(table, table_count);
+    if (pos >= heap) {
+        // Parked during a pass, leave a hole that gets compacted when the pass completes
+        entry_clear(entry_at(table, pos));
+    } else {
+        // The freed slot at the end of the heap becomes part of the parked region during a pass
+        heap_remove(table, heap, pos);
+        if (table == pass_table) {
+            --pass_heap_count;
+        }
+    }
+    return true;
+}
+
+void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+    uint32_t now = timer_read32();
+
+    // Throttle only once per millisecond
+    if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
+        *last_execution_time = now;
+
+        // Nothing to do unless the earliest entry is due
+        size_t used = used_count(table, table_count);
+        if (used == 0 || ((int32_t)TIMER_DIFF_32(entry_at(table, 0)->trigger_time, now)) > 0) {
+            return;
+        }
+
+        // Pop every due entry off the heap; each one lands just past the shrinking heap, latest trigger first
+        size_t heap = used;
+        while (heap > 0 && ((int32_t)TIMER_DIFF_32(entry_at(table, 0)->trigger_time, now)) <= 0) {
+            --heap;
+            heap_swap(table, 0, heap);
+            heap_sift_down(table, heap, 0);
+        }
+
+        // Support execution of a different table from within a callback
+        deferred_executor_t *prev_table      = pass_table;
+        size_t               prev_heap_count = pass_heap_count;
+        size_t               prev_used_count = pass_used_count;
+        pass_table                           = table;
+        pass_heap_count                      = heap;
+        pass_used_count                      = used;
+
+        // Run through each of the due executors, earliest trigger first
+        for (size_t i = used; i-- > heap;) {
+            deferred_executor_t *entry      = entry_at(table, i);
+            deferred_token       curr_token = entry->token;
+
+            // Skip entries cancelled or extended by an earlier callback in this pass
+            if (curr_token == INVALID_DEFERRED_TOKEN || ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                continue;
+            }
+
+            // Invoke the callback and work work out if we should be requeued
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
+            if (entry->token != curr_token) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time, keeping invocations relative to the previous trigger.
+                entry->trigger_time += delay_ms;
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                entry_clear(entry);
+            }
+        }
+
+        // Merge the parked and newly queued entries back into the heap, moving freed slots past the end of it
+        heap = pass_heap_count;
+        for (size_t i = heap; i < pass_used_count; ++i) {
+            if (entry_at(table, i)->token != INVALID_DEFERRED_TOKEN) {
+                if (i != heap) {
+                    heap_swap(table, heap, i);
+                }
+                heap_sift_up(table, heap);
+                ++heap;
+            }
+        }
+
+        pass_table      = prev_table;
+        pass_heap_count = prev_heap_count;
+        pass_used_count = prev_used_count;
+    }
+}
+
+#else // DEFERRED_EXEC_HEAP_SCHEDULER
+
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
     if (!table || table_count == 0 || delay_ms == 0 || !callback) {
@@ -156,6 +450,8 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     }
 }
 
+#endif // DEFERRED_EXEC_HEAP_SCHEDULER
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -79,6 +79,10 @@ typedef struct deferred_executor_t {
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
+#ifdef DEFERRED_EXEC_HEAP_SCHEDULER
+    uint8_t heap_slot;
+    uint8_t heap_pos;
+#endif // DEFERRED_EXEC_HEAP_SCHEDULER
 } deferred_executor_t;
 
 /**
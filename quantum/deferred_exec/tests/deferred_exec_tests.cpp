@@ -0,0 +1,374 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// These tests are built against both the linear and the heap scheduler, so
+// that both implementations are held to the same observable behaviour.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define TABLE_SIZE 8
+
+struct invocation {
+    int      id;
+    uint32_t now;
+    uint32_t trigger_time;
+};
+
+class DeferredExecTest : public ::testing::Test {
+   public:
+    void SetUp() override {
+        self = this;
+        set_time(1000);
+        last_exec = timer_read32();
+        for (auto &entry : table) {
+            entry = {};
+        }
+        invocations.clear();
+        repeat_ms = 0;
+    }
+
+    void TearDown() override {
+        self = nullptr;
+    }
+
+    deferred_token defer(uint32_t delay_ms, deferred_exec_callback callback, intptr_t id) {
+        return defer_exec_advanced(table, TABLE_SIZE, delay_ms, callback, (void *)id);
+    }
+
+    bool extend(deferred_token token, uint32_t delay_ms) {
+        return extend_deferred_exec_advanced(table, TABLE_SIZE, token, delay_ms);
+    }
+
+    bool cancel(deferred_token token) {
+        return cancel_deferred_exec_advanced(table, TABLE_SIZE, token);
+    }
+
+    void run_task() {
+        deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            run_task();
+        }
+    }
+
+    static uint32_t record(uint32_t trigger_time, void *cb_arg) {
+        self->invocations.push_back({(int)(intptr_t)cb_arg, timer_read32(), trigger_time});
+        return self->repeat_ms;
+    }
+
+    static DeferredExecTest *self;
+
+    deferred_executor_t     table[TABLE_SIZE];
+    uint32_t                last_exec;
+    std::vector<invocation> invocations;
+    uint32_t                repeat_ms;
+    deferred_token          other_token;
+};
+
+DeferredExecTest *DeferredExecTest::self = nullptr;
+
+TEST_F(DeferredExecTest, RejectsInvalidRequests) {
+    EXPECT_EQ(defer(0, record, 1), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer(10, nullptr, 1), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec_advanced(nullptr, TABLE_SIZE, 10, record, nullptr), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(extend(INVALID_DEFERRED_TOKEN, 10));
+    EXPECT_FALSE(cancel(INVALID_DEFERRED_TOKEN));
+}
+
+TEST_F(DeferredExecTest, ExecutesOnceAfterDelay) {
+    defer(10, record, 1);
+
+    run_for(9);
+    EXPECT_TRUE(invocations.empty());
+
+    run_for(1);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].now, 1010);
+    EXPECT_EQ(invocations[0].trigger_time, 1010);
+
+    run_for(100);
+    EXPECT_EQ(invocations.size(), 1);
+}
+
+TEST_F(DeferredExecTest, ExecutesInTriggerOrder) {
+    defer(30, record, 1);
+    defer(10, record, 2);
+    defer(20, record, 3);
+    defer(5, record, 4);
+    defer(25, record, 5);
+
+    run_for(30);
+    ASSERT_EQ(invocations.size(), 5);
+    EXPECT_EQ(invocations[0].id, 4);
+    EXPECT_EQ(invocations[1].id, 2);
+    EXPECT_EQ(invocations[2].id, 3);
+    EXPECT_EQ(invocations[3].id, 5);
+    EXPECT_EQ(invocations[4].id, 1);
+    for (auto &inv : invocations) {
+        EXPECT_EQ(inv.now, inv.trigger_time);
+    }
+}
+
+TEST_F(DeferredExecTest, TableFull) {
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        EXPECT_NE(defer(10 + i, record, i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer(10, record, TABLE_SIZE), INVALID_DEFERRED_TOKEN);
+
+    // A freed slot can be claimed again
+    run_for(10);
+    EXPECT_EQ(invocations.size(), 1);
+    EXPECT_NE(defer(10, record, TABLE_SIZE), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExecTest, RepeatDoesNotDrift) {
+    repeat_ms = 10;
+    defer(10, record, 1);
+
+    // Execute late -- subsequent triggers stay relative to the original schedule
+    advance_time(13);
+    run_task();
+    run_for(37);
+
+    ASSERT_EQ(invocations.size(), 5);
+    for (size_t i = 0; i < invocations.size(); ++i) {
+        EXPECT_EQ(invocations[i].trigger_time, 1010 + 10 * i);
+    }
+    EXPECT_EQ(invocations[0].now, 1013);
+    EXPECT_EQ(invocations[1].now, 1020);
+}
+
+TEST_F(DeferredExecTest, RepeatRunsAtMostOncePerTask) {
+    repeat_ms = 1;
+    defer(1, record, 1);
+
+    // A long stall only invokes the callback once per task execution while catching up
+    advance_time(5);
+    run_task();
+    EXPECT_EQ(invocations.size(), 1);
+    advance_time(1);
+    run_task();
+    EXPECT_EQ(invocations.size(), 2);
+}
+
+TEST_F(DeferredExecTest, Cancel) {
+    deferred_token a = defer(10, record, 1);
+    deferred_token b = defer(20, record, 2);
+    deferred_token c = defer(30, record, 3);
+
+    EXPECT_TRUE(cancel(b));
+    EXPECT_FALSE(cancel(b));
+
+    run_for(30);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[1].id, 3);
+    EXPECT_FALSE(cancel(a));
+    EXPECT_FALSE(cancel(c));
+}
+
+TEST_F(DeferredExecTest, Extend) {
+    deferred_token a = defer(10, record, 1);
+    defer(15, record, 2);
+
+    run_for(5);
+    EXPECT_TRUE(extend(a, 20));
+
+    run_for(15);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].id, 2);
+
+    run_for(5);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[1].now, 1025);
+    EXPECT_FALSE(extend(a, 10));
+}
+
+static uint32_t cancel_self(uint32_t trigger_time, void *cb_arg) {
+    DeferredExecTest::self->invocations.push_back({(int)(intptr_t)cb_arg, timer_read32(), trigger_time});
+    cancel_deferred_exec_advanced(DeferredExecTest::self->table, TABLE_SIZE, DeferredExecTest::self->other_token);
+    return 10;
+}
+
+TEST_F(DeferredExecTest, CancelSelfFromCallback) {
+    other_token = defer(10, cancel_self, 1);
+
+    run_for(50);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].id, 1);
+}
+
+TEST_F(DeferredExecTest, CancelOtherFromCallback) {
+    // Both due in the same task execution
+    defer(10, cancel_self, 1);
+    other_token = defer(10, record, 2);
+    defer(10, record, 3);
+
+    advance_time(10);
+    run_task();
+
+    // Whichever of the two ran first, the canceller always runs and exactly one other entry remains due
+    bool cancelled_before_run = invocations.size() == 2;
+    ASSERT_GE(invocations.size(), 2);
+    ASSERT_LE(invocations.size(), 3);
+
+    // The canceller repeats every 10ms, the cancelled entry never comes back
+    run_for(10);
+    int runs_of_2 = 0;
+    for (auto &inv : invocations) {
+        runs_of_2 += inv.id == 2;
+    }
+    EXPECT_EQ(runs_of_2, cancelled_before_run ? 0 : 1);
+    EXPECT_EQ(invocations.back().id, 1);
+    EXPECT_EQ(invocations.back().now, 1020);
+}
+
+TEST_F(DeferredExecTest, CancelLaterEntryFromCallback) {
+    defer(10, cancel_self, 1);
+    other_token = defer(20, record, 2);
+    defer(35, record, 3);
+
+    run_for(35);
+    ASSERT_EQ(invocations.size(), 4);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[2].id, 1);
+    EXPECT_EQ(invocations[3].id, 3);
+}
+
+static uint32_t requeue(uint32_t trigger_time, void *cb_arg) {
+    DeferredExecTest::self->invocations.push_back({(int)(intptr_t)cb_arg, timer_read32(), trigger_time});
+    if ((intptr_t)cb_arg < 3) {
+        DeferredExecTest::self->defer(5, requeue, (intptr_t)cb_arg + 1);
+    }
+    return 0;
+}
+
+TEST_F(DeferredExecTest, QueueFromCallback) {
+    defer(10, requeue, 1);
+    defer(12, record, 10);
+
+    run_for(30);
+    ASSERT_EQ(invocations.size(), 4);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[0].now, 1010);
+    EXPECT_EQ(invocations[1].id, 10);
+    EXPECT_EQ(invocations[1].now, 1012);
+    EXPECT_EQ(invocations[2].id, 2);
+    EXPECT_EQ(invocations[2].now, 1015);
+    EXPECT_EQ(invocations[3].id, 3);
+    EXPECT_EQ(invocations[3].now, 1020);
+}
+
+static uint32_t extend_other(uint32_t trigger_time, void *cb_arg) {
+    DeferredExecTest::self->invocations.push_back({(int)(intptr_t)cb_arg, timer_read32(), trigger_time});
+    extend_deferred_exec_advanced(DeferredExecTest::self->table, TABLE_SIZE, DeferredExecTest::self->other_token, 10);
+    return 0;
+}
+
+TEST_F(DeferredExecTest, ExtendFromCallback) {
+    defer(10, extend_other, 1);
+    other_token = defer(15, record, 2);
+
+    run_for(30);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[1].id, 2);
+    EXPECT_EQ(invocations[1].now, 1020);
+}
+
+TEST_F(DeferredExecTest, ManyEntriesStress) {
+    // Queue/cancel/extend in a pattern that exercises reordering of the table
+    std::vector<deferred_token> tokens;
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        tokens.push_back(defer(100 - 7 * i, record, i));
+    }
+    cancel(tokens[3]);
+    cancel(tokens[0]);
+    extend(tokens[7], 200);
+    extend(tokens[5], 1);
+    tokens[3] = defer(50, record, 30);
+
+    run_for(250);
+    std::vector<int> expected = {5, 30, 6, 4, 2, 1, 7};
+    ASSERT_EQ(invocations.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(invocations[i].id, expected[i]);
+        EXPECT_EQ(invocations[i].now, invocations[i].trigger_time);
+    }
+}
+
+TEST_F(DeferredExecTest, BasicApi) {
+    static int basic_calls;
+    basic_calls = 0;
+
+    deferred_token token = defer_exec(
+        5,
+        [](uint32_t trigger_time, void *cb_arg) -> uint32_t {
+            ++basic_calls;
+            return 0;
+        },
+        nullptr);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    for (int i = 0; i < 10; ++i) {
+        advance_time(1);
+        deferred_exec_task();
+    }
+    EXPECT_EQ(basic_calls, 1);
+    EXPECT_FALSE(cancel_deferred_exec(token));
+}
+
+TEST_F(DeferredExecTest, StaleTokenDoesNotMatchReusedSlot) {
+    deferred_token a = defer(10, record, 1);
+    EXPECT_TRUE(cancel(a));
+
+    // Every slot is taken again, so whichever one a used to map to is now in use
+    std::vector<deferred_token> tokens;
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        tokens.push_back(defer(20 + i, record, 10 + i));
+        EXPECT_NE(tokens.back(), INVALID_DEFERRED_TOKEN);
+        EXPECT_NE(tokens.back(), a);
+    }
+    EXPECT_FALSE(cancel(a));
+    EXPECT_FALSE(extend(a, 100));
+
+    run_for(30);
+    ASSERT_EQ(invocations.size(), TABLE_SIZE);
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        EXPECT_EQ(invocations[i].id, 10 + i);
+    }
+}
+
+TEST_F(DeferredExecTest, TokensWrapAround) {
+    // Enough queue/cancel cycles for the 8-bit tokens to wrap several times, with other entries held in the table
+    deferred_token held_a = defer(5000, record, 1);
+    deferred_token held_b = defer(6000, record, 2);
+    for (int i = 0; i < 1000; ++i) {
+        deferred_token token = defer(100, record, 3);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        ASSERT_NE(token, held_a);
+        ASSERT_NE(token, held_b);
+        ASSERT_TRUE(extend(token, 200));
+        ASSERT_TRUE(cancel(token));
+    }
+    EXPECT_TRUE(extend(held_b, 10));
+    EXPECT_TRUE(cancel(held_a));
+
+    run_for(20);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].id, 2);
+}
@@ -0,0 +1,10 @@
+deferred_exec_common_SRC := \
+	$(QUANTUM_PATH)/deferred_exec/tests/deferred_exec_tests.cpp \
+	$(QUANTUM_PATH)/deferred_exec.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+deferred_exec_linear_DEFS := -DMAX_DEFERRED_EXECUTORS=8
+deferred_exec_linear_SRC := $(deferred_exec_common_SRC)
+
+deferred_exec_heap_DEFS := -DMAX_DEFERRED_EXECUTORS=8 -DDEFERRED_EXEC_HEAP_SCHEDULER
+deferred_exec_heap_SRC := $(deferred_exec_common_SRC)
@@ -0,0 +1,3 @@
+TEST_LIST += \
+	deferred_exec_linear \
+	deferred_exec_heap
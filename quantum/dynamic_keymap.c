@@ -14,13 +14,20 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string_async.h"
+#endif
 #include "keycodes.h"
+#include "util.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -101,6 +108,37 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Copy of the keymap section of EEPROM, in the same big-endian layout.
+// Filled by dynamic_keymap_init() and dynamic_keymap_reset(); every write goes to both the mirror and EEPROM.
+static uint8_t dynamic_keymap_mirror[DYNAMIC_KEYMAP_EEPROM_SIZE];
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
+// Reads `size` bytes at `offset` of the keymap section, from the mirror when enabled.
+static void dynamic_keymap_read_block(uint16_t offset, uint16_t size, uint8_t *data) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    memcpy(data, dynamic_keymap_mirror + offset, size);
+#else
+    eeprom_read_block(data, ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset, size);
+#endif
+}
+
+// Writes `size` bytes at `offset` of the keymap section, keeping the mirror in sync when enabled.
+static void dynamic_keymap_update_block(uint16_t offset, uint16_t size, const uint8_t *data) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    memcpy(dynamic_keymap_mirror + offset, data, size);
+#endif
+    eeprom_update_block(data, ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset, size);
+}
+
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    eeprom_read_block(dynamic_keymap_mirror, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_EEPROM_SIZE);
+#endif
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -110,21 +148,24 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
+static uint16_t dynamic_keymap_key_to_offset(uint8_t layer, uint8_t row, uint8_t column) {
+    return (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+}
+
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
-    void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    uint8_t data[2];
+    dynamic_keymap_read_block(dynamic_keymap_key_to_offset(layer, row, column), sizeof(data), data);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
-    return keycode;
+    return (data[0] << 8) | data[1];
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
-    void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+    dynamic_keymap_update_block(dynamic_keymap_key_to_offset(layer, row, column), sizeof(data), data);
+    layer_lookup_cache_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -151,12 +192,17 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
-    // Reset the keymaps in EEPROM to what is in flash.
+    // Reset the keymaps in EEPROM to what is in flash. Every row is written, so this also fills the mirror.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
+            // Write a whole row per EEPROM transaction
+            uint8_t data[MATRIX_COLS * 2];
             for (int column = 0; column < MATRIX_COLS; column++) {
-                dynamic_keymap_set_keycode(layer, row, column, keycode_at_keymap_location_raw(layer, row, column));
+                uint16_t keycode     = keycode_at_keymap_location_raw(layer, row, column);
+                data[column * 2]     = (uint8_t)(keycode >> 8);
+                data[column * 2 + 1] = (uint8_t)(keycode & 0xFF);
             }
+            dynamic_keymap_update_block(dynamic_keymap_key_to_offset(layer, row, 0), sizeof(data), data);
         }
 #ifdef ENCODER_MAP_ENABLE
         for (int encoder = 0; encoder < NUM_ENCODERS; encoder++) {
@@ -165,34 +211,23 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+    layer_lookup_cache_invalidate();
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    uint16_t valid = offset < DYNAMIC_KEYMAP_EEPROM_SIZE ? MIN(size, DYNAMIC_KEYMAP_EEPROM_SIZE - offset) : 0;
+    if (valid > 0) {
+        dynamic_keymap_read_block(offset, valid, data);
     }
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t valid = offset < DYNAMIC_KEYMAP_EEPROM_SIZE ? MIN(size, DYNAMIC_KEYMAP_EEPROM_SIZE - offset) : 0;
+    if (valid > 0) {
+        dynamic_keymap_update_block(offset, valid, data);
     }
+    layer_lookup_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,72 +255,47 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    uint16_t valid = offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE ? MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) : 0;
+    if (valid > 0) {
+        eeprom_read_block(data, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, valid);
     }
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t valid = offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE ? MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) : 0;
+    if (valid > 0) {
+        eeprom_update_block(data, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, valid);
     }
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (p != end) {
-        eeprom_update_byte(p, 0);
-        ++p;
+    // Clear in fixed size chunks rather than a byte at a time
+    static const uint8_t zeros[32] = {0};
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; offset += sizeof(zeros)) {
+        uint16_t size = MIN(sizeof(zeros), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset);
+        eeprom_update_block(zeros, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, size);
     }
 }
 
-void dynamic_keymap_macro_send(uint8_t id) {
-    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
-        return;
-    }
+#ifdef SEND_STRING_ASYNC_ENABLE
+static void *macro_resume = NULL;
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
-        return;
-    }
+static void dynamic_keymap_macro_send_from(void *p);
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then there is
-        // no Nth macro in the buffer.
-        if (p == end) {
-            return;
-        }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
-        }
-        ++p;
-    }
+static void dynamic_keymap_macro_resume(void *context) {
+    void *p      = macro_resume;
+    macro_resume = NULL;
+    dynamic_keymap_macro_send_from(p);
+}
+#endif
 
+static void dynamic_keymap_macro_send_from(void *p) {
     // Send the macro string by making a temporary string.
     char data[8] = {0};
+#ifdef SEND_STRING_ASYNC_ENABLE
+    void *token = p;
+#endif
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
@@ -335,6 +345,60 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 }
             }
         }
+#ifdef SEND_STRING_ASYNC_ENABLE
+        if (!send_string_async_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY)) {
+            // Queue is full, continue from this token once the queued part has been typed
+            macro_resume = token;
+            send_string_async_callback(dynamic_keymap_macro_resume, NULL);
+            return;
+        }
+        token = p;
+#else
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
+#endif
+    }
+}
+
+void dynamic_keymap_macro_send(uint8_t id) {
+    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
+        return;
+    }
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // The previous macro did not fit the queue and is still being queued,
+    // unless the queue was cleared in the meantime
+    if (macro_resume) {
+        if (send_string_async_is_busy()) {
+            return;
+        }
+        macro_resume = NULL;
     }
+#endif
+
+    // Check the last byte of the buffer.
+    // If it's not zero, then we are in the middle
+    // of buffer writing, possibly an aborted buffer
+    // write. So do nothing.
+    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
+    if (eeprom_read_byte(p) != 0) {
+        return;
+    }
+
+    // Skip N null characters
+    // p will then point to the Nth macro
+    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
+    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    while (id > 0) {
+        // If we are past the end of the buffer, then there is
+        // no Nth macro in the buffer.
+        if (p == end) {
+            return;
+        }
+        if (eeprom_read_byte(p) == 0) {
+            --id;
+        }
+        ++p;
+    }
+
+    dynamic_keymap_macro_send_from(p);
 }
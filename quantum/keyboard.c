@@ -16,6 +16,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode_config.h"
 #include "matrix.h"
@@ -104,6 +105,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -137,9 +141,28 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string_async.h"
+#endif
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef REPORT_QUEUE_ENABLE
+#    include "report_queue.h"
+#endif
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_COMBINING)
+#    include "eeprom_driver.h"
+#endif
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#else
+#    define profiler_begin()
+#    define profiler_mark(stage)
+#    define profiler_end()
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -216,6 +239,35 @@ uint32_t get_matrix_scan_rate(void) {
 #    define matrix_scan_perf_task()
 #endif
 
+static bool     matrix_changed_rows_published = false;
+static uint32_t matrix_changed_rows[MATRIX_ROWS_BITMAP_WORDS];
+
+/** \brief matrix_set_changed_rows
+ *
+ * Lets matrix_scan() implementations that already know which rows changed publish them, so that matrix_task only
+ * has to look at those rows. Rows that are published without having changed are harmless; rows that changed without
+ * being published are missed. Calls within the same scan are merged.
+ */
+void matrix_set_changed_rows(const uint32_t changed_rows[MATRIX_ROWS_BITMAP_WORDS]) {
+    for (uint8_t i = 0; i < MATRIX_ROWS_BITMAP_WORDS; i++) {
+        matrix_changed_rows[i] = (matrix_changed_rows_published ? matrix_changed_rows[i] : 0) | changed_rows[i];
+    }
+    matrix_changed_rows_published = true;
+}
+
+/** \brief matrix_get_changed_rows
+ *
+ * Fetches the rows published since the last call, or returns false if the matrix implementation did not publish any.
+ */
+bool matrix_get_changed_rows(uint32_t changed_rows[MATRIX_ROWS_BITMAP_WORDS]) {
+    if (!matrix_changed_rows_published) {
+        return false;
+    }
+    memcpy(changed_rows, matrix_changed_rows, sizeof(matrix_changed_rows));
+    matrix_changed_rows_published = false;
+    return true;
+}
+
 #ifdef MATRIX_HAS_GHOST
 static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
     matrix_row_t out = 0;
@@ -411,6 +463,9 @@ void keyboard_init(void) {
 #ifdef VIA_ENABLE
     via_init();
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
 #endif
@@ -536,9 +591,24 @@ static bool matrix_task(void) {
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
+
+    // Work out which rows changed, only checking the rows published by the scan if it did so
+    uint32_t changed_rows[MATRIX_ROWS_BITMAP_WORDS];
+    bool     matrix_changed = false;
+    if (!matrix_get_changed_rows(changed_rows)) {
+        memset(changed_rows, 0xFF, sizeof(changed_rows));
+    }
+    for (uint8_t word = 0; word < MATRIX_ROWS_BITMAP_WORDS; word++) {
+        uint32_t candidates = changed_rows[word];
+        changed_rows[word]  = 0;
+        while (candidates) {
+            const uint8_t row = word * 32 + __builtin_ctzl(candidates);
+            candidates &= candidates - 1;
+            if (row < MATRIX_ROWS && (matrix_previous[row] ^ matrix_get_row(row))) {
+                changed_rows[word] |= (uint32_t)1 << (row % 32);
+                matrix_changed = true;
+            }
+        }
     }
 
     matrix_scan_perf_task();
@@ -555,18 +625,26 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+    for (uint8_t word = 0; word < MATRIX_ROWS_BITMAP_WORDS; word++) {
+        uint32_t rows = changed_rows[word];
+        while (rows) {
+            const uint8_t row = word * 32 + __builtin_ctzl(rows);
+            rows &= rows - 1;
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
-        }
+            const matrix_row_t current_row = matrix_get_row(row);
+            const matrix_row_t row_changes = current_row ^ matrix_previous[row];
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+            if (has_ghost_in_row(row, current_row)) {
+                continue;
+            }
+
+            // Visit only the changed columns, lowest first
+            uint32_t cols = row_changes;
+            while (cols) {
+                const uint8_t col = __builtin_ctzl(cols);
+                cols &= cols - 1;
+
+                const bool key_pressed = current_row & ((matrix_row_t)1 << col);
 
                 if (process_keypress) {
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
@@ -574,9 +652,9 @@ static bool matrix_task(void) {
 
                 switch_events(row, col, key_pressed);
             }
-        }
 
-        matrix_previous[row] = current_row;
+            matrix_previous[row] = current_row;
+        }
     }
 
     return matrix_changed;
@@ -655,36 +733,55 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
+    profiler_begin();
+
     if (matrix_task()) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
+    profiler_mark(PROFILER_STAGE_MATRIX);
 
     quantum_task();
+    profiler_mark(PROFILER_STAGE_QUANTUM);
+
+#ifdef I2C_ASYNC_ENABLE
+    // finish I2C transfers, so their callbacks run before the drivers below queue more
+    i2c_async_task();
+    profiler_mark(PROFILER_STAGE_I2C_ASYNC);
+#endif
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
+    profiler_mark(PROFILER_STAGE_SPLIT_WATCHDOG);
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
+    profiler_mark(PROFILER_STAGE_RGBLIGHT);
 #endif
 
 #ifdef LED_MATRIX_ENABLE
     led_matrix_task();
+    profiler_mark(PROFILER_STAGE_LED_MATRIX);
 #endif
 #ifdef RGB_MATRIX_ENABLE
     rgb_matrix_task();
+    profiler_mark(PROFILER_STAGE_RGB_MATRIX);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
     backlight_task();
+    profiler_mark(PROFILER_STAGE_BACKLIGHT);
 #    endif
 #endif
 
@@ -693,6 +790,7 @@ void keyboard_task(void) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
+    profiler_mark(PROFILER_STAGE_ENCODER);
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
@@ -700,6 +798,7 @@ void keyboard_task(void) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
+    profiler_mark(PROFILER_STAGE_POINTING_DEVICE);
 #endif
 
 #ifdef OLED_ENABLE
@@ -708,6 +807,7 @@ void keyboard_task(void) {
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
 #    endif
+    profiler_mark(PROFILER_STAGE_OLED);
 #endif
 
 #ifdef ST7565_ENABLE
@@ -716,36 +816,58 @@ void keyboard_task(void) {
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
 #    endif
+    profiler_mark(PROFILER_STAGE_ST7565);
 #endif
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
     mousekey_task();
+    profiler_mark(PROFILER_STAGE_MOUSEKEY);
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
     ps2_mouse_task();
+    profiler_mark(PROFILER_STAGE_PS2_MOUSE);
 #endif
 
 #ifdef MIDI_ENABLE
     midi_task();
+    profiler_mark(PROFILER_STAGE_MIDI);
 #endif
 
 #ifdef JOYSTICK_ENABLE
     joystick_task();
+    profiler_mark(PROFILER_STAGE_JOYSTICK);
 #endif
 
 #ifdef BLUETOOTH_ENABLE
     bluetooth_task();
+    profiler_mark(PROFILER_STAGE_BLUETOOTH);
 #endif
 
 #ifdef HAPTIC_ENABLE
     haptic_task();
+    profiler_mark(PROFILER_STAGE_HAPTIC);
 #endif
 
     led_task();
+    profiler_mark(PROFILER_STAGE_LED);
 
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
+    profiler_mark(PROFILER_STAGE_OS_DETECTION);
 #endif
+
+#ifdef REPORT_QUEUE_ENABLE
+    // send reports that were waiting for a busy endpoint
+    report_queue_task();
+    profiler_mark(PROFILER_STAGE_REPORT_QUEUE);
+#endif
+
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_COMBINING)
+    // write out combined EEPROM writes once they settle
+    eeprom_driver_task();
+#endif
+
+    profiler_end();
 }
@@ -0,0 +1,104 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*******************************************************************************
+  88888888888 888      d8b                .d888 d8b 888               d8b
+      888     888      Y8P               d88P"  Y8P 888               Y8P
+      888     888                        888        888
+      888     88888b.  888 .d8888b       888888 888 888  .d88b.       888 .d8888b
+      888     888 "88b 888 88K           888    888 888 d8P  Y8b      888 88K
+      888     888  888 888 "Y8888b.      888    888 888 88888888      888 "Y8888b.
+      888     888  888 888      X88      888    888 888 Y8b.          888      X88
+      888     888  888 888  88888P'      888    888 888  "Y8888       888  88888P'
+                                                        888                 888
+                                                        888                 888
+                                                        888                 888
+     .d88b.   .d88b.  88888b.   .d88b.  888d888 8888b.  888888 .d88b.   .d88888
+    d88P"88b d8P  Y8b 888 "88b d8P  Y8b 888P"      "88b 888   d8P  Y8b d88" 888
+    888  888 88888888 888  888 88888888 888    .d888888 888   88888888 888  888
+    Y88b 888 Y8b.     888  888 Y8b.     888    888  888 Y88b. Y8b.     Y88b 888
+     "Y88888  "Y8888  888  888  "Y8888  888    "Y888888  "Y888 "Y8888   "Y88888
+         888
+    Y8b d88P
+     "Y88P"
+*******************************************************************************/
+
+#pragma once
+// clang-format off
+
+#include <stdint.h>
+#include "keycodes.h"
+
+enum keycode_dispatch_handler {
+    KEYCODE_DISPATCH_NONE,
+    KEYCODE_DISPATCH_SEQUENCER,
+    KEYCODE_DISPATCH_MIDI,
+    KEYCODE_DISPATCH_AUDIO,
+    KEYCODE_DISPATCH_BACKLIGHT,
+    KEYCODE_DISPATCH_STENO,
+    KEYCODE_DISPATCH_DYNAMIC_TAPPING_TERM,
+    KEYCODE_DISPATCH_MAGIC,
+    KEYCODE_DISPATCH_GRAVE_ESC,
+    KEYCODE_DISPATCH_RGB,
+    KEYCODE_DISPATCH_JOYSTICK,
+    KEYCODE_DISPATCH_PROGRAMMABLE_BUTTON,
+    KEYCODE_DISPATCH_TRI_LAYER,
+};
+
+// Returns the handler that has to see the keycode, or KEYCODE_DISPATCH_NONE
+static inline uint8_t keycode_dispatch_handler(uint16_t keycode) {
+    switch (keycode) {
+#if defined(SEQUENCER_ENABLE)
+        case QK_SEQUENCER ... QK_SEQUENCER_MAX:
+            return KEYCODE_DISPATCH_SEQUENCER;
+#endif
+#if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
+        case QK_MIDI ... QK_MIDI_MAX:
+            return KEYCODE_DISPATCH_MIDI;
+#endif
+#if defined(AUDIO_ENABLE)
+        case QK_AUDIO_ON ... QK_AUDIO_VOICE_PREVIOUS:
+            return KEYCODE_DISPATCH_AUDIO;
+#endif
+#if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
+        case QK_BACKLIGHT_ON ... QK_BACKLIGHT_TOGGLE_BREATHING:
+            return KEYCODE_DISPATCH_BACKLIGHT;
+#endif
+#if defined(STENO_ENABLE)
+        case QK_STENO ... QK_STENO_MAX:
+            return KEYCODE_DISPATCH_STENO;
+#endif
+#if defined(DYNAMIC_TAPPING_TERM_ENABLE)
+        case QK_DYNAMIC_TAPPING_TERM_PRINT:
+        case QK_DYNAMIC_TAPPING_TERM_UP:
+        case QK_DYNAMIC_TAPPING_TERM_DOWN:
+            return KEYCODE_DISPATCH_DYNAMIC_TAPPING_TERM;
+#endif
+#if defined(MAGIC_ENABLE)
+        case QK_MAGIC ... QK_MAGIC_MAX:
+            return KEYCODE_DISPATCH_MAGIC;
+#endif
+#if defined(GRAVE_ESC_ENABLE)
+        case QK_GRAVE_ESCAPE:
+            return KEYCODE_DISPATCH_GRAVE_ESC;
+#endif
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+        case RGB_TOG ... RGB_MODE_TWINKLE:
+            return KEYCODE_DISPATCH_RGB;
+#endif
+#if defined(JOYSTICK_ENABLE)
+        case QK_JOYSTICK ... QK_JOYSTICK_MAX:
+            return KEYCODE_DISPATCH_JOYSTICK;
+#endif
+#if defined(PROGRAMMABLE_BUTTON_ENABLE)
+        case QK_PROGRAMMABLE_BUTTON ... QK_PROGRAMMABLE_BUTTON_MAX:
+            return KEYCODE_DISPATCH_PROGRAMMABLE_BUTTON;
+#endif
+#if defined(TRI_LAYER_ENABLE)
+        case QK_TRI_LAYER_LOWER:
+        case QK_TRI_LAYER_UPPER:
+            return KEYCODE_DISPATCH_TRI_LAYER;
+#endif
+    }
+    return KEYCODE_DISPATCH_NONE;
+}
@@ -7,20 +7,156 @@
 
 #include <string.h>
 
+#ifdef LEADER_SEQUENCE_TABLE
+#    include "quantum.h"
+#    include "keymap_introspection.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
 
 // Leader key stuff
-bool     leading              = false;
-uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+bool     leading                                     = false;
+uint16_t leader_time                                 = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_MAX_LENGTH] = {0, 0, 0, 0, 0};
+uint8_t  leader_sequence_size                        = 0;
 
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
 
+#ifdef LEADER_SEQUENCE_TABLE
+#    define LEADER_NO_SEQUENCE UINT16_MAX
+
+// `leader_sequences` sorted by keys, so the entries starting with the sequence buffer are next to each other and
+// are found with a binary search. Built on the first lookup; if the table doesn't fit, it is searched linearly.
+static uint8_t leader_sequence_order[LEADER_SEQUENCE_TABLE_LENGTH];
+static enum {
+    LEADER_SEQUENCE_ORDER_UNBUILT,
+    LEADER_SEQUENCE_ORDER_READY,
+    LEADER_SEQUENCE_ORDER_OVERFLOW,
+} leader_sequence_order_state = LEADER_SEQUENCE_ORDER_UNBUILT;
+
+__attribute__((weak)) bool leader_sequence_matched_user(uint16_t index) {
+    return true;
+}
+
+static void leader_sequence_read(uint16_t index, leader_sequence_t *sequence) {
+    memcpy_P(sequence, leader_sequence_get(index), sizeof(leader_sequence_t));
+}
+
+// Compares the first `length` keys, in the order of the index.
+static int8_t leader_sequence_compare(const uint16_t *a, const uint16_t *b, uint8_t length) {
+    for (uint8_t i = 0; i < length; i++) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static void leader_sequence_build_order(void) {
+    uint16_t count = leader_sequence_count();
+    if (count > LEADER_SEQUENCE_TABLE_LENGTH) {
+        dprintf("leader: leader_sequences do not fit LEADER_SEQUENCE_TABLE_LENGTH\n");
+        leader_sequence_order_state = LEADER_SEQUENCE_ORDER_OVERFLOW;
+        return;
+    }
+
+    // Stable insertion sort, so duplicates keep the order of the table.
+    leader_sequence_t sequence, other;
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t j = i;
+        leader_sequence_read(i, &sequence);
+        for (; j > 0; j--) {
+            leader_sequence_read(leader_sequence_order[j - 1], &other);
+            if (leader_sequence_compare(other.keys, sequence.keys, LEADER_SEQUENCE_MAX_LENGTH) <= 0) {
+                break;
+            }
+            leader_sequence_order[j] = leader_sequence_order[j - 1];
+        }
+        leader_sequence_order[j] = i;
+    }
+    leader_sequence_order_state = LEADER_SEQUENCE_ORDER_READY;
+}
+
+/**
+ * Looks up the sequence buffer in `leader_sequences`.
+ *
+ * \param longer Set to whether a longer entry starts with the sequence buffer.
+ *
+ * \return The index of the first entry matching the buffer, or `LEADER_NO_SEQUENCE`.
+ */
+static uint16_t leader_sequence_find(bool *longer) {
+    leader_sequence_t sequence;
+    uint16_t          found = LEADER_NO_SEQUENCE;
+    uint16_t          count = leader_sequence_count();
+    *longer                 = false;
+
+    if (leader_sequence_order_state == LEADER_SEQUENCE_ORDER_UNBUILT) {
+        leader_sequence_build_order();
+    }
+
+    if (leader_sequence_order_state == LEADER_SEQUENCE_ORDER_OVERFLOW) {
+        for (uint16_t i = 0; i < count; i++) {
+            leader_sequence_read(i, &sequence);
+            if (leader_sequence_compare(sequence.keys, leader_sequence, leader_sequence_size) != 0) {
+                continue;
+            }
+            if (leader_sequence_size < LEADER_SEQUENCE_MAX_LENGTH && sequence.keys[leader_sequence_size] != KC_NO) {
+                *longer = true;
+            } else if (found == LEADER_NO_SEQUENCE) {
+                found = i;
+            }
+        }
+        return found;
+    }
+
+    // The buffer is padded with KC_NO, so it sorts before the longer entries starting with it.
+    uint16_t low = 0, high = count;
+    while (low < high) {
+        uint16_t middle = (low + high) / 2;
+        leader_sequence_read(leader_sequence_order[middle], &sequence);
+        if (leader_sequence_compare(sequence.keys, leader_sequence, LEADER_SEQUENCE_MAX_LENGTH) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for (; low < count; low++) {
+        leader_sequence_read(leader_sequence_order[low], &sequence);
+        if (leader_sequence_compare(sequence.keys, leader_sequence, LEADER_SEQUENCE_MAX_LENGTH) != 0) {
+            break;
+        }
+        if (found == LEADER_NO_SEQUENCE) {
+            found = leader_sequence_order[low];
+        }
+    }
+    *longer = low < count && leader_sequence_compare(sequence.keys, leader_sequence, leader_sequence_size) == 0;
+    return found;
+}
+
+bool leader_sequence_may_continue(void) {
+    bool longer;
+    leader_sequence_find(&longer);
+    return longer;
+}
+
+static void leader_sequence_dispatch(void) {
+    bool     longer;
+    uint16_t index = leader_sequence_find(&longer);
+    if (index != LEADER_NO_SEQUENCE && leader_sequence_matched_user(index)) {
+        leader_sequence_t sequence;
+        leader_sequence_read(index, &sequence);
+        if (sequence.keycode != KC_NO) {
+            tap_code16(sequence.keycode);
+        }
+    }
+}
+#endif
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -34,6 +170,9 @@ void leader_start(void) {
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_SEQUENCE_TABLE
+    leader_sequence_dispatch();
+#endif
     leader_end_user();
 }
 
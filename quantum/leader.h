@@ -1,6 +1,8 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -11,6 +13,31 @@
  * \{
  */
 
+/**
+ * The most keys in a leader sequence.
+ */
+#define LEADER_SEQUENCE_MAX_LENGTH 5
+
+#ifdef LEADER_SEQUENCE_TABLE
+#    ifndef LEADER_SEQUENCE_TABLE_LENGTH
+#        define LEADER_SEQUENCE_TABLE_LENGTH 64
+#    endif
+#    if LEADER_SEQUENCE_TABLE_LENGTH > 255
+#        error "LEADER_SEQUENCE_TABLE_LENGTH must be at most 255"
+#    endif
+
+/**
+ * An entry of the `leader_sequences` table.
+ */
+typedef struct {
+    uint16_t keys[LEADER_SEQUENCE_MAX_LENGTH]; // unused keys are KC_NO
+    uint16_t keycode;                          // tapped when the sequence is typed
+} leader_sequence_t;
+
+#    define LEADER_SEQUENCE(kc, ...) \
+        { .keys = {__VA_ARGS__}, .keycode = (kc) }
+#endif
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
@@ -21,6 +48,24 @@ void leader_start_user(void);
  */
 void leader_end_user(void);
 
+#ifdef LEADER_SEQUENCE_TABLE
+/**
+ * \brief User callback, invoked when the sequence buffer matches an entry of `leader_sequences`, before `leader_end_user()`.
+ *
+ * \param index The index of the entry in `leader_sequences`.
+ *
+ * \return `true` to tap the keycode of the entry, `false` if it was handled.
+ */
+bool leader_sequence_matched_user(uint16_t index);
+
+/**
+ * Whether a longer entry of `leader_sequences` starts with the sequence buffer.
+ *
+ * If not, the sequence is complete or can't match, so it can end without waiting for the timeout.
+ */
+bool leader_sequence_may_continue(void);
+#endif
+
 /**
  * Begin the leader sequence, resetting the buffer and timer.
  */
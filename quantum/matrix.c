@@ -345,5 +345,12 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
 #endif
+
+    if (!changed) {
+        // Debounced matrix is unchanged, matrix_task does not need to compare any rows
+        static const uint32_t no_changed_rows[MATRIX_ROWS_BITMAP_WORDS] = {0};
+        matrix_set_changed_rows(no_changed_rows);
+    }
+
     return (uint8_t)changed;
 }
@@ -57,6 +57,13 @@ bool matrix_can_read(void);
 bool matrix_is_on(uint8_t row, uint8_t col);
 /* matrix state on row */
 matrix_row_t matrix_get_row(uint8_t row);
+
+/* number of 32-bit words in a bitmap of matrix rows */
+#define MATRIX_ROWS_BITMAP_WORDS (((MATRIX_ROWS) + 31) / 32)
+/* publish the rows that may have changed during the current matrix_scan() (optional) */
+void matrix_set_changed_rows(const uint32_t changed_rows[MATRIX_ROWS_BITMAP_WORDS]);
+/* fetch and clear the rows published during the last matrix_scan(), false if nothing was published */
+bool matrix_get_changed_rows(uint32_t changed_rows[MATRIX_ROWS_BITMAP_WORDS]);
 /* print matrix for debug */
 void matrix_print(void);
 /* delay between changing matrix pin state and reading values */
@@ -175,6 +175,12 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     matrix_scan_kb();
 #endif
 
+    if (!changed) {
+        // Debounced matrix is unchanged, matrix_task does not need to compare any rows
+        static const uint32_t no_changed_rows[MATRIX_ROWS_BITMAP_WORDS] = {0};
+        matrix_set_changed_rows(no_changed_rows);
+    }
+
     return changed;
 }
 
@@ -56,6 +56,23 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the amount of RAM (in bytes) used to cache glyphs already converted to the display's native pixel
+ *      format, so that redrawing the same text does not need to look up and decode the glyphs again. The least
+ *      recently used glyphs are evicted when full. Set to 0 to disable the glyph cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs held in the glyph cache, regardless of their size. Each entry
+ *      requires a small amount of RAM for metadata, in addition to \ref QUANTUM_PAINTER_GLYPH_CACHE_SIZE.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -129,6 +146,32 @@ typedef struct painter_font_desc_t {
  */
 typedef const painter_font_desc_t *painter_font_handle_t;
 
+/**
+ * @typedef A string of text rendered ahead of time in a display's native pixel format, see \ref qp_textrun_prepare.
+ */
+typedef struct painter_text_run_t {
+    uint16_t width;  ///< Width of the rendered text
+    uint16_t height; ///< Height of the rendered text, i.e. the font's line height
+    uint8_t  bpp;    ///< Native bits per pixel of the display the text was rendered for
+    void *   buffer; ///< The rendered pixel data
+} painter_text_run_t;
+
+/**
+ * @def Helper for determining the buffer size required for a text run, given the width from \ref qp_textwidth.
+ */
+#define QP_TEXTRUN_REQUIRED_BUFFER_BYTE_SIZE(width, height, bpp) ((((width) * (height) * (bpp)) + 7) / 8)
+
+/**
+ * @typedef Glyph cache statistics, see \ref qp_glyph_cache_get_stats.
+ */
+typedef struct painter_glyph_cache_stats_t {
+    uint32_t hits;       ///< Glyphs drawn from the cache
+    uint32_t misses;     ///< Glyphs that had to be decoded
+    uint32_t evictions;  ///< Glyphs evicted to make room for others
+    uint16_t entries;    ///< Glyphs currently cached
+    uint32_t bytes_used; ///< Bytes of \ref QUANTUM_PAINTER_GLYPH_CACHE_SIZE currently used
+} painter_glyph_cache_stats_t;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API
 
@@ -488,6 +531,53 @@ int16_t qp_drawtext(painter_device_t device, uint16_t x, uint16_t y, painter_fon
  */
 int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
 
+/**
+ * Renders text ahead of time into a caller-supplied buffer, in the native pixel format of the display, so that it can
+ * be drawn many times using \ref qp_textrun_draw without decoding the font again.
+ *
+ * @param device[in] the handle of the device the text run will be drawn to
+ * @param run[out] the text run to prepare
+ * @param buffer[in] the buffer to render into, of at least `QP_TEXTRUN_REQUIRED_BUFFER_BYTE_SIZE(qp_textwidth(font, str), font->line_height, bpp)` bytes, where `bpp` is the native bits per pixel of the display
+ * @param buffer_size[in] the size of the buffer, in bytes
+ * @param font[in] the handle of the font
+ * @param str[in] the string to render
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return true if the text was rendered
+ * @return false if rendering failed, or the buffer was too small
+ */
+bool qp_textrun_prepare(painter_device_t device, painter_text_run_t *run, void *buffer, uint32_t buffer_size, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+/**
+ * Draws a text run prepared by \ref qp_textrun_prepare to the display.
+ *
+ * @param device[in] the handle of the device to control, with the same native pixel format as the one the text run was prepared for
+ * @param x[in] the x-position where the text should be drawn onto the device
+ * @param y[in] the y-position where the text should be drawn onto the device
+ * @param run[in] the text run to draw
+ * @return the width (in pixels) used when drawing the text run
+ */
+int16_t qp_textrun_draw(painter_device_t device, uint16_t x, uint16_t y, const painter_text_run_t *run);
+
+/**
+ * Retrieves the glyph cache statistics. All zero if \ref QUANTUM_PAINTER_GLYPH_CACHE_SIZE is 0.
+ */
+painter_glyph_cache_stats_t qp_glyph_cache_get_stats(void);
+
+/**
+ * Prints the glyph cache statistics to the debug console.
+ */
+void qp_glyph_cache_print_stats(void);
+
+/**
+ * Drops all glyphs from the glyph cache, and resets its statistics.
+ */
+void qp_glyph_cache_clear(void);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Drivers
 
@@ -92,9 +92,13 @@ typedef struct qp_internal_byte_output_state_t {
 
 bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 
-// Helper shared between image and font rendering, sends pixels to the display using:
-//     - qp_internal_decode_palette + qp_internal_pixel_appender (bpp <= 8)
-//     - qp_internal_send_bytes                                  (bpp > 8)
+// Helper shared between image and font rendering, sends pixels to the display a block at a time:
+//     - bpp <= 8: unpacked to palette indices, then appended with a single append_pixels call per block
+//     - bpp > 8:  streamed as native pixel data
+// Images in memory streams are read directly from the buffer, with RLE runs copied whole.
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
 
+// Decodes a width x height block of pixels into a buffer in the device's native format, such as for caching rendered glyphs. Rows are placed `stride` pixels apart, starting at `pixel_offset`.
+bool qp_internal_decode_to_buffer(painter_device_t device, uint8_t bpp, uint16_t width, uint16_t height, uint32_t stride, uint32_t pixel_offset, qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* target_buffer);
+
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
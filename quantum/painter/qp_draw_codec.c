@@ -2,6 +2,8 @@
 // Copyright 2023 Pablo Martinez (@elpekenin) <elpekenin@elpekenin.dev>
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
+
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
@@ -95,7 +97,10 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
 
     // Work out if we're parsing the initial marker byte
     if (state->rle.mode == MARKER_BYTE) {
-        uint8_t c = qp_stream_get(state->src_stream);
+        int16_t c = qp_stream_get(state->src_stream);
+        if (c < 0) {
+            return STREAM_EOF;
+        }
         if (c >= 128) {
             state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
             state->rle.remain = c - 127;
@@ -107,8 +112,8 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
         state->curr = qp_stream_get(state->src_stream);
     }
 
-    // Work out which byte we're returning
-    uint8_t c = state->curr;
+    // Work out which byte we're returning, or the end of the stream if it ran out
+    int16_t c = state->curr;
 
     // Decrement the counter of the bytes remaining
     state->rle.remain--;
@@ -165,43 +170,276 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
     return true;
 }
 
-// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
-bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Block decoding
+
+// Number of pixels decoded per block -- must be a multiple of 8 so that only the final block ends part way through a byte
+#define QP_DECODE_BLOCK_PIXELS 64
+_Static_assert((QP_DECODE_BLOCK_PIXELS % 8) == 0, "QP_DECODE_BLOCK_PIXELS needs to be a multiple of 8");
+
+// Reads a block of RLE-compressed bytes directly out of a memory stream, copying whole runs at a time. Leaves the RLE state exactly as the per-byte decoder would.
+static bool qp_drawimage_block_rle_decoder(qp_internal_byte_input_state_t* state, qp_memory_stream_t* stream, uint8_t* output, uint32_t byte_count) {
+    while (byte_count > 0) {
+        if (state->rle.mode == MARKER_BYTE) {
+            if (stream->position + 2 > stream->length) {
+                stream->is_eof = true;
+                return false;
+            }
+            uint8_t c = stream->buffer[stream->position++];
+            if (c >= 128) {
+                state->rle.mode   = NON_REPEATING_RUN;
+                state->rle.remain = c - 127;
+            } else if (c > 0) {
+                state->rle.mode   = REPEATING_RUN;
+                state->rle.remain = c;
+            } else {
+                return false;
+            }
+            state->curr = stream->buffer[stream->position++];
+        }
+
+        // `curr` always holds the next byte of the run, which has already been consumed from the stream
+        uint8_t run = state->rle.remain < byte_count ? state->rle.remain : byte_count;
+        if (state->rle.mode == REPEATING_RUN) {
+            memset(output, state->curr, run);
+        } else {
+            // Bytes after the first are still in the stream, plus the lookahead for the next one if the run continues
+            uint8_t lookahead = (run < state->rle.remain) ? 1 : 0;
+            if (stream->position + run - 1 + lookahead > stream->length) {
+                stream->is_eof = true;
+                return false;
+            }
+            output[0] = state->curr;
+            memcpy(&output[1], &stream->buffer[stream->position], run - 1);
+            stream->position += run - 1;
+            if (lookahead) {
+                state->curr = stream->buffer[stream->position++];
+            }
+        }
+
+        state->rle.remain -= run;
+        if (state->rle.remain == 0) {
+            state->rle.mode = MARKER_BYTE;
+        }
+        output += run;
+        byte_count -= run;
+    }
+    return true;
+}
+
+// Reads a block of decompressed bytes, straight from the buffer for memory streams, otherwise through the byte input callback
+static bool qp_internal_read_block(qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* output, uint32_t byte_count) {
+    if (input_callback == qp_drawimage_byte_uncompressed_decoder || input_callback == qp_drawimage_byte_rle_decoder) {
+        qp_internal_byte_input_state_t* state  = (qp_internal_byte_input_state_t*)input_state;
+        qp_memory_stream_t*             stream = qp_stream_as_memory_stream(state->src_stream);
+        if (stream) {
+            if (input_callback == qp_drawimage_byte_rle_decoder) {
+                return qp_drawimage_block_rle_decoder(state, stream, output, byte_count);
+            }
+            if (stream->position + byte_count > stream->length) {
+                stream->is_eof = true;
+                return false;
+            }
+            memcpy(output, &stream->buffer[stream->position], byte_count);
+            stream->position += byte_count;
+            return true;
+        }
+    }
+
+    for (uint32_t i = 0; i < byte_count; ++i) {
+        int16_t byteval = input_callback(input_state);
+        if (byteval < 0) {
+            return false;
+        }
+        output[i] = byteval;
+    }
+    return true;
+}
+
+// Per-bpp kernels expanding packed pixels to palette indices, least significant bits first
+static void qp_internal_unpack_1bpp(const uint8_t* input, uint32_t byte_count, uint8_t* output) {
+    for (uint32_t i = 0; i < byte_count; ++i) {
+        uint8_t b = input[i];
+        output[0] = b & 0x01;
+        output[1] = (b >> 1) & 0x01;
+        output[2] = (b >> 2) & 0x01;
+        output[3] = (b >> 3) & 0x01;
+        output[4] = (b >> 4) & 0x01;
+        output[5] = (b >> 5) & 0x01;
+        output[6] = (b >> 6) & 0x01;
+        output[7] = b >> 7;
+        output += 8;
+    }
+}
+
+static void qp_internal_unpack_2bpp(const uint8_t* input, uint32_t byte_count, uint8_t* output) {
+    for (uint32_t i = 0; i < byte_count; ++i) {
+        uint8_t b = input[i];
+        output[0] = b & 0x03;
+        output[1] = (b >> 2) & 0x03;
+        output[2] = (b >> 4) & 0x03;
+        output[3] = b >> 6;
+        output += 4;
+    }
+}
+
+static void qp_internal_unpack_4bpp(const uint8_t* input, uint32_t byte_count, uint8_t* output) {
+    for (uint32_t i = 0; i < byte_count; ++i) {
+        uint8_t b = input[i];
+        output[0] = b & 0x0F;
+        output[1] = b >> 4;
+        output += 2;
+    }
+}
+
+// Reads and unpacks the palette indices of a block of pixels -- all but the final block must be a multiple of QP_DECODE_BLOCK_PIXELS
+static bool qp_internal_read_indices(uint8_t bpp, uint32_t block_pixels, qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* indices) {
+    const uint8_t pixels_per_byte = 8 / bpp;
+    uint32_t      block_bytes     = (block_pixels + pixels_per_byte - 1) / pixels_per_byte;
+    uint8_t       packed[QP_DECODE_BLOCK_PIXELS / 2];
+
+    switch (bpp) {
+        case 1:
+            if (!qp_internal_read_block(input_callback, input_state, packed, block_bytes)) return false;
+            qp_internal_unpack_1bpp(packed, block_bytes, indices);
+            return true;
+        case 2:
+            if (!qp_internal_read_block(input_callback, input_state, packed, block_bytes)) return false;
+            qp_internal_unpack_2bpp(packed, block_bytes, indices);
+            return true;
+        case 4:
+            if (!qp_internal_read_block(input_callback, input_state, packed, block_bytes)) return false;
+            qp_internal_unpack_4bpp(packed, block_bytes, indices);
+            return true;
+        case 8:
+            return qp_internal_read_block(input_callback, input_state, indices, block_bytes);
+        default:
+            qp_dprintf("qp_internal_read_indices: unsupported bpp %d\n", (int)bpp);
+            return false;
+    }
+}
+
+// Decodes palette-based pixel data a block at a time, handing each block of indices to the driver in a single append_pixels call
+static bool qp_internal_append_palette_blocks(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
+    painter_driver_t* driver          = (painter_driver_t*)device;
+    const uint32_t    max_pixels      = qp_internal_num_pixels_in_buffer(device);
+    uint32_t          pixel_write_pos = 0;
+    uint8_t           indices[QP_DECODE_BLOCK_PIXELS];
+
+    while (pixel_count > 0) {
+        // Don't try to derive the pixel count from the byte count, the final byte may not be fully used
+        uint32_t block_pixels = pixel_count < QP_DECODE_BLOCK_PIXELS ? pixel_count : QP_DECODE_BLOCK_PIXELS;
+        if (!qp_internal_read_indices(bpp, block_pixels, input_callback, input_state, indices)) {
+            return false;
+        }
+
+        // Hand the indices to the driver, flushing the pixdata buffer whenever it fills up
+        for (uint32_t offset = 0; offset < block_pixels;) {
+            uint32_t count = QP_MIN(block_pixels - offset, max_pixels - pixel_write_pos);
+            if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_write_pos, count, &indices[offset])) {
+                return false;
+            }
+            pixel_write_pos += count;
+            offset += count;
+            if (pixel_write_pos == max_pixels) {
+                if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, pixel_write_pos)) {
+                    return false;
+                }
+                pixel_write_pos = 0;
+            }
+        }
+
+        pixel_count -= block_pixels;
+    }
+
+    // Any leftovers need transmission as well.
+    if (pixel_write_pos > 0) {
+        return driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, pixel_write_pos);
+    }
+    return true;
+}
+
+// Streams native pixel data a block at a time
+static bool qp_internal_append_native_blocks(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_state) {
+    painter_driver_t*               driver       = (painter_driver_t*)device;
+    qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
+    uint8_t                         block[QP_DECODE_BLOCK_PIXELS];
+
+    while (byte_count > 0) {
+        uint32_t block_bytes = byte_count < sizeof(block) ? byte_count : sizeof(block);
+        if (!qp_internal_read_block(input_callback, input_state, block, block_bytes)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < block_bytes; ++i) {
+            if (!qp_internal_byte_appender(block[i], &output_state)) {
+                return false;
+            }
+        }
+        byte_count -= block_bytes;
+    }
+
+    // Any leftovers need transmission as well.
+    if (output_state.byte_write_pos > 0) {
+        return driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+    }
+    return true;
+}
+
+bool qp_internal_decode_to_buffer(painter_device_t device, uint8_t bpp, uint16_t width, uint16_t height, uint32_t stride, uint32_t pixel_offset, qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* target_buffer) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
-    bool ret = false;
+    // Native pixel format, rows are copied as-is
+    if (bpp > 8) {
+        if (bpp != driver->native_bits_per_pixel) {
+            qp_dprintf("Asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", bpp, driver->native_bits_per_pixel);
+            return false;
+        }
+        for (uint16_t row = 0; row < height; ++row) {
+            if (!qp_internal_read_block(input_callback, input_state, &target_buffer[(pixel_offset + row * stride) * bpp / 8], ((uint32_t)width) * bpp / 8)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Palette-based pixel format, each block of indices is appended one row segment at a time
+    uint32_t pixel_count = ((uint32_t)width) * height;
+    uint8_t  indices[QP_DECODE_BLOCK_PIXELS];
+    for (uint32_t pos = 0; pos < pixel_count;) {
+        uint32_t block_pixels = QP_MIN(pixel_count - pos, QP_DECODE_BLOCK_PIXELS);
+        if (!qp_internal_read_indices(bpp, block_pixels, input_callback, input_state, indices)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < block_pixels;) {
+            uint16_t row   = (pos + i) / width;
+            uint16_t col   = (pos + i) % width;
+            uint32_t count = QP_MIN(block_pixels - i, (uint32_t)(width - col));
+            if (!driver->driver_vtable->append_pixels(device, target_buffer, qp_internal_global_pixel_lookup_table, pixel_offset + row * stride + col, count, &indices[i])) {
+                return false;
+            }
+            i += count;
+        }
+        pos += block_pixels;
+    }
+    return true;
+}
+
+// Helper shared between image and font rendering -- decodes palette-based data in blocks (qp_internal_append_palette_blocks) or streams native data (qp_internal_append_native_blocks) based on the asset's native-ness
+bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
+    painter_driver_t* driver = (painter_driver_t*)device;
 
     // Non-native pixel format
     if (bpp <= 8) {
-        // Set up the output state
-        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
-
-        // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
-        }
+        return qp_internal_append_palette_blocks(device, bpp, pixel_count, input_callback, input_state);
     }
 
     // Native pixel format
-    else if (bpp != driver->native_bits_per_pixel) {
+    if (bpp != driver->native_bits_per_pixel) {
         qp_dprintf("Asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", bpp, driver->native_bits_per_pixel);
         return false;
-    } else {
-        // Set up the output state
-        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
-
-        // Stream the raw pixel data to the display
-        uint32_t byte_count = pixel_count * bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
-        // Any leftovers need transmission as well.
-        if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
-        }
     }
 
-    return ret;
+    return qp_internal_append_native_blocks(device, pixel_count * bpp / 8, input_callback, input_state);
 }
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
@@ -36,6 +36,122 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+// Glyphs already converted to a device's native pixel format, keyed on device, font, code point and colors
+typedef struct qp_glyph_cache_entry_t {
+    painter_device_t   device;
+    qff_font_handle_t *font;
+    uint32_t           code_point;
+    uint32_t           fg_hsv888;
+    uint32_t           bg_hsv888;
+    uint32_t           last_used;
+    uint32_t           offset;
+    uint32_t           size;
+    uint8_t            width;
+} qp_glyph_cache_entry_t;
+
+// Glyph pixel data is kept packed at the start of the buffer, so that a single contiguous free area remains at the end
+static __attribute__((__aligned__(4))) uint8_t glyph_cache_data[QUANTUM_PAINTER_GLYPH_CACHE_SIZE];
+static qp_glyph_cache_entry_t                  glyph_cache_entries[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES];
+static uint16_t                                glyph_cache_count = 0;
+static uint32_t                                glyph_cache_used  = 0;
+static uint32_t                                glyph_cache_clock = 0;
+static painter_glyph_cache_stats_t             glyph_cache_stats = {0};
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(painter_device_t device, qff_font_handle_t *font, uint32_t code_point, uint32_t fg_hsv888, uint32_t bg_hsv888) {
+    for (uint16_t i = 0; i < glyph_cache_count; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache_entries[i];
+        if (entry->code_point == code_point && entry->font == font && entry->device == device && entry->fg_hsv888 == fg_hsv888 && entry->bg_hsv888 == bg_hsv888) {
+            entry->last_used = ++glyph_cache_clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void qp_glyph_cache_remove(qp_glyph_cache_entry_t *entry) {
+    // Compact the pixel data following the removed glyph
+    uint32_t end = entry->offset + entry->size;
+    memmove(&glyph_cache_data[entry->offset], &glyph_cache_data[end], glyph_cache_used - end);
+    for (uint16_t i = 0; i < glyph_cache_count; ++i) {
+        if (glyph_cache_entries[i].offset >= end) {
+            glyph_cache_entries[i].offset -= entry->size;
+        }
+    }
+    glyph_cache_used -= entry->size;
+    *entry = glyph_cache_entries[--glyph_cache_count];
+}
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_alloc(uint32_t size) {
+    // Keep each glyph aligned, as drivers may access the pixel data as 16-bit values
+    size = (size + 3) & ~3u;
+    if (size > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        return NULL;
+    }
+
+    // Evict the least recently used glyphs until there's enough space
+    while (glyph_cache_count == QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES || glyph_cache_used + size > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        qp_glyph_cache_entry_t *lru = &glyph_cache_entries[0];
+        for (uint16_t i = 1; i < glyph_cache_count; ++i) {
+            if (glyph_cache_entries[i].last_used < lru->last_used) {
+                lru = &glyph_cache_entries[i];
+            }
+        }
+        qp_glyph_cache_remove(lru);
+        glyph_cache_stats.evictions++;
+    }
+
+    qp_glyph_cache_entry_t *entry = &glyph_cache_entries[glyph_cache_count++];
+    entry->offset                 = glyph_cache_used;
+    entry->size                   = size;
+    entry->last_used              = ++glyph_cache_clock;
+    glyph_cache_used += size;
+    return entry;
+}
+
+static void qp_glyph_cache_remove_font(qff_font_handle_t *font) {
+    for (uint16_t i = 0; i < glyph_cache_count;) {
+        if (glyph_cache_entries[i].font == font) {
+            qp_glyph_cache_remove(&glyph_cache_entries[i]);
+        } else {
+            ++i;
+        }
+    }
+}
+
+painter_glyph_cache_stats_t qp_glyph_cache_get_stats(void) {
+    glyph_cache_stats.entries    = glyph_cache_count;
+    glyph_cache_stats.bytes_used = glyph_cache_used;
+    return glyph_cache_stats;
+}
+
+void qp_glyph_cache_clear(void) {
+    glyph_cache_count = 0;
+    glyph_cache_used  = 0;
+    memset(&glyph_cache_stats, 0, sizeof(glyph_cache_stats));
+}
+
+#else // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+painter_glyph_cache_stats_t qp_glyph_cache_get_stats(void) {
+    return (painter_glyph_cache_stats_t){0};
+}
+
+void qp_glyph_cache_clear(void) {}
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+void qp_glyph_cache_print_stats(void) {
+#ifndef NO_DEBUG
+    painter_glyph_cache_stats_t stats = qp_glyph_cache_get_stats();
+    dprintf("qp glyph cache: %lu hits, %lu misses, %lu evictions, %u glyphs, %lu/%u bytes\n", (unsigned long)stats.hits, (unsigned long)stats.misses, (unsigned long)stats.evictions, (unsigned)stats.entries, (unsigned long)stats.bytes_used, (unsigned)QUANTUM_PAINTER_GLYPH_CACHE_SIZE);
+#endif // NO_DEBUG
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -151,6 +267,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Drop any cached glyphs, the handle may be reused for a different font
+    qp_glyph_cache_remove_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -163,6 +284,9 @@ bool qp_close_font(painter_font_handle_t font) {
 // Callback to be invoked for each codepoint detected in the UTF8 input string
 typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
 
+// Optional callback invoked before looking up each codepoint's glyph, which sets `handled` if it dealt with the codepoint without the glyph data
+typedef bool (*code_point_cached_handler)(qff_font_handle_t *qff_font, uint32_t code_point, bool *handled, void *cb_arg);
+
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -293,7 +417,7 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
-static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
+static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_cached_handler cached_handler, code_point_handler handler, void *cb_arg) {
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
@@ -302,6 +426,17 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
+        if (cached_handler) {
+            bool handled = false;
+            if (!cached_handler(qff_font, code_point, &handled, cb_arg)) {
+                qp_dprintf("Failed to execute cached glyph handler.\n");
+                return false;
+            }
+            if (handled) {
+                continue;
+            }
+        }
+
         uint8_t width;
         if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
             qp_dprintf("Failed to prepare glyph for rendering.\n");
@@ -337,21 +472,77 @@ static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_f
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // String drawing implementation
 
+// Sets up the palette the first time a glyph actually needs decoding, leaving the stream where it was
+static inline bool qp_drawtext_ensure_font_prepared(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, bool *prepared) {
+    if (*prepared) {
+        return true;
+    }
+
+    int32_t  position = qp_stream_tell(&qff_font->stream);
+    uint32_t data_offset;
+    if (!qp_drawtext_prepare_font_for_render(device, qff_font, fg_hsv888, bg_hsv888, &data_offset) || qp_stream_setpos(&qff_font->stream, position) < 0) {
+        qp_dprintf("Failed to prepare font for rendering.\n");
+        return false;
+    }
+
+    *prepared = true;
+    return true;
+}
+
 // Callback state
 typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
     int16_t                           xpos;
     int16_t                           ypos;
+    qp_pixel_t                        fg_hsv888;
+    qp_pixel_t                        bg_hsv888;
+    bool                              font_prepared;
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
 } code_point_iter_drawglyph_state_t;
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+static inline uint32_t qp_glyph_cache_color_key(qff_font_handle_t *qff_font, qp_pixel_t hsv888) {
+    // Colors don't affect fonts with their own palette
+    return qff_font->has_palette ? 0 : (((uint32_t)hsv888.hsv888.h) << 16) | (((uint32_t)hsv888.hsv888.s) << 8) | hsv888.hsv888.v;
+}
+
+// Codepoint cached handler callback: drawing from the glyph cache
+static inline bool qp_font_code_point_handler_drawcached(qff_font_handle_t *qff_font, uint32_t code_point, bool *handled, void *cb_arg) {
+    code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
+    painter_driver_t *                 driver = (painter_driver_t *)state->device;
+
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(state->device, qff_font, code_point, qp_glyph_cache_color_key(qff_font, state->fg_hsv888), qp_glyph_cache_color_key(qff_font, state->bg_hsv888));
+    if (!entry) {
+        return true;
+    }
+
+    // Send the already-converted pixel data straight to the display
+    uint8_t height = qff_font->base.line_height;
+    if (!driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + entry->width - 1, state->ypos + height - 1)) {
+        return false;
+    }
+    if (!driver->driver_vtable->pixdata(state->device, &glyph_cache_data[entry->offset], ((uint32_t)entry->width) * height)) {
+        return false;
+    }
+
+    state->xpos += entry->width;
+    glyph_cache_stats.hits++;
+    *handled = true;
+    return true;
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 // Codepoint handler callback: drawing
 static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
 
+    if (!qp_drawtext_ensure_font_prepared(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &state->font_prepared)) {
+        return false;
+    }
+
     // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
@@ -364,8 +555,28 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     // Move the x-position for the next glyph
     state->xpos += width;
 
-    // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Decode the glyph into the cache, then send it from there
+    glyph_cache_stats.misses++;
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_alloc(QP_TEXTRUN_REQUIRED_BUFFER_BYTE_SIZE(pixel_count, 1, driver->native_bits_per_pixel));
+    if (entry) {
+        entry->device     = state->device;
+        entry->font       = qff_font;
+        entry->code_point = code_point;
+        entry->fg_hsv888  = qp_glyph_cache_color_key(qff_font, state->fg_hsv888);
+        entry->bg_hsv888  = qp_glyph_cache_color_key(qff_font, state->bg_hsv888);
+        entry->width      = width;
+        if (!qp_internal_decode_to_buffer(state->device, qff_font->bpp, width, height, width, 0, state->input_callback, state->input_state, &glyph_cache_data[entry->offset])) {
+            qp_glyph_cache_remove(entry);
+            return false;
+        }
+        return driver->driver_vtable->pixdata(state->device, &glyph_cache_data[entry->offset], pixel_count);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    // Decode the pixel data for the glyph, and stream it
     return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
 }
 
@@ -382,7 +593,7 @@ int16_t qp_textwidth(painter_font_handle_t font, const char *str) {
     // Create the codepoint iterator state
     code_point_iter_calcwidth_state_t state = {.width = 0};
     // Iterate each codepoint, return the calculated width if successful.
-    return qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
+    return qp_iterate_code_points(qff_font, str, NULL, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -428,30 +639,159 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     // Set up the pixel output state
     qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
-    // Set up the codepoint iteration state
+    // Set up the codepoint iteration state -- the font's palette is only prepared once a glyph needs decoding
     code_point_iter_drawglyph_state_t state = {// Common
-                                               .device = device,
-                                               .xpos   = x,
-                                               .ypos   = y,
+                                               .device        = device,
+                                               .xpos          = x,
+                                               .ypos          = y,
+                                               .fg_hsv888     = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}},
+                                               .bg_hsv888     = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}},
+                                               .font_prepared = false,
                                                // Input
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
                                                .output_state = &output_state};
 
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
+    // Iterate the codepoints with the drawglyph callback, drawing cached glyphs directly
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawcached, qp_font_code_point_handler_drawglyph, &state);
+#else  // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    bool ret = qp_iterate_code_points(qff_font, str, NULL, qp_font_code_point_handler_drawglyph, &state);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    qp_dprintf("qp_drawtext_recolor: %s\n", ret ? "ok" : "fail");
+    qp_comms_stop(device);
+    return ret ? (state.xpos - x) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Text run rendering implementation
+
+// Callback state
+typedef struct code_point_iter_rasterize_state_t {
+    painter_device_t                device;
+    uint16_t                        xpos;
+    uint16_t                        stride;
+    qp_pixel_t                      fg_hsv888;
+    qp_pixel_t                      bg_hsv888;
+    bool                            font_prepared;
+    qp_internal_byte_input_callback input_callback;
+    qp_internal_byte_input_state_t *input_state;
+    uint8_t *                       buffer;
+} code_point_iter_rasterize_state_t;
+
+// Codepoint handler callback: decoding into the text run's buffer
+static inline bool qp_font_code_point_handler_rasterize(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+    code_point_iter_rasterize_state_t *state = (code_point_iter_rasterize_state_t *)cb_arg;
+
+    if (!qp_drawtext_ensure_font_prepared(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &state->font_prepared)) {
         return false;
     }
 
-    // Iterate the codepoints with the drawglyph callback
-    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
+    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
+    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
-    qp_dprintf("qp_drawtext_recolor: %s\n", ret ? "ok" : "fail");
+    // Decode the glyph next to the previous one
+    if (!qp_internal_decode_to_buffer(state->device, qff_font->bpp, width, height, state->stride, state->xpos, state->input_callback, state->input_state, state->buffer)) {
+        return false;
+    }
+
+    state->xpos += width;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_textrun_prepare
+
+bool qp_textrun_prepare(painter_device_t device, painter_text_run_t *run, void *buffer, uint32_t buffer_size, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    qp_dprintf("qp_textrun_prepare: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_textrun_prepare: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    qff_font_handle_t *qff_font = (qff_font_handle_t *)font;
+    if (!qff_font || !qff_font->validate_ok) {
+        qp_dprintf("qp_textrun_prepare: fail (invalid font)\n");
+        return false;
+    }
+
+    if (!run || !buffer) {
+        qp_dprintf("qp_textrun_prepare: fail (invalid text run)\n");
+        return false;
+    }
+
+    // Make sure the rendered text fits in the buffer
+    uint16_t width  = qp_textwidth(font, str);
+    uint16_t height = qff_font->base.line_height;
+    if (QP_TEXTRUN_REQUIRED_BUFFER_BYTE_SIZE((uint32_t)width, height, driver->native_bits_per_pixel) > buffer_size) {
+        qp_dprintf("qp_textrun_prepare: fail (buffer too small)\n");
+        return false;
+    }
+
+    // Set up the byte input state and input callback
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
+    if (input_callback == NULL) {
+        qp_dprintf("qp_textrun_prepare: fail (invalid font compression scheme)\n");
+        return false;
+    }
+
+    // Set up the codepoint iteration state
+    code_point_iter_rasterize_state_t state = {.device         = device,
+                                               .xpos           = 0,
+                                               .stride         = width,
+                                               .fg_hsv888      = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}},
+                                               .bg_hsv888      = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}},
+                                               .font_prepared  = false,
+                                               .input_callback = input_callback,
+                                               .input_state    = &input_state,
+                                               .buffer         = (uint8_t *)buffer};
+
+    // Iterate the codepoints with the rasterize callback
+    bool ret = qp_iterate_code_points(qff_font, str, NULL, qp_font_code_point_handler_rasterize, &state);
+    if (ret) {
+        run->width  = width;
+        run->height = height;
+        run->bpp    = driver->native_bits_per_pixel;
+        run->buffer = buffer;
+    }
+
+    qp_dprintf("qp_textrun_prepare: %s\n", ret ? "ok" : "fail");
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_textrun_draw
+
+int16_t qp_textrun_draw(painter_device_t device, uint16_t x, uint16_t y, const painter_text_run_t *run) {
+    qp_dprintf("qp_textrun_draw: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_textrun_draw: fail (validation_ok == false)\n");
+        return 0;
+    }
+
+    if (!run || !run->buffer || run->bpp != driver->native_bits_per_pixel) {
+        qp_dprintf("qp_textrun_draw: fail (invalid text run)\n");
+        return 0;
+    }
+
+    if (run->width == 0) {
+        return 0;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_textrun_draw: fail (could not start comms)\n");
+        return 0;
+    }
+
+    // The text run is already in the native pixel format, so it can be sent as-is
+    bool ret = driver->driver_vtable->viewport(device, x, y, x + run->width - 1, y + run->height - 1) && driver->driver_vtable->pixdata(device, run->buffer, ((uint32_t)run->width) * run->height);
+
+    qp_dprintf("qp_textrun_draw: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
-    return ret ? (state.xpos - x) : 0;
+    return ret ? run->width : 0;
 }
@@ -70,6 +70,9 @@ typedef struct qp_memory_stream_t {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length);
 
+// Returns the stream as a memory stream if it is one, otherwise NULL -- lets decoders read the buffer directly
+qp_memory_stream_t *qp_stream_as_memory_stream(qp_stream_t *stream);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FILE streams
 
@@ -19,9 +19,169 @@
 #    include "autocorrect_data_default.h"
 #endif
 
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+#    ifndef AUTOCORRECT_DATA_EXTERNAL_FLASH
+#        error "AUTOCORRECT_EXTERNAL_FLASH needs an autocorrect_data.h generated with `qmk generate-autocorrect-data --external-flash`"
+#    endif
+#    if (AUTOCORRECT_FLASH_CACHE_LINE_SIZE & (AUTOCORRECT_FLASH_CACHE_LINE_SIZE - 1)) != 0
+#        error "AUTOCORRECT_FLASH_CACHE_LINE_SIZE must be a power of two"
+#    endif
+#    if AUTOCORRECT_FLASH_CACHE_LINES < 1 || AUTOCORRECT_FLASH_CACHE_LINES > 255
+#        error "AUTOCORRECT_FLASH_CACHE_LINES must be between 1 and 255"
+#    endif
+#    include "flash_spi.h"
+#    include "debug.h"
+#elif defined(AUTOCORRECT_DATA_EXTERNAL_FLASH)
+#    error "autocorrect_data.h was generated for external flash, define AUTOCORRECT_EXTERNAL_FLASH to use it"
+#endif
+
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+// Links are 24 bits, and a chain node ending in AUTOCORRECT_CHAIN_LINK is followed by a link to its child, which is
+// shared with another node, instead of the child itself.
+typedef uint32_t autocorrect_state_t;
+#    define AUTOCORRECT_LINK_SIZE 3
+#    define AUTOCORRECT_CHAIN_LINK 1
+
+// The data is preceded by "QAC", the format version, and the size of the data as a 32 bit little endian number.
+#    define AUTOCORRECT_FLASH_HEADER_SIZE 8
+#    define AUTOCORRECT_FLASH_VERSION 1
+#    define AUTOCORRECT_FLASH_NO_LINE UINT32_MAX
+
+typedef struct {
+    uint32_t address; // flash address of data[0], or AUTOCORRECT_FLASH_NO_LINE
+    uint8_t  data[AUTOCORRECT_FLASH_CACHE_LINE_SIZE];
+} autocorrect_flash_line_t;
+
+static enum {
+    AUTOCORRECT_FLASH_UNCHECKED,
+    AUTOCORRECT_FLASH_VALID,
+    AUTOCORRECT_FLASH_INVALID,
+} autocorrect_flash_state = AUTOCORRECT_FLASH_UNCHECKED;
+
+// The root node is scanned on every keystroke, so it is kept in RAM.
+static uint8_t                         autocorrect_flash_root[AUTOCORRECT_ROOT_SIZE];
+static autocorrect_flash_line_t        autocorrect_flash_lines[AUTOCORRECT_FLASH_CACHE_LINES];
+static uint8_t                         autocorrect_flash_lru[AUTOCORRECT_FLASH_CACHE_LINES]; // most recently used first
+static autocorrect_flash_cache_stats_t autocorrect_flash_stats;
+
+static bool autocorrect_flash_header_matches(const uint8_t *header) {
+    const uint32_t size = header[4] | (uint32_t)header[5] << 8 | (uint32_t)header[6] << 16 | (uint32_t)header[7] << 24;
+    return memcmp(header, "QAC", 3) == 0 && header[3] == AUTOCORRECT_FLASH_VERSION && size == DICTIONARY_SIZE;
+}
+
+/**
+ * @brief Checks that the external flash holds the dictionary autocorrect_data.h was generated with
+ *
+ * The check runs on the first lookup after startup or autocorrect_flash_invalidate().
+ *
+ * @return true if the dictionary can be read
+ */
+static bool autocorrect_flash_ready(void) {
+    if (autocorrect_flash_state == AUTOCORRECT_FLASH_UNCHECKED) {
+        uint8_t header[AUTOCORRECT_FLASH_HEADER_SIZE];
+
+        flash_init();
+        for (uint8_t i = 0; i < AUTOCORRECT_FLASH_CACHE_LINES; ++i) {
+            autocorrect_flash_lines[i].address = AUTOCORRECT_FLASH_NO_LINE;
+            autocorrect_flash_lru[i]           = i;
+        }
+
+        if (flash_read_block(AUTOCORRECT_FLASH_ADDRESS, header, sizeof(header)) == FLASH_STATUS_SUCCESS && autocorrect_flash_header_matches(header) && flash_read_block(AUTOCORRECT_FLASH_ADDRESS + AUTOCORRECT_FLASH_HEADER_SIZE, autocorrect_flash_root, AUTOCORRECT_ROOT_SIZE) == FLASH_STATUS_SUCCESS) {
+            autocorrect_flash_state = AUTOCORRECT_FLASH_VALID;
+        } else {
+            dprintf("autocorrect: external flash does not hold the dictionary of autocorrect_data.h\n");
+            autocorrect_flash_state = AUTOCORRECT_FLASH_INVALID;
+        }
+    }
+    return autocorrect_flash_state == AUTOCORRECT_FLASH_VALID;
+}
+
+/**
+ * @brief Reads a byte of the dictionary, through the cache unless it is part of the root node
+ *
+ * @param offset offset into the dictionary
+ * @return the byte, or 0 if it could not be read, which ends the lookup
+ */
+static uint8_t autocorrect_read_byte(autocorrect_state_t offset) {
+    if (offset < AUTOCORRECT_ROOT_SIZE) {
+        return autocorrect_flash_root[offset];
+    }
+
+    const uint32_t address      = AUTOCORRECT_FLASH_ADDRESS + AUTOCORRECT_FLASH_HEADER_SIZE + offset;
+    const uint32_t line_address = address & ~(uint32_t)(AUTOCORRECT_FLASH_CACHE_LINE_SIZE - 1);
+
+    uint8_t i = 0;
+    while (i < AUTOCORRECT_FLASH_CACHE_LINES && autocorrect_flash_lines[autocorrect_flash_lru[i]].address != line_address) {
+        ++i;
+    }
+
+    if (i < AUTOCORRECT_FLASH_CACHE_LINES) {
+        ++autocorrect_flash_stats.hits;
+    } else {
+        // Replace the least recently used line.
+        ++autocorrect_flash_stats.misses;
+        i = AUTOCORRECT_FLASH_CACHE_LINES - 1;
+
+        autocorrect_flash_line_t *line = &autocorrect_flash_lines[autocorrect_flash_lru[i]];
+        if (flash_read_block(line_address, line->data, AUTOCORRECT_FLASH_CACHE_LINE_SIZE) != FLASH_STATUS_SUCCESS) {
+            line->address = AUTOCORRECT_FLASH_NO_LINE;
+            return 0;
+        }
+        line->address = line_address;
+    }
+
+    const uint8_t line = autocorrect_flash_lru[i];
+    memmove(autocorrect_flash_lru + 1, autocorrect_flash_lru, i);
+    autocorrect_flash_lru[0] = line;
+    return autocorrect_flash_lines[line].data[address - line_address];
+}
+
+static autocorrect_state_t autocorrect_read_link(autocorrect_state_t offset) {
+    return autocorrect_read_byte(offset) | (autocorrect_state_t)autocorrect_read_byte(offset + 1) << 8 | (autocorrect_state_t)autocorrect_read_byte(offset + 2) << 16;
+}
+
+/**
+ * @brief Copies the correction of a leaf node to RAM
+ */
+static void autocorrect_read_string(autocorrect_state_t offset, char *str, uint8_t size) {
+    for (uint8_t i = 0; i < size; ++i) {
+        if (!(str[i] = autocorrect_read_byte(offset + i))) {
+            return;
+        }
+    }
+    str[size - 1] = '\0';
+}
+
+/**
+ * @brief Forgets the cached dictionary and checks the external flash again on the next lookup
+ *
+ * Call this after writing a new dictionary to the external flash.
+ */
+void autocorrect_flash_invalidate(void) {
+    autocorrect_flash_state = AUTOCORRECT_FLASH_UNCHECKED;
+}
+
+/**
+ * @brief Gets the cache hits and misses of the dictionary reads since startup or the last reset
+ */
+autocorrect_flash_cache_stats_t autocorrect_flash_get_cache_stats(void) {
+    return autocorrect_flash_stats;
+}
+
+void autocorrect_flash_reset_cache_stats(void) {
+    autocorrect_flash_stats.hits   = 0;
+    autocorrect_flash_stats.misses = 0;
+}
+#else
+typedef uint16_t autocorrect_state_t;
+#    define AUTOCORRECT_LINK_SIZE 2
+#    define autocorrect_read_byte(offset) pgm_read_byte(autocorrect_data + (offset))
+#    define autocorrect_read_link(offset) (pgm_read_byte(autocorrect_data + (offset)) | pgm_read_byte(autocorrect_data + (offset) + 1) << 8)
+#endif
+
 /**
  * @brief function for querying the enabled state of autocorrect
  *
@@ -178,7 +338,7 @@ bool process_autocorrect_default_handler(uint16_t *keycode, keyrecord_t *record,
  * @brief handling for when autocorrection has been triggered
  *
  * @param backspaces number of characters to remove
- * @param str pointer to PROGMEM string to replace mistyped seletion with
+ * @param str pointer to PROGMEM string to replace mistyped seletion with (a RAM string with AUTOCORRECT_EXTERNAL_FLASH)
  * @param typo the wrong string that triggered a correction
  * @param correct what it would become after the changes
  * @return true apply correction
@@ -278,25 +438,37 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
         return true;
     }
 
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+    if (!autocorrect_flash_ready()) {
+        return true;
+    }
+#endif
+
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
+    autocorrect_state_t state = 0;
+    uint8_t             code  = autocorrect_read_byte(state);
     for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
         uint8_t const key_i = typo_buffer[i];
 
         if (code & 64) { // Check for match in node with multiple children.
             code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+            for (; code != key_i; code = autocorrect_read_byte(state += 1 + AUTOCORRECT_LINK_SIZE)) {
                 if (!code) return true;
             }
             // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+            state = autocorrect_read_link(state + 1);
             // Check for match in node with single child.
         } else if (code != key_i) {
             return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
+        } else if (!(code = autocorrect_read_byte(++state))) {
             ++state;
         }
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+        else if (code == AUTOCORRECT_CHAIN_LINK) {
+            // Follow link to a shared child node.
+            state = autocorrect_read_link(state + 1);
+        }
+#endif
 
         // Stop if `state` becomes an invalid index. This should not normally
         // happen, it is a safeguard in case of a bug, data corruption, etc.
@@ -304,11 +476,16 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             return true;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
+        code = autocorrect_read_byte(state);
 
         if (code & 128) { // A typo was found! Apply autocorrect.
             const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            const char *  changes    = (const char *)(autocorrect_data + state + 1);
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+            char changes[AUTOCORRECT_MAX_CORRECTION_LENGTH + 1];
+            autocorrect_read_string(state + 1, changes, sizeof(changes));
+#else
+            const char *changes = (const char *)(autocorrect_data + state + 1);
+#endif
 
             /* Gather info about the typo'd word
              *
@@ -348,17 +525,29 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
              *
              * B) When correcting 'typo' -- Need extra offset for terminator
              */
+#ifdef AUTOCORRECT_MAX_CORRECTION_LENGTH
+            char correct[AUTOCORRECT_MAX_LENGTH + AUTOCORRECT_MAX_CORRECTION_LENGTH + 1] = {0};
+#else
             char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
+#endif
 
             uint8_t offset = space_last ? backspaces : backspaces + 1;
             strcpy(correct, typo);
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+            strcpy(correct + typo_len - offset, changes);
+#else
             strcpy_P(correct + typo_len - offset, changes);
+#endif
 
             if (apply_autocorrect(backspaces, changes, typo, correct)) {
                 for (uint8_t i = 0; i < backspaces; ++i) {
                     tap_code(KC_BSPC);
                 }
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+                send_string(changes);
+#else
                 send_string_P(changes);
+#endif
             }
 
             if (keycode == KC_SPC) {
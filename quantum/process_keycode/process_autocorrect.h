@@ -19,3 +19,24 @@ bool autocorrect_is_enabled(void);
 void autocorrect_enable(void);
 void autocorrect_disable(void);
 void autocorrect_toggle(void);
+
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+#    ifndef AUTOCORRECT_FLASH_ADDRESS
+#        define AUTOCORRECT_FLASH_ADDRESS 0
+#    endif
+#    ifndef AUTOCORRECT_FLASH_CACHE_LINE_SIZE
+#        define AUTOCORRECT_FLASH_CACHE_LINE_SIZE 32
+#    endif
+#    ifndef AUTOCORRECT_FLASH_CACHE_LINES
+#        define AUTOCORRECT_FLASH_CACHE_LINES 8
+#    endif
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+} autocorrect_flash_cache_stats_t;
+
+void                            autocorrect_flash_invalidate(void);
+autocorrect_flash_cache_stats_t autocorrect_flash_get_cache_stats(void);
+void                            autocorrect_flash_reset_cache_stats(void);
+#endif
@@ -26,6 +26,7 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -94,6 +95,35 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEY_INDEX
+/* Maps each combo keycode to the combos containing it, sorted by keycode and
+ * then by combo index so combos are still processed in order. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_key_index_t;
+static combo_key_index_t combo_key_index[COMBO_KEY_INDEX_LENGTH];
+static uint16_t          combo_key_index_size = 0;
+
+enum { COMBO_KEY_INDEX_UNBUILT, COMBO_KEY_INDEX_READY, COMBO_KEY_INDEX_OVERFLOW };
+static uint8_t combo_key_index_state = COMBO_KEY_INDEX_UNBUILT;
+
+/* Combos that have been handed a key since they were last cleared. */
+static uint8_t combo_pending[(COMBO_KEY_INDEX_LENGTH + 7) / 8];
+
+#    define COMBO_PENDING(index) (combo_pending[(index) / 8] & (1 << ((index) % 8)))
+#    define SET_COMBO_PENDING(index)                          \
+        do {                                                  \
+            combo_pending[(index) / 8] |= (1 << ((index) % 8)); \
+        } while (0)
+#    define CLEAR_COMBO_PENDING(index)                         \
+        do {                                                   \
+            combo_pending[(index) / 8] &= ~(1 << ((index) % 8)); \
+        } while (0)
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -194,6 +224,26 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_state == COMBO_KEY_INDEX_READY) {
+        // only combos that were handed a key can have state to reset
+        for (index = 0; index < combo_count(); ++index) {
+            if (!combo_pending[index / 8]) {
+                index |= 7;
+                continue;
+            }
+            if (!COMBO_PENDING(index)) {
+                continue;
+            }
+            combo_t *combo = combo_get(index);
+            if (!COMBO_ACTIVE(combo)) {
+                RESET_COMBO_STATE(combo);
+                CLEAR_COMBO_PENDING(index);
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -414,16 +464,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
-
+static bool process_combo_key(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index, uint16_t key_index, uint8_t key_count) {
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -534,6 +575,85 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return false;
+    }
+
+    return process_combo_key(combo, keycode, record, combo_index, key_index, key_count);
+}
+
+#ifdef COMBO_KEY_INDEX
+static void combo_key_index_build(void) {
+    uint16_t size = 0;
+
+    combo_key_index_state = COMBO_KEY_INDEX_OVERFLOW;
+    if (combo_count() > COMBO_KEY_INDEX_LENGTH) {
+        dprintf("combo: %u combos do not fit COMBO_KEY_INDEX_LENGTH\n", combo_count());
+        return;
+    }
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        const uint16_t *keys      = combo_get(idx)->keys;
+        uint16_t        first     = size;
+        uint8_t         key_count = 0;
+        uint16_t        key;
+
+        while ((key = pgm_read_word(&keys[key_count])) != COMBO_END) {
+            // a key listed twice matches its last position, as in _find_key_index_and_count()
+            uint16_t i = first;
+            while (i < size && combo_key_index[i].keycode != key) {
+                i++;
+            }
+            if (i == size) {
+                if (size == COMBO_KEY_INDEX_LENGTH) {
+                    dprintf("combo: combo keys do not fit COMBO_KEY_INDEX_LENGTH\n");
+                    return;
+                }
+                combo_key_index[size++] = (combo_key_index_t){.keycode = key, .combo_index = idx};
+            }
+            combo_key_index[i].key_index = key_count++;
+        }
+        for (uint16_t i = first; i < size; i++) {
+            combo_key_index[i].key_count = key_count;
+        }
+    }
+
+    // stable insertion sort, so each keycode's combos stay in combo index order
+    for (uint16_t i = 1; i < size; i++) {
+        combo_key_index_t entry = combo_key_index[i];
+        uint16_t          j     = i;
+        while (j > 0 && combo_key_index[j - 1].keycode > entry.keycode) {
+            combo_key_index[j] = combo_key_index[j - 1];
+            j--;
+        }
+        combo_key_index[j] = entry;
+    }
+
+    combo_key_index_size  = size;
+    combo_key_index_state = COMBO_KEY_INDEX_READY;
+}
+
+/* Returns the first index entry for the keycode, or combo_key_index_size. */
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    uint16_t lo = 0, hi = combo_key_index_size;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (combo_key_index[mid].keycode < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     bool is_combo_key          = false;
     bool no_combo_keys_pressed = true;
@@ -564,10 +684,25 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_state == COMBO_KEY_INDEX_UNBUILT) {
+        combo_key_index_build();
+    }
+    if (combo_key_index_state == COMBO_KEY_INDEX_READY) {
+        // only the combos containing this keycode can react to it
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_index_size && combo_key_index[i].keycode == keycode; i++) {
+            const combo_key_index_t *entry = &combo_key_index[i];
+            SET_COMBO_PENDING(entry->combo_index);
+            is_combo_key |= process_combo_key(combo_get(entry->combo_index), keycode, record, entry->combo_index, entry->key_index, entry->key_count);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
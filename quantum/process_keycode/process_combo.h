@@ -38,6 +38,9 @@
 #ifndef COMBO_BUFFER_LENGTH
 #    define COMBO_BUFFER_LENGTH 4
 #endif
+#if defined(COMBO_KEY_INDEX) && !defined(COMBO_KEY_INDEX_LENGTH)
+#    define COMBO_KEY_INDEX_LENGTH 64
+#endif
 
 typedef struct combo_t {
     const uint16_t *keys;
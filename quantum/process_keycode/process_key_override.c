@@ -86,6 +86,26 @@ static bool enabled = true;
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
+#ifdef KEY_OVERRIDE_INDEX
+/* Maps each trigger keycode to the overrides it triggers, sorted by trigger and then by position in key_overrides, so
+ * overrides are still tried in order. KC_NO triggers sort first. The layers and trigger mods are copied in so most
+ * overrides can be ruled out without reading them. */
+typedef struct {
+    uint16_t      trigger;
+    uint8_t       override_index;
+    uint8_t       trigger_mods;
+    layer_state_t layers;
+} key_override_index_t;
+static key_override_index_t key_override_index[KEY_OVERRIDE_INDEX_LENGTH];
+static uint8_t              key_override_index_size = 0;
+
+// The layers any override applies to
+static layer_state_t key_override_index_layers = 0;
+
+enum { KEY_OVERRIDE_INDEX_UNBUILT, KEY_OVERRIDE_INDEX_READY, KEY_OVERRIDE_INDEX_OVERFLOW };
+static uint8_t key_override_index_state = KEY_OVERRIDE_INDEX_UNBUILT;
+#endif
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
@@ -245,147 +265,253 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Tries activating the provided override. Returns true if it activated, and then sets `send_key_action` to whether the key action for `keycode` should be sent */
+static bool try_activating_single_override(const key_override_t *const override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *send_key_action) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        const bool is_trigger = override->trigger == keycode;
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    key_override_printf("Activating override\n");
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    clear_active_override(false);
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+#ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
+#endif
 
-        key_override_printf("Activating override\n");
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        clear_active_override(false);
+    set_suppressed_override_mods(override->suppressed_mods);
 
-#ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
-#endif
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
+        }
+    }
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
+
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
+
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
+
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    *send_key_action = !trigger_down;
+    return true;
+}
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+#ifdef KEY_OVERRIDE_INDEX
+static void key_override_index_build(void) {
+    uint8_t size = 0;
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+    key_override_index_state  = KEY_OVERRIDE_INDEX_OVERFLOW;
+    key_override_index_layers = 0;
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+    for (uint8_t i = 0; key_overrides[i] != NULL; i++) {
+        if (size == KEY_OVERRIDE_INDEX_LENGTH) {
+            dprintf("key override: overrides do not fit KEY_OVERRIDE_INDEX_LENGTH\n");
+            return;
         }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+        const key_override_t *const override = key_overrides[i];
+        key_override_index_t        entry    = {.trigger = override->trigger, .override_index = i, .trigger_mods = override->trigger_mods, .layers = override->layers};
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
-            }
+        // insertion sort, stable so each trigger's overrides stay in order
+        uint8_t j = size++;
+        while (j > 0 && key_override_index[j - 1].trigger > entry.trigger) {
+            key_override_index[j] = key_override_index[j - 1];
+            j--;
+        }
+        key_override_index[j] = entry;
+        key_override_index_layers |= override->layers;
+    }
+
+    key_override_index_size  = size;
+    key_override_index_state = KEY_OVERRIDE_INDEX_READY;
+}
+
+/* Returns the first index entry for the trigger, or key_override_index_size. */
+static uint8_t key_override_index_find(uint16_t trigger) {
+    uint8_t lo = 0, hi = key_override_index_size;
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) / 2;
+        if (key_override_index[mid].trigger < trigger) {
+            lo = mid + 1;
         } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/** Tries the overrides that can activate for this event, in the order of key_overrides: those triggered by `keycode`, by the last non-mod key pressed down, and by KC_NO. */
+static bool try_activating_indexed_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    uint16_t triggers[] = {KC_NO, keycode, last_key_down};
+    uint8_t  next[3], end[3];
+
+    *activated = false;
+    if ((key_override_index_layers & ((layer_state_t)1 << layer)) == 0) {
+        return true;
+    }
+
+    for (uint8_t t = 0; t < 3; t++) {
+        next[t] = key_override_index_find(triggers[t]);
+        end[t]  = next[t];
+        // each trigger is only tried once
+        if (t == 2 && triggers[2] == triggers[1]) {
+            continue;
         }
+        if (t > 0 && triggers[t] == KC_NO) {
+            continue;
+        }
+        while (end[t] < key_override_index_size && key_override_index[end[t]].trigger == triggers[t]) {
+            end[t]++;
+        }
+    }
+
+    for (;;) {
+        // merge the three runs by position in key_overrides
+        uint8_t t = 3;
+        for (uint8_t i = 0; i < 3; i++) {
+            if (next[i] < end[i] && (t == 3 || key_override_index[next[i]].override_index < key_override_index[next[t]].override_index)) {
+                t = i;
+            }
+        }
+        if (t == 3) {
+            return true;
+        }
+
+        const key_override_index_t *const entry = &key_override_index[next[t]++];
 
-        *activated = true;
+        if ((active_mods == 0 && entry->trigger_mods != 0) || (entry->layers & ((layer_state_t)1 << layer)) == 0) {
+            continue;
+        }
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+        bool send_key_action;
+        if (try_activating_single_override(key_overrides[entry->override_index], keycode, layer, key_down, is_mod, active_mods, &send_key_action)) {
+            *activated = true;
+            return send_key_action;
+        }
+    }
+}
+#endif
+
+/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_overrides == NULL) {
+        return true;
+    }
+
+#ifdef KEY_OVERRIDE_INDEX
+    if (key_override_index_state == KEY_OVERRIDE_INDEX_UNBUILT) {
+        key_override_index_build();
+    }
+    if (key_override_index_state == KEY_OVERRIDE_INDEX_READY) {
+        return try_activating_indexed_override(keycode, layer, key_down, is_mod, active_mods, activated);
+    }
+#endif
+
+    for (uint8_t i = 0; key_overrides[i] != NULL; i++) {
+        bool send_key_action;
+        if (try_activating_single_override(key_overrides[i], keycode, layer, key_down, is_mod, active_mods, &send_key_action)) {
+            *activated = true;
+            return send_key_action;
+        }
     }
 
     *activated = false;
@@ -22,6 +22,13 @@
 #include "action.h"
 #include "action_layer.h"
 
+#if defined(KEY_OVERRIDE_INDEX) && !defined(KEY_OVERRIDE_INDEX_LENGTH)
+#    define KEY_OVERRIDE_INDEX_LENGTH 64
+#endif
+#if defined(KEY_OVERRIDE_INDEX) && KEY_OVERRIDE_INDEX_LENGTH > 255
+#    error "KEY_OVERRIDE_INDEX_LENGTH must not be greater than 255"
+#endif
+
 /**
  * Key overrides allow you to send a different key-modifier combination or perform a custom action when a certain modifier-key combination is pressed.
  *
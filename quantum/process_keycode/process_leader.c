@@ -35,6 +35,14 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                 return true;
             }
 
+#ifdef LEADER_SEQUENCE_TABLE
+            if (!leader_sequence_may_continue()) {
+                leader_end();
+
+                return false;
+            }
+#endif
+
 #ifdef LEADER_PER_KEY_TIMING
             leader_reset_timer();
 #endif
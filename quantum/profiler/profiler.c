@@ -0,0 +1,326 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "profiler.h"
+#include "timer.h"
+#include "print.h"
+#include "debug.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    include "chibios_config.h"
+#elif defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#endif
+
+#ifndef PROFILER_CONSOLE_INTERVAL
+#    define PROFILER_CONSOLE_INTERVAL 5000
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint16_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+} profiler_stage_data_t;
+
+static profiler_stage_data_t profiler_data[PROFILER_STAGE_COUNT];
+static bool                  profiler_running = false;
+static uint32_t              profiler_pass_start;
+static uint32_t              profiler_last_mark;
+#if defined(CONSOLE_ENABLE) && PROFILER_CONSOLE_INTERVAL > 0
+static uint32_t profiler_console_timer = 0;
+#endif
+
+#if defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE)
+__attribute__((weak)) uint32_t profiler_timer_read(void) {
+    return (uint32_t)chSysGetRealtimeCounterX();
+}
+
+__attribute__((weak)) uint32_t profiler_timer_ticks_to_us(uint32_t ticks) {
+    // RTC2US() rounds up, which underflows for zero
+    return ticks ? RTC2US(REALTIME_COUNTER_CLOCK, ticks) : 0;
+}
+#elif defined(__AVR__)
+extern volatile uint32_t timer_count;
+
+// Timer0 counts TIMER_RAW_TOP + 1 ticks per millisecond
+__attribute__((weak)) uint32_t profiler_timer_read(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+#    if defined(TIFR0) && defined(OCF0A)
+        // Compare match already happened, but the millisecond interrupt has not run yet
+        if ((TIFR0 & _BV(OCF0A)) && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+#    endif
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+}
+
+__attribute__((weak)) uint32_t profiler_timer_ticks_to_us(uint32_t ticks) {
+    return (ticks / (TIMER_RAW_TOP + 1)) * 1000 + (ticks % (TIMER_RAW_TOP + 1)) * 1000 / (TIMER_RAW_TOP + 1);
+}
+#else
+__attribute__((weak)) uint32_t profiler_timer_read(void) {
+    return timer_read32();
+}
+
+__attribute__((weak)) uint32_t profiler_timer_ticks_to_us(uint32_t ticks) {
+    return ticks * 1000;
+}
+#endif
+
+static void profiler_record(profiler_stage_t stage, uint32_t ticks) {
+    profiler_stage_data_t *data = &profiler_data[stage];
+    uint32_t               us   = profiler_timer_ticks_to_us(ticks);
+
+    if (data->count == 0 || us < data->min) {
+        data->min = us;
+    }
+    if (us > data->max) {
+        data->max = us;
+    }
+    data->count++;
+    data->total += us;
+
+    // Power of two buckets: bucket 0 holds 0us, bucket n holds [2^(n-1), 2^n) with the last one open ended
+    uint8_t bucket = 0;
+    while (us && bucket < PROFILER_HISTOGRAM_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    if (data->histogram[bucket] == UINT16_MAX) {
+        // Keep the shape of the distribution rather than saturating
+        for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+            data->histogram[i] >>= 1;
+        }
+    }
+    data->histogram[bucket]++;
+}
+
+void profiler_begin(void) {
+    profiler_pass_start = profiler_last_mark = profiler_timer_read();
+    profiler_running                         = true;
+}
+
+void profiler_mark(profiler_stage_t stage) {
+    if (!profiler_running || stage >= PROFILER_STAGE_KEYBOARD_TASK) {
+        return;
+    }
+    profiler_record(stage, profiler_timer_read() - profiler_last_mark);
+    // Restart after recording so the profiler's own overhead is only visible in the total
+    profiler_last_mark = profiler_timer_read();
+}
+
+void profiler_end(void) {
+    if (!profiler_running) {
+        return;
+    }
+    profiler_record(PROFILER_STAGE_KEYBOARD_TASK, profiler_timer_read() - profiler_pass_start);
+    profiler_running = false;
+
+#if defined(CONSOLE_ENABLE) && PROFILER_CONSOLE_INTERVAL > 0
+    if (debug_enable && timer_elapsed32(profiler_console_timer) >= PROFILER_CONSOLE_INTERVAL) {
+        profiler_console_timer = timer_read32();
+        profiler_print();
+    }
+#endif
+}
+
+bool profiler_get_stats(profiler_stage_t stage, profiler_stats_t *stats) {
+    if (stage >= PROFILER_STAGE_COUNT) {
+        return false;
+    }
+
+    const profiler_stage_data_t *data = &profiler_data[stage];
+    memset(stats, 0, sizeof(profiler_stats_t));
+    if (data->count == 0) {
+        return true;
+    }
+
+    stats->count = data->count;
+    stats->min   = data->min;
+    stats->max   = data->max;
+    stats->avg   = data->total / data->count;
+
+    uint32_t samples = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        samples += data->histogram[i];
+    }
+    uint32_t threshold = samples - samples / 100;
+    uint32_t seen      = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        seen += data->histogram[i];
+        if (seen >= threshold) {
+            stats->p99 = (i == PROFILER_HISTOGRAM_BUCKETS - 1) ? data->max : (1UL << i) - 1;
+            break;
+        }
+    }
+    if (stats->p99 < stats->min) {
+        stats->p99 = stats->min;
+    }
+    if (stats->p99 > stats->max) {
+        stats->p99 = stats->max;
+    }
+    return true;
+}
+
+const char *profiler_stage_name(profiler_stage_t stage) {
+    switch (stage) {
+        case PROFILER_STAGE_MATRIX:
+            return "matrix";
+        case PROFILER_STAGE_QUANTUM:
+            return "quantum";
+#if defined(I2C_ASYNC_ENABLE)
+        case PROFILER_STAGE_I2C_ASYNC:
+            return "i2c_async";
+#endif
+#if defined(SPLIT_WATCHDOG_ENABLE)
+        case PROFILER_STAGE_SPLIT_WATCHDOG:
+            return "split_watchdog";
+#endif
+#if defined(RGBLIGHT_ENABLE)
+        case PROFILER_STAGE_RGBLIGHT:
+            return "rgblight";
+#endif
+#if defined(LED_MATRIX_ENABLE)
+        case PROFILER_STAGE_LED_MATRIX:
+            return "led_matrix";
+#endif
+#if defined(RGB_MATRIX_ENABLE)
+        case PROFILER_STAGE_RGB_MATRIX:
+            return "rgb_matrix";
+#endif
+#if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+        case PROFILER_STAGE_BACKLIGHT:
+            return "backlight";
+#endif
+#if defined(ENCODER_ENABLE)
+        case PROFILER_STAGE_ENCODER:
+            return "encoder";
+#endif
+#if defined(POINTING_DEVICE_ENABLE)
+        case PROFILER_STAGE_POINTING_DEVICE:
+            return "pointing_device";
+#endif
+#if defined(OLED_ENABLE)
+        case PROFILER_STAGE_OLED:
+            return "oled";
+#endif
+#if defined(ST7565_ENABLE)
+        case PROFILER_STAGE_ST7565:
+            return "st7565";
+#endif
+#if defined(MOUSEKEY_ENABLE)
+        case PROFILER_STAGE_MOUSEKEY:
+            return "mousekey";
+#endif
+#if defined(PS2_MOUSE_ENABLE)
+        case PROFILER_STAGE_PS2_MOUSE:
+            return "ps2_mouse";
+#endif
+#if defined(MIDI_ENABLE)
+        case PROFILER_STAGE_MIDI:
+            return "midi";
+#endif
+#if defined(JOYSTICK_ENABLE)
+        case PROFILER_STAGE_JOYSTICK:
+            return "joystick";
+#endif
+#if defined(BLUETOOTH_ENABLE)
+        case PROFILER_STAGE_BLUETOOTH:
+            return "bluetooth";
+#endif
+#if defined(HAPTIC_ENABLE)
+        case PROFILER_STAGE_HAPTIC:
+            return "haptic";
+#endif
+        case PROFILER_STAGE_LED:
+            return "led";
+#if defined(OS_DETECTION_ENABLE)
+        case PROFILER_STAGE_OS_DETECTION:
+            return "os_detection";
+#endif
+#if defined(REPORT_QUEUE_ENABLE)
+        case PROFILER_STAGE_REPORT_QUEUE:
+            return "report_queue";
+#endif
+        case PROFILER_STAGE_KEYBOARD_TASK:
+            return "keyboard_task";
+        default:
+            return "unknown";
+    }
+}
+
+void profiler_reset(void) {
+    memset(profiler_data, 0, sizeof(profiler_data));
+}
+
+void profiler_print(void) {
+    profiler_stats_t stats;
+    uprintf("%-16s %10s %8s %8s %8s %8s\n", "stage (us)", "count", "min", "avg", "max", "p99");
+    for (uint8_t i = 0; i < PROFILER_STAGE_COUNT; i++) {
+        profiler_get_stats(i, &stats);
+        uprintf("%-16s %10lu %8lu %8lu %8lu %8lu\n", profiler_stage_name(i), (unsigned long)stats.count, (unsigned long)stats.min, (unsigned long)stats.avg, (unsigned long)stats.max, (unsigned long)stats.p99);
+    }
+}
+
+static void profiler_put_u32(uint8_t *data, uint32_t value) {
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value & 0xFF;
+}
+
+bool profiler_raw_hid_command(uint8_t *data, uint8_t length) {
+    if (length < 4 || data[0] != PROFILER_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command_id   = &(data[1]);
+    uint8_t *command_data = &(data[2]);
+    uint8_t  data_length  = length - 2;
+
+    switch (*command_id) {
+        case id_profiler_get_stage_count: {
+            command_data[0] = PROFILER_STAGE_COUNT;
+            break;
+        }
+        case id_profiler_get_stage_name: {
+            const char *name = profiler_stage_name(command_data[0]);
+            memset(&command_data[1], 0, data_length - 1);
+            strncpy((char *)&command_data[1], name, data_length - 2);
+            break;
+        }
+        case id_profiler_get_stage_stats: {
+            profiler_stats_t stats;
+            if (data_length < 1 + 5 * sizeof(uint32_t) || !profiler_get_stats(command_data[0], &stats)) {
+                *command_id = 0xFF;
+                break;
+            }
+            profiler_put_u32(&command_data[1], stats.count);
+            profiler_put_u32(&command_data[5], stats.min);
+            profiler_put_u32(&command_data[9], stats.avg);
+            profiler_put_u32(&command_data[13], stats.max);
+            profiler_put_u32(&command_data[17], stats.p99);
+            break;
+        }
+        case id_profiler_reset: {
+            profiler_reset();
+            break;
+        }
+        default: {
+            *command_id = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
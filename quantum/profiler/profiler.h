@@ -0,0 +1,158 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \defgroup profiler Scan-loop profiler
+ *
+ * \brief Times each stage of keyboard_task() and keeps min/avg/max/p99 statistics per stage.
+ *
+ * Statistics accumulate until profiler_reset() is called, and can be read over console (profiler_print()) or raw HID
+ * (profiler_raw_hid_command()).
+ *
+ * \{
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef PROFILER_HISTOGRAM_BUCKETS
+#    define PROFILER_HISTOGRAM_BUCKETS 16
+#endif
+
+#ifndef PROFILER_RAW_HID_COMMAND_ID
+#    define PROFILER_RAW_HID_COMMAND_ID 0xF0
+#endif
+
+/** \brief Stages of keyboard_task() that are timed, only stages of enabled features are present
+ */
+typedef enum {
+    PROFILER_STAGE_MATRIX,
+    PROFILER_STAGE_QUANTUM,
+#if defined(I2C_ASYNC_ENABLE)
+    PROFILER_STAGE_I2C_ASYNC,
+#endif
+#if defined(SPLIT_WATCHDOG_ENABLE)
+    PROFILER_STAGE_SPLIT_WATCHDOG,
+#endif
+#if defined(RGBLIGHT_ENABLE)
+    PROFILER_STAGE_RGBLIGHT,
+#endif
+#if defined(LED_MATRIX_ENABLE)
+    PROFILER_STAGE_LED_MATRIX,
+#endif
+#if defined(RGB_MATRIX_ENABLE)
+    PROFILER_STAGE_RGB_MATRIX,
+#endif
+#if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    PROFILER_STAGE_BACKLIGHT,
+#endif
+#if defined(ENCODER_ENABLE)
+    PROFILER_STAGE_ENCODER,
+#endif
+#if defined(POINTING_DEVICE_ENABLE)
+    PROFILER_STAGE_POINTING_DEVICE,
+#endif
+#if defined(OLED_ENABLE)
+    PROFILER_STAGE_OLED,
+#endif
+#if defined(ST7565_ENABLE)
+    PROFILER_STAGE_ST7565,
+#endif
+#if defined(MOUSEKEY_ENABLE)
+    PROFILER_STAGE_MOUSEKEY,
+#endif
+#if defined(PS2_MOUSE_ENABLE)
+    PROFILER_STAGE_PS2_MOUSE,
+#endif
+#if defined(MIDI_ENABLE)
+    PROFILER_STAGE_MIDI,
+#endif
+#if defined(JOYSTICK_ENABLE)
+    PROFILER_STAGE_JOYSTICK,
+#endif
+#if defined(BLUETOOTH_ENABLE)
+    PROFILER_STAGE_BLUETOOTH,
+#endif
+#if defined(HAPTIC_ENABLE)
+    PROFILER_STAGE_HAPTIC,
+#endif
+    PROFILER_STAGE_LED,
+#if defined(OS_DETECTION_ENABLE)
+    PROFILER_STAGE_OS_DETECTION,
+#endif
+#if defined(REPORT_QUEUE_ENABLE)
+    PROFILER_STAGE_REPORT_QUEUE,
+#endif
+    PROFILER_STAGE_KEYBOARD_TASK, // the whole of keyboard_task()
+    PROFILER_STAGE_COUNT,
+} profiler_stage_t;
+
+/** \brief Summary of the samples recorded for one stage, all durations in microseconds
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+    uint32_t p99; // upper bound of the histogram bucket holding the 99th percentile, clamped to [min, max]
+} profiler_stats_t;
+
+/** \brief Raw HID sub-commands, following PROFILER_RAW_HID_COMMAND_ID in the first byte of a report
+ */
+enum profiler_raw_hid_command_id {
+    id_profiler_get_stage_count = 0x01, // -> stage count
+    id_profiler_get_stage_name  = 0x02, // stage -> NUL terminated name, truncated to fit
+    id_profiler_get_stage_stats = 0x03, // stage -> count, min, avg, max, p99, each 32-bit big-endian
+    id_profiler_reset           = 0x04,
+};
+
+/** \brief Starts timing a pass through keyboard_task()
+ */
+void profiler_begin(void);
+
+/** \brief Attributes the time since the previous mark (or profiler_begin()) to the given stage
+ */
+void profiler_mark(profiler_stage_t stage);
+
+/** \brief Finishes timing a pass through keyboard_task(), recording PROFILER_STAGE_KEYBOARD_TASK
+ */
+void profiler_end(void);
+
+/** \brief Fills in the statistics for a stage, returns false for unknown stages
+ */
+bool profiler_get_stats(profiler_stage_t stage, profiler_stats_t *stats);
+
+/** \brief Returns a human readable name for a stage
+ */
+const char *profiler_stage_name(profiler_stage_t stage);
+
+/** \brief Discards all recorded samples
+ */
+void profiler_reset(void);
+
+/** \brief Prints the statistics of all stages over console
+ */
+void profiler_print(void);
+
+/** \brief Handles a profiler raw HID request in place
+ *
+ * Returns false if the request is not a profiler request, otherwise the buffer holds the response to be sent back.
+ */
+bool profiler_raw_hid_command(uint8_t *data, uint8_t length);
+
+/** \brief Reads the free-running counter used for timing stages
+ *
+ * Defaults to the best counter available on the platform, and can be overridden by keyboards with a better one
+ * together with profiler_timer_ticks_to_us(). Only differences between readings are used, so it may wrap.
+ */
+uint32_t profiler_timer_read(void);
+
+/** \brief Converts a difference between two profiler_timer_read() values to microseconds
+ */
+uint32_t profiler_timer_ticks_to_us(uint32_t ticks);
+
+/** \} */
@@ -15,6 +15,7 @@
  */
 
 #include "quantum.h"
+#include "keycode_dispatch.h"
 
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
 #    include "process_backlight.h"
@@ -68,6 +69,10 @@
 #    include "process_unicode_common.h"
 #endif
 
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_COMBINING)
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -174,6 +179,9 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_COMBINING)
+    eeprom_driver_flush();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -296,11 +304,19 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
-    if (!(
 #if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
 #endif
+
+    // Handlers that only act on their own keycodes are skipped unless the
+    // generated dispatch table maps the keycode to them.
+    const uint8_t dispatch = keycode_dispatch_handler(keycode);
+    (void)dispatch;
+
+    if (!(
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
             // Must run asap to ensure all keypresses are recorded.
             process_dynamic_macro(keycode, record) &&
@@ -325,19 +341,19 @@ bool process_record_quantum(keyrecord_t *record) {
             process_secure(keycode, record) &&
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_SEQUENCER || process_sequencer(keycode, record)) &&
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_MIDI || process_midi(keycode, record)) &&
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_AUDIO || process_audio(keycode, record)) &&
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_BACKLIGHT || process_backlight(keycode, record)) &&
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_STENO || process_steno(keycode, record)) &&
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
             process_music(keycode, record) &&
@@ -361,31 +377,31 @@ bool process_record_quantum(keyrecord_t *record) {
             process_auto_shift(keycode, record) &&
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_DYNAMIC_TAPPING_TERM || process_dynamic_tapping_term(keycode, record)) &&
 #endif
 #ifdef SPACE_CADET_ENABLE
             process_space_cadet(keycode, record) &&
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_MAGIC || process_magic(keycode, record)) &&
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_GRAVE_ESC || process_grave_esc(keycode, record)) &&
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_RGB || process_rgb(keycode, record)) &&
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_JOYSTICK || process_joystick(keycode, record)) &&
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_PROGRAMMABLE_BUTTON || process_programmable_button(keycode, record)) &&
 #endif
 #ifdef AUTOCORRECT_ENABLE
             process_autocorrect(keycode, record) &&
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+            (dispatch != KEYCODE_DISPATCH_TRI_LAYER || process_tri_layer(keycode, record)) &&
 #endif
             true)) {
         return false;
@@ -504,6 +520,10 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITE_COMBINING)
+    // power may be cut while suspended
+    eeprom_driver_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -4,6 +4,17 @@
 
 typedef HSV (*reactive_f)(HSV hsv, uint16_t offset);
 
+// True once every remembered hit has faded out, i.e. every LED is drawn with the maximum offset
+static inline bool effect_runner_reactive_idle(void) {
+    uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+        if (g_last_hit_tracker.tick[j] < max_tick) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
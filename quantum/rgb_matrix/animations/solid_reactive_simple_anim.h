@@ -12,6 +12,9 @@ static HSV SOLID_REACTIVE_SIMPLE_math(HSV hsv, uint16_t offset) {
 }
 
 bool SOLID_REACTIVE_SIMPLE(effect_params_t* params) {
+#            ifndef RGB_MATRIX_SOLID_REACTIVE_GRADIENT_MODE
+    params->static_frame = effect_runner_reactive_idle();
+#            endif
     return effect_runner_reactive(params, &SOLID_REACTIVE_SIMPLE_math);
 }
 
@@ -69,13 +69,27 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+led_geometry_t g_led_geometry;
+#endif // RGB_MATRIX_LED_GEOMETRY_CACHE
 
 // internals
 static bool            suspend_state     = false;
 static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
-static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
+static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false, false};
 static rgb_task_states rgb_task_state    = SYNCING;
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+static bool         rgb_static_valid          = false; // the last completed render was declared static by its effect
+static bool         rgb_static_render         = false; // every effect call of the current render declared it static
+static bool         rgb_static_skip           = false; // the current frame reuses the last render
+static uint8_t      rgb_static_effect         = UINT8_MAX;
+static rgb_config_t rgb_static_config         = {0};
+static rgb_config_t rgb_render_config         = {0};
+static bool         rgb_drawing_indicators    = false;
+static bool         rgb_indicators_drawn      = false;
+static bool         rgb_indicators_drawn_last = false;
+#endif
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -144,10 +158,16 @@ void rgb_matrix_update_pwm_buffers(void) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    rgb_indicators_drawn |= rgb_drawing_indicators;
+#endif
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    rgb_indicators_drawn |= rgb_drawing_indicators;
+#endif
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
@@ -182,6 +202,12 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
     }
 
+#    ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    if (led_count > 0) {
+        rgb_static_valid = false;
+    }
+#    endif
+
     for (uint8_t i = 0; i < led_count; i++) {
         uint8_t index                = last_hit_buffer.count;
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
@@ -274,10 +300,40 @@ static void rgb_task_start(void) {
     g_last_hit_tracker = last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    rgb_indicators_drawn_last = rgb_indicators_drawn;
+    rgb_indicators_drawn      = false;
+#endif
+
     // next task
     rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+static bool rgb_task_can_skip_render(uint8_t effect) {
+    // Decide once per frame, so a frame is either rendered or skipped as a whole
+    if (rgb_effect_params.iter == 0) {
+        rgb_static_skip = rgb_static_valid && !rgb_indicators_drawn_last && effect == rgb_static_effect && effect == rgb_last_effect && rgb_matrix_config.enable == rgb_last_enable && rgb_matrix_config.raw == rgb_static_config.raw;
+    }
+    return rgb_static_skip;
+}
+
+static void rgb_task_skip_render(void) {
+    // The driver buffers still hold the output of the last render, only step through the iterations so that
+    // rgb_matrix_indicators_advanced() sees the usual LED ranges
+    RGB_MATRIX_USE_LIMITS_ITER(led_min, led_max, rgb_effect_params.iter);
+    rgb_effect_params.init = false;
+    rgb_effect_params.iter++;
+
+    if (!rgb_matrix_check_finished_leds(led_max)) {
+        rgb_task_state = FLUSHING;
+    }
+}
+#else
+#    define rgb_task_can_skip_render(effect) false
+#    define rgb_task_skip_render()
+#endif
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
@@ -286,6 +342,14 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    if (rgb_effect_params.iter == 0) {
+        rgb_static_render = true;
+        rgb_render_config = rgb_matrix_config;
+    }
+    rgb_effect_params.static_frame = false;
+#endif
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -328,6 +392,15 @@ static void rgb_task_render(uint8_t effect) {
 
     rgb_effect_params.iter++;
 
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    rgb_static_render &= rgb_effect_params.static_frame;
+    if (!rendering) {
+        rgb_static_valid  = rgb_static_render;
+        rgb_static_effect = effect;
+        rgb_static_config = rgb_render_config;
+    }
+#endif
+
     // next task
     if (!rendering) {
         rgb_task_state = FLUSHING;
@@ -368,12 +441,22 @@ void rgb_matrix_task(void) {
             rgb_task_start();
             break;
         case RENDERING:
-            rgb_task_render(effect);
+            if (rgb_task_can_skip_render(effect)) {
+                rgb_task_skip_render();
+            } else {
+                rgb_task_render(effect);
+            }
             if (effect) {
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+                rgb_drawing_indicators = true;
+#endif
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+                rgb_drawing_indicators = false;
+#endif
             }
             break;
         case FLUSHING:
@@ -445,9 +528,26 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+void rgb_matrix_update_led_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+        g_led_geometry.dx[i]   = dx;
+        g_led_geometry.dy[i]   = dy;
+        g_led_geometry.dist[i] = sqrt16(dx * dx + dy * dy);
+    }
+}
+#endif // RGB_MATRIX_LED_GEOMETRY_CACHE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+    rgb_matrix_update_led_geometry();
+#endif // RGB_MATRIX_LED_GEOMETRY_CACHE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
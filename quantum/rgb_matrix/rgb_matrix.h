@@ -277,3 +277,9 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+extern led_geometry_t g_led_geometry;
+
+/* Recomputes g_led_geometry, for keyboards that change g_led_config.point after rgb_matrix_init() */
+void rgb_matrix_update_led_geometry(void);
+#endif
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "color.h"
@@ -48,6 +52,7 @@ typedef struct PACKED {
     uint8_t     iter;
     led_flags_t flags;
     bool        init;
+    bool        static_frame; // set by the effect if this frame only depends on rgb_matrix_config
 } effect_params_t;
 
 typedef struct PACKED {
@@ -73,6 +78,15 @@ typedef struct PACKED {
     uint8_t     flags[RGB_MATRIX_LED_COUNT];
 } led_config_t;
 
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+// Position of each LED relative to k_rgb_matrix_center, one array per field so the runners read them sequentially
+typedef struct {
+    int16_t dx[RGB_MATRIX_LED_COUNT];
+    int16_t dy[RGB_MATRIX_LED_COUNT];
+    uint8_t dist[RGB_MATRIX_LED_COUNT];
+} led_geometry_t;
+#endif // RGB_MATRIX_LED_GEOMETRY_CACHE
+
 typedef union {
     uint64_t raw;
     struct PACKED {
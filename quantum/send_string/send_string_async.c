@@ -0,0 +1,303 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "send_string_async.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "keycode.h"
+#include "action.h"
+#include "timer.h"
+
+/* Strings are parsed when they are queued. The queue holds characters as-is,
+ * SS_TAP/SS_DOWN/SS_UP as in the source string, delays as a binary 16-bit
+ * value and two internal records for the interval and callbacks. */
+#define SS_ASYNC_INTERVAL_CODE 0x10
+#define SS_ASYNC_CALLBACK_CODE 0x11
+
+#define CALLBACK_RECORD_SIZE (2 + sizeof(send_string_async_callback_t) + sizeof(void *))
+
+// Note: we bit-pack in "reverse" order to optimize loading
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
+static uint8_t  queue[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t queue_head     = 0;
+static uint16_t queue_tail     = 0;
+static uint16_t queue_used     = 0;
+static uint16_t queue_interval = UINT16_MAX; // interval of the last queued string
+
+enum { STEP_REGISTER, STEP_UNREGISTER, STEP_WAIT };
+
+typedef struct {
+    uint8_t  action;
+    uint8_t  keycode;
+    uint16_t wait;
+} send_string_async_step_t;
+
+// The longest expansion is a shifted, AltGr'd dead key: 8 steps
+static send_string_async_step_t steps[8];
+static uint8_t                  step_count = 0;
+static uint8_t                  step_index = 0;
+static uint16_t                 step_wait  = 0;
+static uint16_t                 step_timer = 0;
+static uint8_t                  interval   = 0;
+
+static void queue_push(uint8_t data) {
+    queue[queue_head] = data;
+    queue_head        = (queue_head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    queue_used++;
+}
+
+static uint8_t queue_pop(void) {
+    uint8_t data = queue[queue_tail];
+    queue_tail   = (queue_tail + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    queue_used--;
+    return data;
+}
+
+static void queue_push_block(const void *data, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        queue_push(((const uint8_t *)data)[i]);
+    }
+}
+
+static void queue_pop_block(void *data, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        ((uint8_t *)data)[i] = queue_pop();
+    }
+}
+
+/* Encodes the string into the queue, or only counts the bytes it needs if
+ * write is false. */
+static uint16_t encode(const char *string, uint8_t string_interval, bool progmem, bool write) {
+#define READ(s) ((uint8_t)(progmem ? pgm_read_byte(s) : *(s)))
+    uint16_t size = 0;
+
+    if (string_interval != queue_interval) {
+        if (write) {
+            queue_push(SS_QMK_PREFIX);
+            queue_push(SS_ASYNC_INTERVAL_CODE);
+            queue_push(string_interval);
+            queue_interval = string_interval;
+        }
+        size += 3;
+    }
+
+    uint8_t ascii_code;
+    while ((ascii_code = READ(string))) {
+        if (ascii_code == SS_QMK_PREFIX) {
+            uint8_t code = READ(++string);
+            if (code == SS_TAP_CODE || code == SS_DOWN_CODE || code == SS_UP_CODE) {
+                uint8_t keycode = READ(++string);
+                if (!keycode) break;
+                if (write) {
+                    queue_push(SS_QMK_PREFIX);
+                    queue_push(code);
+                    queue_push(keycode);
+                }
+                size += 3;
+            } else if (code == SS_DELAY_CODE) {
+                uint16_t ms      = 0;
+                uint8_t  keycode = READ(++string);
+                while (isdigit(keycode)) {
+                    ms *= 10;
+                    ms += keycode - '0';
+                    keycode = READ(++string);
+                }
+                if (!keycode) break;
+                if (write) {
+                    queue_push(SS_QMK_PREFIX);
+                    queue_push(SS_DELAY_CODE);
+                    queue_push_block(&ms, sizeof(ms));
+                }
+                size += 4;
+            } else if (!code) {
+                break;
+            }
+        } else if (ascii_code < 0x80) {
+            if (write) {
+                queue_push(ascii_code);
+            }
+            size += 1;
+        }
+        ++string;
+    }
+
+    return size;
+#undef READ
+}
+
+static bool enqueue(const char *string, uint8_t string_interval, bool progmem) {
+    // always leave room for a callback, see send_string_async_callback()
+    if (queue_used + encode(string, string_interval, progmem, false) + CALLBACK_RECORD_SIZE > SEND_STRING_ASYNC_BUFFER_SIZE) {
+        return false;
+    }
+    encode(string, string_interval, progmem, true);
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    return enqueue(string, interval, false);
+}
+
+#if defined(__AVR__)
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    return enqueue(string, interval, true);
+}
+#endif
+
+bool send_string_async_callback(send_string_async_callback_t callback, void *context) {
+    if (queue_used + CALLBACK_RECORD_SIZE > SEND_STRING_ASYNC_BUFFER_SIZE) {
+        return false;
+    }
+    queue_push(SS_QMK_PREFIX);
+    queue_push(SS_ASYNC_CALLBACK_CODE);
+    queue_push_block(&callback, sizeof(callback));
+    queue_push_block(&context, sizeof(context));
+    return true;
+}
+
+bool send_string_async_is_busy(void) {
+    return queue_used || step_index < step_count || step_wait;
+}
+
+static void add_step(uint8_t action, uint8_t keycode, uint16_t wait) {
+    steps[step_count++] = (send_string_async_step_t){.action = action, .keycode = keycode, .wait = wait};
+}
+
+static void add_tap(uint8_t keycode, uint16_t delay) {
+    add_step(STEP_REGISTER, keycode, delay);
+    add_step(STEP_UNREGISTER, keycode, interval);
+}
+
+/* Same sequence as send_char_with_delay(). */
+static void add_char(uint8_t ascii_code) {
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        send_char_with_delay(ascii_code, 0);
+        return;
+    }
+#endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, ascii_code);
+
+    if (is_shifted) {
+        add_step(STEP_REGISTER, KC_LEFT_SHIFT, interval);
+    }
+    if (is_altgred) {
+        add_step(STEP_REGISTER, KC_RIGHT_ALT, interval);
+    }
+    add_tap(keycode, interval);
+    if (is_altgred) {
+        add_step(STEP_UNREGISTER, KC_RIGHT_ALT, interval);
+    }
+    if (is_shifted) {
+        add_step(STEP_UNREGISTER, KC_LEFT_SHIFT, interval);
+    }
+    if (is_dead) {
+        add_tap(KC_SPACE, TAP_CODE_DELAY);
+    }
+}
+
+/* Pops one record off the queue, expanding keystrokes into steps. */
+static void load_next(void) {
+    step_count = step_index = 0;
+
+    uint8_t ascii_code = queue_pop();
+    if (ascii_code != SS_QMK_PREFIX) {
+        add_char(ascii_code);
+        return;
+    }
+
+    uint8_t code = queue_pop();
+    switch (code) {
+        case SS_TAP_CODE: {
+            uint8_t keycode = queue_pop();
+            add_tap(keycode, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+            break;
+        }
+        case SS_DOWN_CODE:
+            add_step(STEP_REGISTER, queue_pop(), interval);
+            break;
+        case SS_UP_CODE:
+            add_step(STEP_UNREGISTER, queue_pop(), interval);
+            break;
+        case SS_DELAY_CODE: {
+            uint16_t ms;
+            queue_pop_block(&ms, sizeof(ms));
+            add_step(STEP_WAIT, 0, ms + interval);
+            break;
+        }
+        case SS_ASYNC_INTERVAL_CODE:
+            interval = queue_pop();
+            break;
+        case SS_ASYNC_CALLBACK_CODE: {
+            send_string_async_callback_t callback;
+            void *                       context;
+            queue_pop_block(&callback, sizeof(callback));
+            queue_pop_block(&context, sizeof(context));
+            callback(context);
+            break;
+        }
+    }
+}
+
+static void run_step(const send_string_async_step_t *step) {
+    switch (step->action) {
+        case STEP_REGISTER:
+            register_code(step->keycode);
+            break;
+        case STEP_UNREGISTER:
+            unregister_code(step->keycode);
+            break;
+    }
+}
+
+void send_string_async_clear(void) {
+    // release whatever the current character still holds
+    while (step_index < step_count) {
+        const send_string_async_step_t *step = &steps[step_index++];
+        if (step->action == STEP_UNREGISTER) {
+            run_step(step);
+        }
+    }
+    queue_head = queue_tail = queue_used = 0;
+    queue_interval                       = UINT16_MAX;
+    step_count = step_index = 0;
+    step_wait                            = 0;
+}
+
+void send_string_async_task(void) {
+    if (step_wait) {
+        if (timer_elapsed(step_timer) < step_wait) {
+            return;
+        }
+        step_wait = 0;
+    }
+
+    // at most one character is typed per call when there is no delay
+    while (step_index == step_count) {
+        if (!queue_used) {
+            return;
+        }
+        load_next();
+    }
+
+    while (step_index < step_count) {
+        const send_string_async_step_t *step = &steps[step_index++];
+        run_step(step);
+        if (step->wait) {
+            step_wait  = step->wait;
+            step_timer = timer_read();
+            return;
+        }
+    }
+}
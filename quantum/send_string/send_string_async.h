@@ -0,0 +1,103 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * \file
+ *
+ * \defgroup send_string_async Asynchronous Send String API
+ *
+ * \brief Queue strings to be typed from the main loop instead of blocking until they are typed.
+ *
+ * Strings use the same format as `send_string()`, including the `SS_TAP()`, `SS_DOWN()`, `SS_UP()` and `SS_DELAY()` sequences.
+ * They are copied into a ring buffer and typed one key press or release at a time from `quantum_task()`,
+ * so matrix scanning and everything else in the main loop keep running while the text is emitted.
+ * \{
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "progmem.h"
+#include "send_string.h"
+
+#ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#    define SEND_STRING_ASYNC_BUFFER_SIZE 128
+#endif
+
+typedef void (*send_string_async_callback_t)(void *context);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed.
+ *
+ * This function simply calls `send_string_async_with_delay(string, TAP_CODE_DELAY)`.
+ *
+ * \param string The string to type out.
+ * \return false if the string does not fit in the queue, in which case nothing was queued.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed, with a delay between each character.
+ *
+ * \param string The string to type out. It is copied, so it does not need to outlive the call.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \return false if the string does not fit in the queue, in which case nothing was queued.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+#if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed, with a delay between each character.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \return false if the string does not fit in the queue, in which case nothing was queued.
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+#else
+#    define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#endif
+
+/**
+ * \brief Queue a callback, called once everything queued before it has been typed.
+ *
+ * A failed string enqueue always leaves room for one callback, so a caller can queue a callback to continue once the queue has drained.
+ *
+ * \param callback The function to call.
+ * \param context Passed to the callback.
+ * \return false if the callback does not fit in the queue.
+ */
+bool send_string_async_callback(send_string_async_callback_t callback, void *context);
+
+/**
+ * \brief Whether any queued keystrokes have yet to be typed.
+ */
+bool send_string_async_is_busy(void);
+
+/**
+ * \brief Drop everything queued, without calling queued callbacks.
+ *
+ * Keys pressed by the character currently being typed are released. Keys held by an `SS_DOWN()` whose `SS_UP()` was dropped stay held.
+ */
+void send_string_async_clear(void);
+
+/**
+ * \brief Types the next queued keystrokes once their delay has passed. Called from `quantum_task()`.
+ */
+void send_string_async_task(void);
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), interval).
+ */
+#define SEND_STRING_ASYNC_DELAY(string, interval) send_string_async_with_delay_P(PSTR(string), interval)
+
+/** \} */
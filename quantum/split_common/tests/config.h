@@ -0,0 +1,32 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 10
+#define MATRIX_COLS 12
+
+#ifdef ENCODER_ENABLE
+#    define NUM_ENCODERS_LEFT 1
+#    define NUM_ENCODERS_RIGHT 1
+#endif
+#ifdef RGBLIGHT_ENABLE
+#    define RGBLIGHT_LED_COUNT 10
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    define RGB_MATRIX_LED_COUNT 10
+#    define RGB_MATRIX_SPLIT \
+        { 5, 5 }
+#endif
+
+#ifdef __cplusplus
+// For the feature headers that transport.h pulls in
+#    define _Static_assert static_assert
+extern "C" {
+#endif
+
+#include "split_common/tests/mock.h"
+
+#ifdef __cplusplus
+};
+#endif
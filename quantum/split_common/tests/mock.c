@@ -0,0 +1,283 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "mock.h"
+#include "keyboard.h"
+#include "action_layer.h"
+#include "action_util.h"
+#include "split_util.h"
+
+#ifdef ENCODER_ENABLE
+#    include "encoder.h"
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+#    include "pointing_device.h"
+#endif
+#ifdef RGBLIGHT_ENABLE
+#    include "rgblight.h"
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+#ifdef BACKLIGHT_ENABLE
+#    include "backlight.h"
+#endif
+#ifdef OLED_ENABLE
+#    include "oled_driver.h"
+#endif
+
+mock_split_state_t mock_master_state;
+mock_split_state_t mock_slave_state;
+
+static bool                mock_is_master = true;
+static mock_split_state_t *mock_state     = &mock_master_state;
+
+#ifdef ENCODER_ENABLE
+static encoder_events_t mock_slave_encoder_events;
+#endif
+
+layer_state_t layer_state;
+layer_state_t default_layer_state;
+
+#ifdef RGB_MATRIX_ENABLE
+rgb_config_t rgb_matrix_config;
+#endif
+
+void mock_set_master(bool master) {
+    if (master == mock_is_master) {
+        return;
+    }
+#ifdef RGB_MATRIX_ENABLE
+    mock_state->rgb_matrix_config = rgb_matrix_config.raw;
+#endif
+    // The layer states are globals, keep them with the half they belong to
+    mock_state->layer_state         = layer_state;
+    mock_state->default_layer_state = default_layer_state;
+    mock_is_master                  = master;
+    mock_state                      = master ? &mock_master_state : &mock_slave_state;
+    layer_state                     = mock_state->layer_state;
+    default_layer_state             = mock_state->default_layer_state;
+#ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_config.raw = mock_state->rgb_matrix_config;
+#endif
+}
+
+void mock_reset(void) {
+    mock_set_master(true);
+    memset(&mock_master_state, 0, sizeof(mock_master_state));
+    memset(&mock_slave_state, 0, sizeof(mock_slave_state));
+    layer_state         = 0;
+    default_layer_state = 0;
+#ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_config.raw = 0;
+#endif
+#ifdef ENCODER_ENABLE
+    memset(&mock_slave_encoder_events, 0, sizeof(mock_slave_encoder_events));
+#endif
+}
+
+bool is_keyboard_master(void) {
+    return mock_is_master;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+uint8_t get_mods(void) {
+    return mock_state->real_mods;
+}
+
+void set_mods(uint8_t mods) {
+    mock_state->real_mods = mods;
+}
+
+uint8_t get_weak_mods(void) {
+    return mock_state->weak_mods;
+}
+
+void set_weak_mods(uint8_t mods) {
+    mock_state->weak_mods = mods;
+}
+
+uint8_t get_oneshot_mods(void) {
+    return mock_state->oneshot_mods;
+}
+
+void set_oneshot_mods(uint8_t mods) {
+    mock_state->oneshot_mods = mods;
+}
+
+uint8_t host_keyboard_leds(void) {
+    return mock_state->led_state;
+}
+
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    mock_state->led_state = led_state;
+}
+
+uint8_t get_current_wpm(void) {
+    return mock_state->wpm;
+}
+
+void set_current_wpm(uint8_t wpm) {
+    mock_state->wpm = wpm;
+}
+
+#ifdef ENCODER_ENABLE
+bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
+    if (events->tail == (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS) {
+        return false;
+    }
+    events->queue[events->head] = (encoder_event_t){.index = index, .clockwise = clockwise ? 1 : 0};
+    events->head                = (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    events->enqueued++;
+    return true;
+}
+
+bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise) {
+    if (events->head == events->tail) {
+        return false;
+    }
+    *index       = events->queue[events->tail].index;
+    *clockwise   = events->queue[events->tail].clockwise;
+    events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    events->dequeued++;
+    return true;
+}
+
+void mock_encoder_turn(uint8_t index, bool clockwise) {
+    encoder_queue_event_advanced(&mock_slave_encoder_events, index, clockwise);
+}
+
+bool encoder_queue_event(uint8_t index, bool clockwise) {
+    // Only the master gets events from the transport, its encoder task handles them straight away
+    mock_state->encoder_turns += clockwise ? 1 : -1;
+    return true;
+}
+
+void encoder_retrieve_events(encoder_events_t *events) {
+    memcpy(events, &mock_slave_encoder_events, sizeof(mock_slave_encoder_events));
+}
+
+void encoder_signal_queue_drain(void) {
+    mock_slave_encoder_events.tail     = mock_slave_encoder_events.head;
+    mock_slave_encoder_events.dequeued = mock_slave_encoder_events.enqueued;
+}
+#endif // ENCODER_ENABLE
+
+#ifdef POINTING_DEVICE_ENABLE
+void pointing_device_set_shared_report(report_mouse_t report) {
+    mock_state->pointing_x = report.x;
+}
+
+uint16_t pointing_device_get_shared_cpi(void) {
+    return mock_state->pointing_cpi;
+}
+
+static report_mouse_t mock_pointing_get_report(report_mouse_t mouse_report) {
+    mouse_report.x = mock_state->pointing_x;
+    return mouse_report;
+}
+
+static uint16_t mock_pointing_get_cpi(void) {
+    return mock_state->pointing_cpi;
+}
+
+static void mock_pointing_set_cpi(uint16_t cpi) {
+    mock_state->pointing_cpi = cpi;
+}
+
+const pointing_device_driver_t pointing_device_driver = {
+    .get_report = mock_pointing_get_report,
+    .get_cpi    = mock_pointing_get_cpi,
+    .set_cpi    = mock_pointing_set_cpi,
+};
+#endif // POINTING_DEVICE_ENABLE
+
+#ifdef RGBLIGHT_ENABLE
+void rgblight_get_syncinfo(rgblight_syncinfo_t *syncinfo) {
+    memset(syncinfo, 0, sizeof(*syncinfo));
+    syncinfo->config.raw          = mock_state->rgblight_config;
+    syncinfo->status.change_flags = mock_state->rgblight_change_flags;
+}
+
+void rgblight_clear_change_flags(void) {
+    mock_state->rgblight_change_flags = 0;
+}
+
+void rgblight_update_sync(rgblight_syncinfo_t *syncinfo, bool write_to_eeprom) {
+    mock_state->rgblight_config = syncinfo->config.raw;
+}
+#endif // RGBLIGHT_ENABLE
+
+#ifdef RGB_MATRIX_ENABLE
+bool rgb_matrix_get_suspend_state(void) {
+    return mock_state->rgb_matrix_suspended;
+}
+
+void rgb_matrix_set_suspend_state(bool state) {
+    mock_state->rgb_matrix_suspended = state;
+}
+#endif // RGB_MATRIX_ENABLE
+
+#ifdef BACKLIGHT_ENABLE
+bool is_backlight_enabled(void) {
+    return mock_state->backlight_level != 0;
+}
+
+uint8_t get_backlight_level(void) {
+    return mock_state->backlight_level;
+}
+
+void backlight_level_noeeprom(uint8_t level) {
+    mock_state->backlight_level = level;
+}
+#endif // BACKLIGHT_ENABLE
+
+#ifdef OLED_ENABLE
+bool is_oled_on(void) {
+    return mock_state->oled_on;
+}
+
+bool oled_on(void) {
+    return mock_state->oled_on = true;
+}
+
+bool oled_off(void) {
+    mock_state->oled_on = false;
+    return true;
+}
+#endif // OLED_ENABLE
+
+#ifdef SPLIT_ACTIVITY_ENABLE
+uint32_t last_matrix_activity_time(void) {
+    return mock_state->matrix_activity;
+}
+
+uint32_t last_encoder_activity_time(void) {
+    return mock_state->encoder_activity;
+}
+
+uint32_t last_pointing_device_activity_time(void) {
+    return mock_state->pointing_activity;
+}
+
+void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timestamp, uint32_t pointing_device_timestamp) {
+    mock_state->matrix_activity   = matrix_timestamp;
+    mock_state->encoder_activity  = encoder_timestamp;
+    mock_state->pointing_activity = pointing_device_timestamp;
+}
+#endif // SPLIT_ACTIVITY_ENABLE
+
+#ifdef SPLIT_WATCHDOG_ENABLE
+void split_watchdog_update(bool done) {
+    mock_state->watchdog_done = done;
+}
+
+bool split_watchdog_check(void) {
+    return mock_state->watchdog_done;
+}
+#endif // SPLIT_WATCHDOG_ENABLE
@@ -0,0 +1,46 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** \brief State that both halves have their own copy of, synced from master to slave by the transport
+ */
+typedef struct {
+    uint32_t layer_state;
+    uint32_t default_layer_state;
+    uint8_t  real_mods;
+    uint8_t  weak_mods;
+    uint8_t  oneshot_mods;
+    uint8_t  led_state;
+    uint8_t  wpm;
+    uint8_t  backlight_level;
+    uint64_t rgblight_config;
+    uint8_t  rgblight_change_flags;
+    uint64_t rgb_matrix_config;
+    bool     rgb_matrix_suspended;
+    bool     oled_on;
+    int8_t   encoder_turns;   // master: net clockwise turns received from the slave
+    int16_t  pointing_x;      // slave: motion reported by its sensor, master: motion received from the slave
+    uint16_t pointing_cpi;    // master: the CPI to set on the slave, slave: the CPI of its sensor
+    uint32_t matrix_activity; // activity timestamps, synced from master to slave
+    uint32_t encoder_activity;
+    uint32_t pointing_activity;
+    bool     watchdog_done;
+} mock_split_state_t;
+
+extern mock_split_state_t mock_master_state;
+extern mock_split_state_t mock_slave_state;
+
+/** \brief Selects which half subsequent calls act as, mock_master_state and mock_slave_state are only up to date while
+ * the master is selected
+ */
+void mock_set_master(bool master);
+
+void mock_reset(void);
+
+/** \brief Turns one of the slave's encoders, the event waits in the slave's queue until the master picks it up
+ */
+void mock_encoder_turn(uint8_t index, bool clockwise);
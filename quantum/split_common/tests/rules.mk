@@ -0,0 +1,142 @@
+split_transport_common_DEFS := -DSPLIT_KEYBOARD
+split_transport_common_INC := $(QUANTUM_PATH)/split_common $(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers
+split_transport_common_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_tests.cpp \
+	$(QUANTUM_PATH)/split_common/tests/mock.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/serial_link.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+split_transport_sync_DEFS := \
+	-DSPLIT_TRANSPORT_MIRROR \
+	-DSPLIT_LAYER_STATE_ENABLE \
+	-DSPLIT_LED_STATE_ENABLE \
+	-DSPLIT_MODS_ENABLE \
+	-DWPM_ENABLE \
+	-DSPLIT_WPM_ENABLE
+
+split_transport_DEFS := $(split_transport_common_DEFS)
+split_transport_INC := $(split_transport_common_INC)
+split_transport_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_SRC := $(split_transport_common_SRC)
+
+split_transport_sync_all_DEFS := $(split_transport_common_DEFS) $(split_transport_sync_DEFS)
+split_transport_sync_all_INC := $(split_transport_common_INC)
+split_transport_sync_all_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_sync_all_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_DEFS := $(split_transport_common_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_INC := $(split_transport_common_INC)
+split_transport_batched_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_sync_all_DEFS := $(split_transport_common_DEFS) $(split_transport_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_sync_all_INC := $(split_transport_common_INC)
+split_transport_batched_sync_all_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_sync_all_SRC := $(split_transport_common_SRC)
+
+split_transport_encoders_sync_DEFS := -DENCODER_ENABLE
+
+split_transport_encoders_DEFS := $(split_transport_common_DEFS) $(split_transport_encoders_sync_DEFS)
+split_transport_encoders_INC := $(split_transport_common_INC)
+split_transport_encoders_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_encoders_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_encoders_DEFS := $(split_transport_common_DEFS) $(split_transport_encoders_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_encoders_INC := $(split_transport_common_INC)
+split_transport_batched_encoders_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_encoders_SRC := $(split_transport_common_SRC)
+
+split_transport_pointing_sync_DEFS := \
+	-DPOINTING_DEVICE_ENABLE \
+	-DSPLIT_POINTING_ENABLE
+
+split_transport_pointing_DEFS := $(split_transport_common_DEFS) $(split_transport_pointing_sync_DEFS)
+split_transport_pointing_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/pointing_device
+split_transport_pointing_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_pointing_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_pointing_DEFS := $(split_transport_common_DEFS) $(split_transport_pointing_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_pointing_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/pointing_device
+split_transport_batched_pointing_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_pointing_SRC := $(split_transport_common_SRC)
+
+split_transport_rgblight_sync_DEFS := \
+	-DRGBLIGHT_ENABLE \
+	-DRGBLIGHT_SPLIT \
+	-DEEPROM_TEST_HARNESS
+
+split_transport_rgblight_DEFS := $(split_transport_common_DEFS) $(split_transport_rgblight_sync_DEFS)
+split_transport_rgblight_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/rgblight
+split_transport_rgblight_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_rgblight_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_rgblight_DEFS := $(split_transport_common_DEFS) $(split_transport_rgblight_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_rgblight_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/rgblight
+split_transport_batched_rgblight_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_rgblight_SRC := $(split_transport_common_SRC)
+
+split_transport_rgb_matrix_sync_DEFS := -DRGB_MATRIX_ENABLE
+
+split_transport_rgb_matrix_DEFS := $(split_transport_common_DEFS) $(split_transport_rgb_matrix_sync_DEFS)
+split_transport_rgb_matrix_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/rgb_matrix $(QUANTUM_PATH)/rgb_matrix/animations
+split_transport_rgb_matrix_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_rgb_matrix_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_rgb_matrix_DEFS := $(split_transport_common_DEFS) $(split_transport_rgb_matrix_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_rgb_matrix_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/rgb_matrix $(QUANTUM_PATH)/rgb_matrix/animations
+split_transport_batched_rgb_matrix_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_rgb_matrix_SRC := $(split_transport_common_SRC)
+
+split_transport_backlight_sync_DEFS := -DBACKLIGHT_ENABLE
+
+split_transport_backlight_DEFS := $(split_transport_common_DEFS) $(split_transport_backlight_sync_DEFS)
+split_transport_backlight_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/backlight
+split_transport_backlight_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_backlight_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_backlight_DEFS := $(split_transport_common_DEFS) $(split_transport_backlight_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_backlight_INC := $(split_transport_common_INC) $(QUANTUM_PATH)/backlight
+split_transport_batched_backlight_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_backlight_SRC := $(split_transport_common_SRC)
+
+split_transport_oled_sync_DEFS := \
+	-DOLED_ENABLE \
+	-DSPLIT_OLED_ENABLE
+
+split_transport_oled_DEFS := $(split_transport_common_DEFS) $(split_transport_oled_sync_DEFS)
+split_transport_oled_INC := $(split_transport_common_INC) $(DRIVER_PATH)/oled
+split_transport_oled_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_oled_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_oled_DEFS := $(split_transport_common_DEFS) $(split_transport_oled_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_oled_INC := $(split_transport_common_INC) $(DRIVER_PATH)/oled
+split_transport_batched_oled_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_oled_SRC := $(split_transport_common_SRC)
+
+split_transport_activity_sync_DEFS := -DSPLIT_ACTIVITY_ENABLE
+
+split_transport_activity_DEFS := $(split_transport_common_DEFS) $(split_transport_activity_sync_DEFS)
+split_transport_activity_INC := $(split_transport_common_INC)
+split_transport_activity_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_activity_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_activity_DEFS := $(split_transport_common_DEFS) $(split_transport_activity_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_activity_INC := $(split_transport_common_INC)
+split_transport_batched_activity_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_activity_SRC := $(split_transport_common_SRC)
+
+split_transport_watchdog_sync_DEFS := -DSPLIT_WATCHDOG_ENABLE
+
+split_transport_watchdog_DEFS := $(split_transport_common_DEFS) $(split_transport_watchdog_sync_DEFS)
+split_transport_watchdog_INC := $(split_transport_common_INC)
+split_transport_watchdog_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_watchdog_SRC := $(split_transport_common_SRC)
+
+split_transport_batched_watchdog_DEFS := $(split_transport_common_DEFS) $(split_transport_watchdog_sync_DEFS) -DSPLIT_TRANSPORT_BATCHED
+split_transport_batched_watchdog_INC := $(split_transport_common_INC)
+split_transport_batched_watchdog_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+split_transport_batched_watchdog_SRC := $(split_transport_common_SRC)
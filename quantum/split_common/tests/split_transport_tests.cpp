@@ -0,0 +1,538 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Runs the master and slave halves of the split transport against each other over the in-memory serial link. The
+// same tests are built for several combinations of sync options, see rules.mk.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transport.h"
+#include "transactions.h"
+#include "serial_link.h"
+#include "timer.h"
+
+void timer_clear(void);
+void advance_time(uint32_t ms);
+}
+
+#define ROWS_PER_HAND ((MATRIX_ROWS) / 2)
+
+#ifndef FORCED_SYNC_THROTTLE_MS
+#    define FORCED_SYNC_THROTTLE_MS 100
+#endif
+
+// Features the master polls on the slave cost a checksum read on every scan
+#if defined(ENCODER_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    define POLLED_FEATURES 2
+#elif defined(ENCODER_ENABLE) || defined(SPLIT_POINTING_ENABLE)
+#    define POLLED_FEATURES 1
+#else
+#    define POLLED_FEATURES 0
+#endif
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+// Time the transactions seen so far would have taken without batching, apart from the matrix checksum the unbatched
+// transport polls on every scan
+static uint64_t unbatched_us;
+
+static void count_unbatched(int sstd_index, uint32_t duration_us) {
+    if (sstd_index == GET_SLAVE_MATRIX_CHECKSUM) {
+        return;
+    }
+    if (sstd_index != PUT_BATCH && sstd_index != PUT_BATCH_SHORT) {
+        unbatched_us += duration_us;
+        return;
+    }
+
+    // Each queued write on its own, then the matrix if it changed and the checksums of the polled features
+    const split_batch_m2s_t *request  = &split_shmem->batch_m2s;
+    const split_batch_s2m_t *response = &split_shmem->batch_s2m;
+    for (uint8_t i = 0; i < request->length;) {
+        int id = request->data[i++];
+        unbatched_us += serial_link_transaction_us(id);
+        i += split_transaction_table[id].initiator2target_buffer_size;
+    }
+    // A full matrix is read with GET_SLAVE_MATRIX_DATA, which is counted on its own
+    for (size_t i = 0; !(response->flags & SPLIT_BATCH_FLAG_MATRIX_FULL) && i < sizeof(response->changed_rows); i++) {
+        if (response->changed_rows[i]) {
+            unbatched_us += serial_link_transaction_us(GET_SLAVE_MATRIX_DATA);
+            break;
+        }
+    }
+#    ifdef ENCODER_ENABLE
+    unbatched_us += serial_link_transaction_us(GET_ENCODERS_CHECKSUM);
+#    endif
+#    ifdef SPLIT_POINTING_ENABLE
+    unbatched_us += serial_link_transaction_us(GET_POINTING_CHECKSUM);
+#    endif
+}
+#endif // SPLIT_TRANSPORT_BATCHED
+
+class SplitTransport : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        timer_clear();
+        mock_reset();
+        serial_link_reset();
+        memset(master_local, 0, sizeof(master_local));
+        memset(master_view, 0, sizeof(master_view));
+        memset(slave_local, 0, sizeof(slave_local));
+        memset(slave_mirror, 0, sizeof(slave_mirror));
+
+        transport_master_init();
+        transport_slave_init();
+        // Let both halves settle, whatever the transport remembers from previous tests
+        for (int i = 0; i < 3; i++) {
+#ifdef SPLIT_POINTING_ENABLE
+            // The slave reads its sensor at most once per POINTING_DEVICE_TASK_THROTTLE_MS
+            advance_time(POINTING_DEVICE_TASK_THROTTLE_MS);
+#endif
+            scan();
+        }
+        ASSERT_TRUE(scan());
+    }
+
+    void run_slave() {
+        mock_set_master(false);
+        serial_link_enter_slave();
+        transport_slave(slave_mirror, slave_local);
+        serial_link_exit_slave();
+        mock_set_master(true);
+    }
+
+    bool run_master() {
+        return transport_master(master_local, master_view);
+    }
+
+    bool scan() {
+        run_slave();
+        return run_master();
+    }
+
+    uint32_t transactions() {
+        serial_link_stats_t stats;
+        serial_link_get_stats(&stats);
+        return stats.transactions;
+    }
+
+    bool views_match() {
+        return memcmp(master_view, slave_local, sizeof(slave_local)) == 0;
+    }
+
+    void benchmark(uint32_t bitrate, uint32_t latency_us);
+    bool run_master_benchmarked();
+
+    static std::string features() {
+        std::string name = "matrix";
+#ifdef SPLIT_TRANSPORT_MIRROR
+        name += ", mirror";
+#endif
+#ifdef SPLIT_LAYER_STATE_ENABLE
+        name += ", layers";
+#endif
+#ifdef SPLIT_LED_STATE_ENABLE
+        name += ", leds";
+#endif
+#ifdef SPLIT_MODS_ENABLE
+        name += ", mods";
+#endif
+#ifdef SPLIT_WPM_ENABLE
+        name += ", wpm";
+#endif
+#ifdef ENCODER_ENABLE
+        name += ", encoders";
+#endif
+#ifdef SPLIT_POINTING_ENABLE
+        name += ", pointing";
+#endif
+#ifdef RGBLIGHT_SPLIT
+        name += ", rgblight";
+#endif
+#ifdef RGB_MATRIX_SPLIT
+        name += ", rgb matrix";
+#endif
+#ifdef BACKLIGHT_ENABLE
+        name += ", backlight";
+#endif
+#ifdef SPLIT_OLED_ENABLE
+        name += ", oled";
+#endif
+#ifdef SPLIT_ACTIVITY_ENABLE
+        name += ", activity";
+#endif
+#ifdef SPLIT_WATCHDOG_ENABLE
+        name += ", watchdog";
+#endif
+#ifdef SPLIT_TRANSPORT_BATCHED
+        name += " (batched)";
+#endif
+        return name;
+    }
+
+    matrix_row_t master_local[ROWS_PER_HAND]; // master half, as scanned by the master
+    matrix_row_t master_view[ROWS_PER_HAND];  // slave half, as received by the master
+    matrix_row_t slave_local[ROWS_PER_HAND];  // slave half, as scanned by the slave
+    matrix_row_t slave_mirror[ROWS_PER_HAND]; // master half, as received by the slave
+};
+
+TEST_F(SplitTransport, SlaveMatrixReachesMaster) {
+    slave_local[1] = 0x0005;
+    ASSERT_TRUE(scan());
+    EXPECT_TRUE(views_match());
+
+    slave_local[1] = 0;
+    ASSERT_TRUE(scan());
+    EXPECT_TRUE(views_match());
+}
+
+TEST_F(SplitTransport, ManyRowsChangeAtOnce) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        slave_local[row] = 1 << row;
+    }
+    ASSERT_TRUE(scan());
+    EXPECT_TRUE(views_match());
+
+    slave_local[0] = 0;
+    slave_local[ROWS_PER_HAND - 1] = 0;
+    ASSERT_TRUE(scan());
+    EXPECT_TRUE(views_match());
+}
+
+TEST_F(SplitTransport, IdleScanIsOneTransaction) {
+    uint32_t before = transactions();
+    ASSERT_TRUE(scan());
+    EXPECT_EQ(transactions() - before, 1 + POLLED_FEATURES);
+}
+
+TEST_F(SplitTransport, KeypressTransactions) {
+    slave_local[2] = 0x0800;
+#ifdef SPLIT_MODS_ENABLE
+    mock_master_state.real_mods = 0x02;
+#endif
+    uint32_t before = transactions();
+    ASSERT_TRUE(scan());
+    EXPECT_TRUE(views_match());
+#if defined(SPLIT_TRANSPORT_BATCHED) && defined(SPLIT_MODS_ENABLE)
+    // Checksum, then the exchange that sends the mods and brings back the matrix
+    EXPECT_EQ(transactions() - before, 2);
+#elif defined(SPLIT_MODS_ENABLE)
+    EXPECT_EQ(transactions() - before, 3 + POLLED_FEATURES);
+#else
+    // Checksum, then the matrix itself, batched or not as there is nothing to send
+    EXPECT_EQ(transactions() - before, 2 + POLLED_FEATURES);
+#endif
+}
+
+#ifdef SPLIT_TRANSPORT_MIRROR
+TEST_F(SplitTransport, MasterMatrixIsMirrored) {
+    master_local[3] = 0x0100;
+    ASSERT_TRUE(scan());
+    run_slave();
+    EXPECT_EQ(memcmp(slave_mirror, master_local, sizeof(master_local)), 0);
+}
+#endif
+
+#if defined(SPLIT_LAYER_STATE_ENABLE) && defined(SPLIT_LED_STATE_ENABLE) && defined(SPLIT_MODS_ENABLE) && defined(SPLIT_WPM_ENABLE)
+TEST_F(SplitTransport, MasterStateReachesSlave) {
+    layer_state                    = 0x06;
+    default_layer_state            = 0x01;
+    mock_master_state.real_mods    = 0x02;
+    mock_master_state.weak_mods    = 0x04;
+    mock_master_state.oneshot_mods = 0x10;
+    mock_master_state.led_state    = 0x02;
+    mock_master_state.wpm          = 42;
+    ASSERT_TRUE(scan());
+    run_slave();
+
+    EXPECT_EQ(mock_slave_state.layer_state, 0x06);
+    EXPECT_EQ(mock_slave_state.default_layer_state, 0x01);
+    EXPECT_EQ(mock_slave_state.real_mods, 0x02);
+    EXPECT_EQ(mock_slave_state.weak_mods, 0x04);
+    EXPECT_EQ(mock_slave_state.oneshot_mods, 0x10);
+    EXPECT_EQ(mock_slave_state.led_state, 0x02);
+    EXPECT_EQ(mock_slave_state.wpm, 42);
+}
+#endif
+
+#ifdef ENCODER_ENABLE
+TEST_F(SplitTransport, EncoderTurnsReachMaster) {
+    mock_encoder_turn(0, true);
+    mock_encoder_turn(0, true);
+    mock_encoder_turn(0, false);
+    ASSERT_TRUE(scan());
+    EXPECT_EQ(mock_master_state.encoder_turns, 1);
+
+    // Once drained, the same events are not delivered twice
+    ASSERT_TRUE(scan());
+    EXPECT_EQ(mock_master_state.encoder_turns, 1);
+}
+#endif
+
+#ifdef SPLIT_POINTING_ENABLE
+TEST_F(SplitTransport, PointingReachesMaster) {
+    mock_slave_state.pointing_x    = 12;
+    mock_master_state.pointing_cpi = 800;
+    advance_time(POINTING_DEVICE_TASK_THROTTLE_MS);
+    ASSERT_TRUE(scan());
+    EXPECT_EQ(mock_master_state.pointing_x, 12);
+
+    advance_time(POINTING_DEVICE_TASK_THROTTLE_MS);
+    run_slave();
+    EXPECT_EQ(mock_slave_state.pointing_cpi, 800);
+}
+#endif
+
+#ifdef RGBLIGHT_SPLIT
+TEST_F(SplitTransport, RgblightReachesSlave) {
+    mock_master_state.rgblight_config       = 0x123456;
+    mock_master_state.rgblight_change_flags = 0x01;
+    ASSERT_TRUE(scan());
+    EXPECT_EQ(mock_master_state.rgblight_change_flags, 0);
+    run_slave();
+    EXPECT_EQ(mock_slave_state.rgblight_config, 0x123456);
+}
+#endif
+
+#ifdef RGB_MATRIX_SPLIT
+TEST_F(SplitTransport, RgbMatrixReachesSlave) {
+    rgb_matrix_config.mode                 = 7;
+    mock_master_state.rgb_matrix_suspended = true;
+    ASSERT_TRUE(scan());
+    run_slave();
+    mock_set_master(false);
+    EXPECT_EQ(rgb_matrix_config.mode, 7);
+    mock_set_master(true);
+    EXPECT_TRUE(mock_slave_state.rgb_matrix_suspended);
+}
+#endif
+
+#ifdef BACKLIGHT_ENABLE
+TEST_F(SplitTransport, BacklightReachesSlave) {
+    mock_master_state.backlight_level = 3;
+    ASSERT_TRUE(scan());
+    run_slave();
+    EXPECT_EQ(mock_slave_state.backlight_level, 3);
+}
+#endif
+
+#ifdef SPLIT_OLED_ENABLE
+TEST_F(SplitTransport, OledStateReachesSlave) {
+    mock_master_state.oled_on = true;
+    ASSERT_TRUE(scan());
+    run_slave();
+    EXPECT_TRUE(mock_slave_state.oled_on);
+
+    mock_master_state.oled_on = false;
+    ASSERT_TRUE(scan());
+    run_slave();
+    EXPECT_FALSE(mock_slave_state.oled_on);
+}
+#endif
+
+#ifdef SPLIT_ACTIVITY_ENABLE
+TEST_F(SplitTransport, ActivityReachesSlave) {
+    mock_master_state.matrix_activity   = 1000;
+    mock_master_state.encoder_activity  = 2000;
+    mock_master_state.pointing_activity = 3000;
+    ASSERT_TRUE(scan());
+    run_slave();
+    EXPECT_EQ(mock_slave_state.matrix_activity, 1000);
+    EXPECT_EQ(mock_slave_state.encoder_activity, 2000);
+    EXPECT_EQ(mock_slave_state.pointing_activity, 3000);
+}
+#endif
+
+#ifdef SPLIT_WATCHDOG_ENABLE
+TEST_F(SplitTransport, WatchdogIsPinged) {
+    // Settling in SetUp() already got the ping through
+    EXPECT_TRUE(mock_master_state.watchdog_done);
+    EXPECT_TRUE(mock_slave_state.watchdog_done);
+}
+#endif
+
+TEST_F(SplitTransport, Disconnected) {
+    serial_link_set_connected(false);
+    slave_local[4] = 0x0010;
+    EXPECT_FALSE(scan());
+    EXPECT_FALSE(views_match());
+
+    serial_link_set_connected(true);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(views_match());
+}
+
+#if defined(SPLIT_TRANSPORT_BATCHED) && defined(SPLIT_LAYER_STATE_ENABLE) && defined(SPLIT_MODS_ENABLE)
+TEST_F(SplitTransport, QueuedWritesAreResentAfterFailedExchange) {
+    serial_link_set_connected(false);
+    layer_state                 = 0x04;
+    mock_master_state.real_mods = 0x01;
+    EXPECT_FALSE(scan());
+
+    // Without waiting for the forced sync
+    serial_link_set_connected(true);
+    ASSERT_TRUE(scan());
+    run_slave();
+    EXPECT_EQ(mock_slave_state.layer_state, 0x04);
+    EXPECT_EQ(mock_slave_state.real_mods, 0x01);
+}
+#endif
+
+TEST_F(SplitTransport, RecoversFromBitErrors) {
+    serial_link_config_t config = {};
+    config.bitrate              = 1000000;
+    config.bit_error_rate       = 2000;
+    config.seed                 = 42;
+    serial_link_configure(&config);
+
+    // Corrupted transfers are retried, but must never hand the master a matrix the slave did not have
+    uint32_t wrong_views = 0;
+    for (int i = 0; i < 2000; i++) {
+        if (i % 7 == 0) {
+            slave_local[i % ROWS_PER_HAND] ^= 1 << (i % MATRIX_COLS);
+        }
+#ifdef SPLIT_MODS_ENABLE
+        mock_master_state.real_mods = i / 50;
+#endif
+        if (scan() && !views_match()) {
+            wrong_views++;
+        }
+    }
+    serial_link_stats_t stats;
+    serial_link_get_stats(&stats);
+    EXPECT_GT(stats.bit_errors, 0);
+    EXPECT_EQ(wrong_views, 0);
+
+    // Once the errors stop, both halves agree again -- at the latest after a forced sync
+    config.bit_error_rate = 0;
+    serial_link_configure(&config);
+    ASSERT_TRUE(scan());
+    EXPECT_TRUE(views_match());
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    ASSERT_TRUE(scan());
+    run_slave();
+#ifdef SPLIT_MODS_ENABLE
+    EXPECT_EQ(mock_slave_state.real_mods, mock_master_state.real_mods);
+#endif
+}
+
+bool SplitTransport::run_master_benchmarked() {
+    serial_link_stats_t before, after;
+    serial_link_get_stats(&before);
+#ifdef SPLIT_TRANSPORT_BATCHED
+    uint64_t unbatched_before = unbatched_us;
+#endif
+    bool okay = run_master();
+    serial_link_get_stats(&after);
+#ifdef SPLIT_TRANSPORT_BATCHED
+    // Batching must not make any scan take longer than it would unbatched, which always polls the matrix checksum
+    unbatched_us += serial_link_transaction_us(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_LE(after.elapsed_us - before.elapsed_us, unbatched_us - unbatched_before);
+#endif
+    return okay;
+}
+
+void SplitTransport::benchmark(uint32_t bitrate, uint32_t latency_us) {
+    // Two halves that each take a while to scan their matrix, and some idle scans in between keypresses
+    const uint32_t       scan_us    = 250;
+    const int            keypresses = 500;
+    serial_link_config_t config     = {};
+    config.bitrate                  = bitrate;
+    config.latency_us               = latency_us;
+    serial_link_configure(&config);
+#ifdef SPLIT_TRANSPORT_BATCHED
+    serial_link_set_observer(count_unbatched);
+#endif
+
+    uint64_t start_us           = serial_link_now_us();
+    uint32_t start_transactions = transactions();
+    uint64_t total_latency_us   = 0;
+    uint64_t max_latency_us     = 0;
+    uint32_t scans              = 0;
+    int      delivered          = 0;
+
+    for (int i = 0; i < keypresses; i++) {
+        for (int idle = 0; idle < i % 4; idle++) {
+            serial_link_advance_us(scan_us);
+            run_slave();
+            serial_link_advance_us(scan_us);
+            ASSERT_TRUE(run_master_benchmarked());
+            scans++;
+        }
+
+        slave_local[(i * 3) % ROWS_PER_HAND] ^= 1 << ((i * 5) % MATRIX_COLS);
+#ifdef SPLIT_MODS_ENABLE
+        mock_master_state.real_mods = (i % 3) ? 0 : 0x02;
+#endif
+#ifdef SPLIT_WPM_ENABLE
+        mock_master_state.wpm = i / 10;
+#endif
+#ifdef ENCODER_ENABLE
+        if (i % 4 == 0) {
+            mock_encoder_turn(0, i % 8 == 0);
+        }
+#endif
+#ifdef SPLIT_POINTING_ENABLE
+        mock_slave_state.pointing_x = i % 5;
+#endif
+#ifdef RGBLIGHT_SPLIT
+        if (i % 20 == 0) {
+            mock_master_state.rgblight_config       = i;
+            mock_master_state.rgblight_change_flags = 0x01;
+        }
+#endif
+#ifdef RGB_MATRIX_SPLIT
+        rgb_matrix_config.mode = i / 20;
+#endif
+#ifdef BACKLIGHT_ENABLE
+        mock_master_state.backlight_level = (i / 20) % 4;
+#endif
+#ifdef SPLIT_OLED_ENABLE
+        mock_master_state.oled_on = (i / 50) % 2;
+#endif
+#ifdef SPLIT_ACTIVITY_ENABLE
+        mock_master_state.matrix_activity = timer_read32();
+#endif
+        serial_link_advance_us(scan_us);
+        run_slave();
+        uint64_t pressed_us = serial_link_now_us();
+        for (int attempt = 0; attempt < 10; attempt++) {
+            serial_link_advance_us(scan_us);
+            ASSERT_TRUE(run_master_benchmarked());
+            scans++;
+            if (views_match()) {
+                uint64_t latency_us = serial_link_now_us() - pressed_us;
+                total_latency_us += latency_us;
+                max_latency_us = latency_us > max_latency_us ? latency_us : max_latency_us;
+                delivered++;
+                break;
+            }
+            serial_link_advance_us(scan_us);
+            run_slave();
+        }
+    }
+    ASSERT_EQ(delivered, keypresses);
+
+    uint64_t elapsed_us  = serial_link_now_us() - start_us;
+    uint32_t performed   = transactions() - start_transactions;
+    uint32_t latency_avg = total_latency_us / delivered;
+    uint32_t per_second  = (uint64_t)performed * 1000000 / elapsed_us;
+    printf("[ BENCHMARK] %s over %lu bps, %lu us turnaround: keypress latency avg %lu us, max %lu us; %lu transactions/s, %.2f transactions/scan\n", features().c_str(), (unsigned long)bitrate, (unsigned long)latency_us, (unsigned long)latency_avg, (unsigned long)max_latency_us, (unsigned long)per_second, (double)performed / scans);
+    RecordProperty("latency_avg_us", latency_avg);
+    RecordProperty("latency_max_us", (int)max_latency_us);
+    RecordProperty("transactions_per_second", per_second);
+}
+
+TEST_F(SplitTransport, BenchmarkSoftSerial) {
+    // Default speed of the AVR soft serial driver
+    benchmark(137000, 20);
+}
+
+TEST_F(SplitTransport, BenchmarkUsartHalfDuplex) {
+    // Default speed of the ChibiOS USART driver, waiting for the other half to turn the line around
+    benchmark(921600, 100);
+}
@@ -0,0 +1,21 @@
+TEST_LIST += \
+	split_transport \
+	split_transport_sync_all \
+	split_transport_batched \
+	split_transport_batched_sync_all \
+	split_transport_encoders \
+	split_transport_batched_encoders \
+	split_transport_pointing \
+	split_transport_batched_pointing \
+	split_transport_rgblight \
+	split_transport_batched_rgblight \
+	split_transport_rgb_matrix \
+	split_transport_batched_rgb_matrix \
+	split_transport_backlight \
+	split_transport_batched_backlight \
+	split_transport_oled \
+	split_transport_batched_oled \
+	split_transport_activity \
+	split_transport_batched_activity \
+	split_transport_watchdog \
+	split_transport_batched_watchdog
@@ -24,6 +24,11 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+    PUT_BATCH,
+    PUT_BATCH_SHORT,
+#endif // SPLIT_TRANSPORT_BATCHED
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -84,10 +84,300 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#ifdef SPLIT_TRANSPORT_BATCHED
+#    define transport_write(id, data, length) split_batch_write(id, data, length)
+#else // SPLIT_TRANSPORT_BATCHED
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#endif // SPLIT_TRANSPORT_BATCHED
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 #define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
 
+////////////////////////////////////////////////////
+// Batching
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+
+/**
+ * Writes made by the master handlers are queued up and sent to the slave together in a single PUT_BATCH exchange at
+ * the end of the scan, the response of which carries the slave matrix and the checksums the read handlers poll. The
+ * slave matrix is delta encoded against the matrix the master holds, identified by its checksum, falling back to
+ * GET_SLAVE_MATRIX_DATA if the slave no longer has it or too many rows changed.
+ *
+ * The exchange has fixed size frames, so it is only used when it is no larger than the transactions it replaces:
+ * the queued writes, the slave matrix if it changed, and the checksum polls. Otherwise the queued writes are sent one
+ * by one and the matrix is read as without batching, so that a scan never takes longer than it would unbatched.
+ */
+
+#    define SPLIT_BATCH_HEADER_SIZE offsetof(split_batch_m2s_t, data)
+// Checksums of other features at the end of the response, each would otherwise be a transaction of its own
+#    define SPLIT_BATCH_POLLED_CHECKSUMS (sizeof(split_batch_s2m_t) - offsetof(split_batch_s2m_t, rows) - sizeof_member(split_batch_s2m_t, rows))
+
+_Static_assert(SPLIT_BATCH_HEADER_SIZE + SPLIT_BATCH_BUFFER_SIZE <= UINT8_MAX, "SPLIT_BATCH_BUFFER_SIZE too large");
+_Static_assert(SPLIT_BATCH_SHORT_BUFFER_SIZE <= SPLIT_BATCH_BUFFER_SIZE, "SPLIT_BATCH_SHORT_BUFFER_SIZE larger than SPLIT_BATCH_BUFFER_SIZE");
+_Static_assert(SPLIT_BATCH_MAX_CHANGED_ROWS > 0 && SPLIT_BATCH_MAX_CHANGED_ROWS <= (MATRIX_ROWS) / 2, "SPLIT_BATCH_MAX_CHANGED_ROWS out of range");
+
+static split_batch_m2s_t batch_request;
+static split_batch_s2m_t batch_response;
+static bool              batch_open      = false;
+static bool              batch_exchanged = false;
+static matrix_row_t      batch_matrix[(MATRIX_ROWS) / 2]          = {0}; // last successfully-read slave matrix
+static matrix_row_t      batch_previous_matrix[(MATRIX_ROWS) / 2] = {0}; // slave side, matrix before its last change
+
+static bool split_batch_read_matrix(uint8_t checksum) {
+    matrix_row_t temp_matrix[(MATRIX_ROWS) / 2];
+    if (!transport_read(GET_SLAVE_MATRIX_DATA, temp_matrix, sizeof(temp_matrix)) || crc8(temp_matrix, sizeof(temp_matrix)) != checksum) {
+        return false;
+    }
+    memcpy(batch_matrix, temp_matrix, sizeof(temp_matrix));
+    return true;
+}
+
+static bool split_batch_decode_matrix(void) {
+    if (batch_response.flags & SPLIT_BATCH_FLAG_MATRIX_FULL) {
+        return split_batch_read_matrix(batch_response.matrix_checksum);
+    }
+
+    matrix_row_t temp_matrix[(MATRIX_ROWS) / 2];
+    memcpy(temp_matrix, batch_matrix, sizeof(temp_matrix));
+    uint8_t changed = 0;
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2 && changed < SPLIT_BATCH_MAX_CHANGED_ROWS; row++) {
+        if (batch_response.changed_rows[row / 8] & (1 << (row % 8))) {
+            memcpy(&temp_matrix[row], &batch_response.rows[sizeof(matrix_row_t) * changed++], sizeof(matrix_row_t));
+        }
+    }
+    if (crc8(temp_matrix, sizeof(temp_matrix)) != batch_response.matrix_checksum) {
+        // The matrix changed again before it could be read, the next scan reads it in full
+        return false;
+    }
+    memcpy(batch_matrix, temp_matrix, sizeof(temp_matrix));
+    return true;
+}
+
+// Updates the master's copy of shared memory once the slave has applied the queued writes, as the transport does for
+// each write that went through. Until then the handlers comparing against it keep seeing the old values.
+static void split_batch_commit(void) {
+    for (uint8_t i = 0; i < batch_request.length;) {
+        int8_t                    id    = batch_request.data[i++];
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+
+        memcpy(split_trans_initiator2target_buffer(trans), &batch_request.data[i], trans->initiator2target_buffer_size);
+        i += trans->initiator2target_buffer_size;
+#    ifdef SPLIT_WATCHDOG_ENABLE
+        if (id == PUT_WATCHDOG) {
+            split_watchdog_update(true);
+        }
+#    endif // SPLIT_WATCHDOG_ENABLE
+    }
+    batch_request.length = 0;
+}
+
+static bool split_batch_exchange(void) {
+    batch_request.matrix_ack = crc8(batch_matrix, sizeof(batch_matrix));
+    batch_request.checksum   = crc8(&batch_request.length, SPLIT_BATCH_HEADER_SIZE - 1 + batch_request.length);
+
+    int8_t id = batch_request.length <= SPLIT_BATCH_SHORT_BUFFER_SIZE ? PUT_BATCH_SHORT : PUT_BATCH;
+    if (!transport_execute_transaction(id, &batch_request, SPLIT_BATCH_HEADER_SIZE + batch_request.length, &batch_response, sizeof(batch_response))) {
+        return false;
+    }
+    if (batch_response.checksum != crc8(&batch_response.flags, sizeof(batch_response) - offsetof(split_batch_s2m_t, flags)) || (batch_response.flags & SPLIT_BATCH_FLAG_REJECTED)) {
+        return false;
+    }
+
+    // The slave has applied the queued writes, only the matrix is left to sort out
+    split_batch_commit();
+    batch_exchanged = true;
+    return split_batch_decode_matrix();
+}
+
+// Sends the queued writes as separate transactions, as the transport would without batching
+static bool split_batch_flush(void) {
+    for (uint8_t i = 0; i < batch_request.length;) {
+        int8_t                    id    = batch_request.data[i++];
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+
+        if (!transport_execute_transaction(id, &batch_request.data[i], trans->initiator2target_buffer_size, NULL, 0)) {
+            return false;
+        }
+        i += trans->initiator2target_buffer_size;
+    }
+    split_batch_commit();
+    return true;
+}
+
+// Compares the bytes on the wire, transaction IDs included; the exchange wins ties as it is a single transaction
+static bool split_batch_exchange_pays_off(bool matrix_changed) {
+    size_t exchange = 1 + SPLIT_BATCH_HEADER_SIZE + (batch_request.length <= SPLIT_BATCH_SHORT_BUFFER_SIZE ? SPLIT_BATCH_SHORT_BUFFER_SIZE : SPLIT_BATCH_BUFFER_SIZE) + sizeof(split_batch_s2m_t);
+    size_t separate = batch_request.length + 2 * SPLIT_BATCH_POLLED_CHECKSUMS;
+    if (matrix_changed) {
+        separate += 1 + sizeof(batch_matrix);
+    }
+    return exchange <= separate;
+}
+
+// Sends the queued writes whichever way is smaller
+static bool split_batch_send(void) {
+    return split_batch_exchange_pays_off(false) ? split_batch_exchange() : split_batch_flush();
+}
+
+static void split_batch_begin(void) {
+    batch_request.length = 0;
+    batch_open           = true;
+    batch_exchanged      = false;
+}
+
+static bool split_batch_write(int8_t id, const void *data, size_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    uint8_t                   size  = trans->initiator2target_buffer_size;
+
+    if (!batch_open) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+    if (1 + size > SPLIT_BATCH_BUFFER_SIZE) {
+        // Too large to queue, send the writes queued so far first so that the slave applies them in order
+        if (batch_request.length > 0 && !split_batch_send()) {
+            return false;
+        }
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+    if (batch_request.length + 1 + size > SPLIT_BATCH_BUFFER_SIZE && !split_batch_send()) {
+        // The queued writes are tried again at the end of the scan
+        return false;
+    }
+
+    // Queue the whole buffer like the transport sends it, the part past `length` keeps what was last sent
+    batch_request.data[batch_request.length++] = id;
+    memcpy(&batch_request.data[batch_request.length], split_trans_initiator2target_buffer(trans), size);
+    memcpy(&batch_request.data[batch_request.length], data, size < length ? size : length);
+    batch_request.length += size;
+    return true;
+}
+
+static inline bool split_batch_read_checksum(int8_t id, uint8_t *checksum) {
+    if (!batch_exchanged) {
+        return false;
+    }
+    switch (id) {
+#    ifdef ENCODER_ENABLE
+        case GET_ENCODERS_CHECKSUM:
+            *checksum = batch_response.encoders_checksum;
+            break;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        case GET_POINTING_CHECKSUM:
+            *checksum = batch_response.pointing_checksum;
+            break;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        default:
+            return false;
+    }
+    memcpy(split_trans_target2initiator_buffer(&split_transaction_table[id]), checksum, sizeof(*checksum));
+    return true;
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    batch_open = false;
+    bool okay  = true;
+    if (batch_request.length > 0 && split_batch_exchange_pays_off(false)) {
+        // Smaller than the queued writes on their own, and brings back the matrix as well
+        okay = split_batch_exchange();
+    } else {
+        uint8_t checksum;
+        okay         = transport_read(GET_SLAVE_MATRIX_CHECKSUM, &checksum, sizeof(checksum));
+        bool changed = okay && checksum != crc8(batch_matrix, sizeof(batch_matrix));
+        if (okay && batch_request.length > 0 && split_batch_exchange_pays_off(changed)) {
+            okay = split_batch_exchange();
+        } else if (okay) {
+            okay = split_batch_flush() && (!changed || split_batch_read_matrix(checksum));
+        }
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, batch_matrix, sizeof(batch_matrix));
+    return okay;
+}
+
+// Keeps the slave matrix from before the last change, as that is what the master holds until it reads the new one
+static void split_batch_slave_matrix_changing(const matrix_row_t matrix[]) {
+    if (memcmp(split_shmem->smatrix.matrix, matrix, sizeof(batch_previous_matrix)) != 0) {
+        memcpy(batch_previous_matrix, split_shmem->smatrix.matrix, sizeof(batch_previous_matrix));
+    }
+}
+
+static void batch_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_batch_m2s_t *request  = &split_shmem->batch_m2s;
+    split_batch_s2m_t       *response = &split_shmem->batch_s2m;
+    memset(response, 0, sizeof(split_batch_s2m_t));
+
+    if (request->length > initiator2target_buffer_size - SPLIT_BATCH_HEADER_SIZE || request->checksum != crc8(&request->length, SPLIT_BATCH_HEADER_SIZE - 1 + request->length)) {
+        response->flags    = SPLIT_BATCH_FLAG_REJECTED;
+        response->checksum = crc8(&response->flags, sizeof(split_batch_s2m_t) - offsetof(split_batch_s2m_t, flags));
+        return;
+    }
+
+    // Apply the queued writes as if they had been sent one by one
+    for (uint8_t i = 0; i < request->length;) {
+        int8_t id = request->data[i++];
+        if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+            break;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (i + trans->initiator2target_buffer_size > request->length) {
+            break;
+        }
+        memcpy(split_trans_initiator2target_buffer(trans), &request->data[i], trans->initiator2target_buffer_size);
+        i += trans->initiator2target_buffer_size;
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+
+    // Encode the current matrix against the one the master holds, if it is one the slave still knows
+    const matrix_row_t *matrix  = split_shmem->smatrix.matrix;
+    const matrix_row_t *base    = NULL;
+    uint8_t             changed = 0;
+    if (request->matrix_ack == split_shmem->smatrix.checksum) {
+        base = matrix;
+    } else if (request->matrix_ack == crc8(batch_previous_matrix, sizeof(batch_previous_matrix))) {
+        base = batch_previous_matrix;
+    }
+    for (uint8_t row = 0; base && row < (MATRIX_ROWS) / 2; row++) {
+        if (matrix[row] != base[row]) {
+            if (changed < SPLIT_BATCH_MAX_CHANGED_ROWS) {
+                response->changed_rows[row / 8] |= 1 << (row % 8);
+                memcpy(&response->rows[sizeof(matrix_row_t) * changed], &matrix[row], sizeof(matrix_row_t));
+            }
+            changed++;
+        }
+    }
+    if (!base || changed > SPLIT_BATCH_MAX_CHANGED_ROWS) {
+        response->flags |= SPLIT_BATCH_FLAG_MATRIX_FULL;
+    }
+    response->matrix_checksum = split_shmem->smatrix.checksum;
+
+#    ifdef ENCODER_ENABLE
+    response->encoders_checksum = split_shmem->encoders.checksum;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    response->pointing_checksum = split_shmem->pointing.checksum;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    response->checksum = crc8(&response->flags, sizeof(split_batch_s2m_t) - offsetof(split_batch_s2m_t, flags));
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_BEGIN() split_batch_begin()
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [PUT_BATCH]       = {sizeof_member(split_shared_memory_t, batch_m2s), offsetof(split_shared_memory_t, batch_m2s), sizeof_member(split_shared_memory_t, batch_s2m), offsetof(split_shared_memory_t, batch_s2m), batch_handlers_slave}, \
+    [PUT_BATCH_SHORT] = {SPLIT_BATCH_HEADER_SIZE + SPLIT_BATCH_SHORT_BUFFER_SIZE, offsetof(split_shared_memory_t, batch_m2s), sizeof_member(split_shared_memory_t, batch_s2m), offsetof(split_shared_memory_t, batch_s2m), batch_handlers_slave},
+// clang-format on
+
+#else // SPLIT_TRANSPORT_BATCHED
+
+#    define TRANSACTIONS_BATCH_BEGIN()
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_BATCHED
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
@@ -146,7 +436,12 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
-    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+#ifdef SPLIT_TRANSPORT_BATCHED
+    // Already brought back by the batch exchange
+    bool okay = split_batch_read_checksum(trans_id_checksum, &curr_checksum) || transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+#else  // SPLIT_TRANSPORT_BATCHED
+    bool okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+#endif // SPLIT_TRANSPORT_BATCHED
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
         okay &= curr_checksum == crc8(equiv_shmem, length);
@@ -178,6 +473,8 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifndef SPLIT_TRANSPORT_BATCHED
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -193,13 +490,24 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
     return okay;
 }
 
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+
+#else // SPLIT_TRANSPORT_BATCHED
+
+// The slave matrix comes back with the batch exchange, see TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER()
+
+#endif // SPLIT_TRANSPORT_BATCHED
+
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_BATCHED
+    split_batch_slave_matrix_changing(slave_matrix);
+#endif // SPLIT_TRANSPORT_BATCHED
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
@@ -538,6 +846,8 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 static bool led_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update = 0;
     led_matrix_sync_t led_matrix_sync;
+    // Compared as a whole, padding included
+    memset(&led_matrix_sync, 0, sizeof(led_matrix_sync));
     memcpy(&led_matrix_sync.led_matrix, &led_matrix_eeconfig, sizeof(led_eeconfig_t));
     led_matrix_sync.led_suspend_state = led_matrix_get_suspend_state();
     return send_if_data_mismatch(PUT_LED_MATRIX, &last_update, &led_matrix_sync, &split_shmem->led_matrix_sync, sizeof(led_matrix_sync));
@@ -572,6 +882,8 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update = 0;
     rgb_matrix_sync_t rgb_matrix_sync;
+    // Compared as a whole, padding included
+    memset(&rgb_matrix_sync, 0, sizeof(rgb_matrix_sync));
     memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
     rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
     return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
@@ -788,7 +1100,10 @@ static bool watchdog_handlers_master(matrix_row_t master_matrix[], matrix_row_t
     bool okay = true;
     if (!split_watchdog_check()) {
         okay = transport_write(PUT_WATCHDOG, &okay, sizeof(okay));
+        // A batched write has only been queued, split_batch_commit() updates the watchdog once the slave has it
+#    ifndef SPLIT_TRANSPORT_BATCHED
         split_watchdog_update(okay);
+#    endif // SPLIT_TRANSPORT_BATCHED
     }
     return okay;
 }
@@ -920,6 +1235,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 
     // clang-format off
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
     TRANSACTIONS_SYNC_TIMER_REGISTRATIONS
@@ -949,9 +1265,12 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_BATCH_BEGIN();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
+#ifndef SPLIT_TRANSPORT_BATCHED
     TRANSACTIONS_ENCODERS_MASTER();
+#endif // SPLIT_TRANSPORT_BATCHED
     TRANSACTIONS_SYNC_TIMER_MASTER();
     TRANSACTIONS_LAYER_STATE_MASTER();
     TRANSACTIONS_LED_STATE_MASTER();
@@ -963,11 +1282,19 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
+#ifndef SPLIT_TRANSPORT_BATCHED
     TRANSACTIONS_POINTING_MASTER();
+#endif // SPLIT_TRANSPORT_BATCHED
     TRANSACTIONS_WATCHDOG_MASTER();
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+#ifdef SPLIT_TRANSPORT_BATCHED
+    // Everything above has only been queued, handlers that read from the slave need the result of the exchange
+    TRANSACTIONS_BATCH_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+#endif // SPLIT_TRANSPORT_BATCHED
     return true;
 }
 
@@ -57,6 +57,44 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+#    ifndef SPLIT_BATCH_BUFFER_SIZE
+#        define SPLIT_BATCH_BUFFER_SIZE 32
+#    endif // SPLIT_BATCH_BUFFER_SIZE
+
+#    ifndef SPLIT_BATCH_SHORT_BUFFER_SIZE
+#        define SPLIT_BATCH_SHORT_BUFFER_SIZE 5
+#    endif // SPLIT_BATCH_SHORT_BUFFER_SIZE
+
+#    ifndef SPLIT_BATCH_MAX_CHANGED_ROWS
+#        define SPLIT_BATCH_MAX_CHANGED_ROWS 1
+#    endif // SPLIT_BATCH_MAX_CHANGED_ROWS
+
+typedef struct _split_batch_m2s_t {
+    uint8_t checksum;
+    uint8_t length;                        // number of bytes used in data
+    uint8_t matrix_ack;                    // checksum of the slave matrix the master holds
+    uint8_t data[SPLIT_BATCH_BUFFER_SIZE]; // transaction ID followed by its initiator2target data, repeated
+} split_batch_m2s_t;
+
+#    define SPLIT_BATCH_FLAG_MATRIX_FULL 0x01 // matrix did not fit in the response, read it with GET_SLAVE_MATRIX_DATA
+#    define SPLIT_BATCH_FLAG_REJECTED 0x02    // request failed its checksum, nothing was applied
+
+typedef struct _split_batch_s2m_t {
+    uint8_t checksum;
+    uint8_t flags;
+    uint8_t matrix_checksum;
+    uint8_t changed_rows[((MATRIX_ROWS) / 2 + 7) / 8];                 // rows that differ from the matrix the master holds
+    uint8_t rows[SPLIT_BATCH_MAX_CHANGED_ROWS * sizeof(matrix_row_t)]; // new values of the changed rows, in row order
+#    ifdef ENCODER_ENABLE
+    uint8_t encoders_checksum;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    uint8_t pointing_checksum;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+} split_batch_s2m_t;
+#endif // SPLIT_TRANSPORT_BATCHED
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -153,6 +191,11 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+    split_batch_m2s_t batch_m2s;
+    split_batch_s2m_t batch_s2m;
+#endif // SPLIT_TRANSPORT_BATCHED
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -63,4 +63,28 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+wear_leveling_benchmark_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=4096 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024
+wear_leveling_benchmark_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_benchmark.cpp
+wear_leveling_benchmark_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_write_combining_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=4096 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_WRITE_COMBINING \
+	-DWEAR_LEVELING_DIRTY_RANGES=4
+wear_leveling_write_combining_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_write_combining.cpp \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_benchmark.cpp
+wear_leveling_write_combining_INC := \
+	$(wear_leveling_common_INC)
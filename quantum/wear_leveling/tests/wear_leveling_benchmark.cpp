@@ -0,0 +1,114 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <chrono>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+/**
+ * Built both with and without WEAR_LEVELING_WRITE_COMBINING, so the numbers printed by each build can be compared.
+ */
+
+namespace {
+constexpr uint32_t KEYMAP_ADDRESS = 64;
+constexpr uint32_t KEYMAP_SIZE    = 4 * 60 * 2; // 4 layers of 60 keys
+constexpr uint32_t PACKET_SIZE    = 28;         // bytes per VIA set_buffer packet
+constexpr int      UPLOADS        = 10;
+
+/**
+ * Emulates a VIA keymap upload: dynamic_keymap_set_buffer() updates one byte at a time, and packets arrive far quicker
+ * than any flush timeout.
+ */
+void via_upload(int seed) {
+    for (uint32_t offset = 0; offset < KEYMAP_SIZE; offset += PACKET_SIZE) {
+        for (uint32_t i = offset; i < offset + PACKET_SIZE && i < KEYMAP_SIZE; i += 2) {
+            uint16_t keycode = ((seed + i) % 7 == 0) ? 0x0001 : 0x0004 + ((seed + i) % 100);
+            uint8_t  bytes[] = {(uint8_t)(keycode >> 8), (uint8_t)keycode}; // stored big-endian
+            wear_leveling_write(KEYMAP_ADDRESS + i + 0, &bytes[0], 1);
+            wear_leveling_write(KEYMAP_ADDRESS + i + 1, &bytes[1], 1);
+        }
+    }
+    wear_leveling_flush();
+}
+
+/**
+ * Emulates eeconfig_init(): the store is erased, then the config fields are written one by one.
+ */
+void eeconfig_reset(void) {
+    wear_leveling_erase();
+    for (uint32_t address = 0; address < 40; address += 4) {
+        uint32_t       value = 0x01010101 * (address + 1);
+        const uint8_t* bytes = (const uint8_t*)&value;
+        wear_leveling_write(address + 0, &bytes[0], 1);
+        wear_leveling_write(address + 1, &bytes[1], 2);
+        wear_leveling_write(address + 3, &bytes[3], 1);
+    }
+    wear_leveling_flush();
+}
+
+void report(const char* name, double seconds) {
+    auto& inst = MockBackingStore::Instance();
+    std::cout << "[ BENCHMARK] " << name << (wear_leveling_flush_pending() ? " (pending)" : "") << ": " << inst.erasure_count() << " erases, " << inst.total_write_count() << " backing writes, " << (seconds * 1e6) << " us" << std::endl;
+    ::testing::Test::RecordProperty("erases", (int)inst.erasure_count());
+    ::testing::Test::RecordProperty("backing_writes", (int)inst.total_write_count());
+}
+} // namespace
+
+class WearLevelingBenchmark : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+TEST_F(WearLevelingBenchmark, ViaKeymapUploads) {
+    auto& inst  = MockBackingStore::Instance();
+    auto  start = std::chrono::steady_clock::now();
+    for (int i = 0; i < UPLOADS; ++i) {
+        via_upload(i);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report("via_keymap_uploads", elapsed.count());
+
+    // Data survives a reboot
+    wear_leveling_init();
+    for (uint32_t i = 0; i < KEYMAP_SIZE; i += 2) {
+        uint16_t keycode = ((UPLOADS - 1 + i) % 7 == 0) ? 0x0001 : 0x0004 + ((UPLOADS - 1 + i) % 100);
+        uint8_t  bytes[2];
+        EXPECT_EQ(wear_leveling_read(KEYMAP_ADDRESS + i, bytes, 2), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(bytes[0], (uint8_t)(keycode >> 8)) << "Invalid readback at " << i;
+        EXPECT_EQ(bytes[1], (uint8_t)keycode) << "Invalid readback at " << i;
+    }
+
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+    // Each upload fits in the log at least three times over, so at most one consolidation every three uploads
+    EXPECT_LE(inst.erasure_count(), (UPLOADS + 2) / 3) << "Too many erases";
+    // 5 bytes per 8-byte multi-byte entry
+    EXPECT_LE(inst.total_write_count(), UPLOADS * (KEYMAP_SIZE * 8 / 5 + 8) / BACKING_STORE_WRITE_SIZE + inst.erasure_count() * (WEAR_LEVELING_LOGICAL_SIZE + 8) / BACKING_STORE_WRITE_SIZE) << "Too many backing writes";
+#else
+    (void)inst;
+#endif
+}
+
+TEST_F(WearLevelingBenchmark, EeconfigReset) {
+    auto& inst  = MockBackingStore::Instance();
+    auto  start = std::chrono::steady_clock::now();
+    for (int i = 0; i < UPLOADS; ++i) {
+        eeconfig_reset();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report("eeconfig_reset", elapsed.count());
+
+    wear_leveling_init();
+    for (uint32_t address = 0; address < 40; address += 4) {
+        uint32_t expected = 0x01010101 * (address + 1);
+        uint32_t value;
+        EXPECT_EQ(wear_leveling_read(address, &value, 4), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(value, expected) << "Invalid readback at " << address;
+    }
+
+    // One erase per reset, the log never fills up
+    EXPECT_EQ(inst.erasure_count(), UPLOADS) << "Unexpected erase count";
+}
@@ -0,0 +1,188 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingWriteCombining : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+/**
+ * This test verifies that writes only reach the backing store on flush, while reads see the new data straight away.
+ */
+TEST_F(WearLevelingWriteCombining, WritesDeferredUntilFlush) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x80, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have reached the backing store";
+    EXPECT_TRUE(wear_leveling_flush_pending()) << "Write should be pending";
+
+    uint8_t read_val = 0;
+    EXPECT_EQ(wear_leveling_read(0x80, &read_val, sizeof(read_val)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(read_val, test_val) << "Cache should have the written value";
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+    EXPECT_GT(inst.write_invoke_count(), 0) << "Flush should have written to the backing store";
+    EXPECT_FALSE(wear_leveling_flush_pending()) << "Nothing should be pending after a flush";
+    EXPECT_TRUE(inst.is_locked()) << "Backing store should be locked after a flush";
+
+    read_val = 0;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0x80, &read_val, sizeof(read_val)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(read_val, test_val) << "Invalid readback after re-init";
+}
+
+/**
+ * This test verifies that a flush with nothing pending does not touch the backing store.
+ */
+TEST_F(WearLevelingWriteCombining, EmptyFlush) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+    EXPECT_EQ(inst.unlock_invoke_count(), 0) << "Flush should not have unlocked the backing store";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Flush should not have written to the backing store";
+}
+
+/**
+ * This test verifies that adjacent single-byte writes are combined into a single multi-byte log entry.
+ */
+TEST_F(WearLevelingWriteCombining, AdjacentWritesCombined) {
+    auto& inst     = MockBackingStore::Instance();
+    auto  logstart = inst.storage_begin() + ((WEAR_LEVELING_LOGICAL_SIZE + 8) / sizeof(backing_store_int_t));
+
+    uint8_t test_val[] = {0x11, 0x22, 0x33, 0x44, 0x55};
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(wear_leveling_write(0x80 + i, &test_val[i], 1), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    }
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+
+    // One 5-byte entry, 4 backing store writes
+    EXPECT_EQ(inst.write_invoke_count(), 4) << "Expected a single multi-byte log entry";
+    write_log_entry_t e;
+    e.raw16[0] = ~(logstart + 0)->get();
+    e.raw16[1] = ~(logstart + 1)->get();
+    e.raw16[2] = ~(logstart + 2)->get();
+    e.raw16[3] = ~(logstart + 3)->get();
+    EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_MULTIBYTE) << "Invalid log entry type";
+    EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_ADDRESS(e), 0x80) << "Invalid log entry address";
+    EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_LENGTH(e), 5) << "Invalid log entry length";
+    EXPECT_TRUE((logstart + 4)->is_erased()) << "Nothing else should have been logged";
+}
+
+/**
+ * This test verifies that overwriting the same location only logs the final value.
+ */
+TEST_F(WearLevelingWriteCombining, OverlappingWritesCombined) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint8_t i = 1; i <= 10; ++i) {
+        uint8_t test_val[] = {i, (uint8_t)(i + 1), (uint8_t)(i + 2)};
+        EXPECT_EQ(wear_leveling_write(0x81 + (i % 2), test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    }
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+
+    // Four bytes 0x81..0x84 in a single entry, 4 backing store writes
+    EXPECT_EQ(inst.write_invoke_count(), 4) << "Expected a single multi-byte log entry";
+
+    // 0x81...0x83 were last written by i == 10, 0x84 by i == 9
+    uint8_t expected[] = {10, 11, 12, 11};
+    uint8_t read_val[4];
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0x81, read_val, sizeof(read_val)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_THAT(read_val, ::testing::ElementsAreArray(expected)) << "Invalid readback after re-init";
+}
+
+/**
+ * This test verifies that more separate ranges than WEAR_LEVELING_DIRTY_RANGES are merged, without losing data.
+ */
+TEST_F(WearLevelingWriteCombining, TooManyRangesMerged) {
+    for (uint32_t i = 0; i < 2 * WEAR_LEVELING_DIRTY_RANGES; ++i) {
+        uint8_t test_val = 0x40 + i;
+        EXPECT_EQ(wear_leveling_write(0x80 + i * (i + 1), &test_val, 1), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    }
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    for (uint32_t i = 0; i < 2 * WEAR_LEVELING_DIRTY_RANGES; ++i) {
+        uint8_t read_val = 0;
+        EXPECT_EQ(wear_leveling_read(0x80 + i * (i + 1), &read_val, 1), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(read_val, 0x40 + i) << "Invalid readback after re-init";
+    }
+}
+
+/**
+ * This test verifies that a flush which may not fit in the remainder of the log consolidates once instead.
+ */
+TEST_F(WearLevelingWriteCombining, LargeFlushConsolidatesOnce) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Generate a test block of data
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+
+    // The first pass fits in the log
+    for (size_t i = 0; i < testvalue.size(); ++i) {
+        EXPECT_EQ(wear_leveling_write(i, &testvalue[i], 1), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    }
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+    EXPECT_EQ(inst.erasure_count(), 0) << "No erase should have happened";
+
+    // The second one does not
+    std::iota(testvalue.begin(), testvalue.end(), 0x40);
+    for (size_t i = 0; i < testvalue.size(); ++i) {
+        EXPECT_EQ(wear_leveling_write(i, &testvalue[i], 1), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    }
+    uint64_t write_count = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush should have consolidated";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Flush should have erased exactly once";
+    EXPECT_EQ(inst.write_invoke_count() - write_count, (WEAR_LEVELING_LOGICAL_SIZE + 8) / BACKING_STORE_WRITE_SIZE) << "Flush should only have written the consolidated data";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readvalue;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readvalue.data(), readvalue.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(readvalue, testvalue) << "Invalid readback after re-init";
+}
+
+/**
+ * This test verifies that erasing drops any pending writes.
+ */
+TEST_F(WearLevelingWriteCombining, EraseDropsPendingWrites) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x80, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase should have succeeded";
+    EXPECT_FALSE(wear_leveling_flush_pending()) << "Nothing should be pending after an erase";
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Nothing should have been written";
+}
+
+/**
+ * This test verifies that a failed flush keeps the pending writes, so that a later flush writes them.
+ */
+TEST_F(WearLevelingWriteCombining, FailedFlushRetried) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x80, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return false; });
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_FAILED) << "Flush should have failed";
+    EXPECT_TRUE(wear_leveling_flush_pending()) << "Write should still be pending";
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return true; });
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have succeeded";
+
+    uint8_t read_val = 0;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0x80, &read_val, sizeof(read_val)), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    EXPECT_EQ(read_val, test_val) << "Invalid readback after re-init";
+}
@@ -61,6 +61,11 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_WRITE_COMBINING: Optional. If defined, writes only
+            update the cache and are written to the log by
+            wear_leveling_flush(). WEAR_LEVELING_DIRTY_RANGES (default 8) sets
+            how many separate address ranges are tracked until then.
+
     General algorithm:
 
         During initialization:
@@ -76,6 +81,15 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        With write combining:
+            * The cache is updated with the new data.
+            * The written address range is merged with any adjacent or
+                overlapping range written since the last flush. If there are
+                too many ranges, the two closest are merged.
+            * On flush, each range is appended to the log from the cache. If
+                the ranges might not fit in the rest of the log, the cache is
+                consolidated instead of appending.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -164,6 +178,27 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     bool                                                           unlocked;
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+#    ifndef WEAR_LEVELING_DIRTY_RANGES
+#        define WEAR_LEVELING_DIRTY_RANGES 8
+#    endif
+
+/**
+ * Logical address range written to the cache but not yet to the write log.
+ */
+typedef struct dirty_range_t {
+    uint32_t start;
+    uint32_t end; // exclusive
+} dirty_range_t;
+
+/**
+ * Pending ranges, sorted by address and never touching each other. The extra slot holds a new range until the closest
+ * two are merged.
+ */
+static dirty_range_t dirty_ranges[(WEAR_LEVELING_DIRTY_RANGES) + 1];
+static uint8_t       dirty_count;
+#endif // WEAR_LEVELING_WRITE_COMBINING
+
 /**
  * Locking helper: status
  */
@@ -203,6 +238,9 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+    dirty_count = 0;
+#endif
 }
 
 /**
@@ -469,6 +507,75 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+/**
+ * Merges the two pending ranges with the smallest gap between them.
+ */
+static void wear_leveling_merge_closest_ranges(void) {
+    uint8_t  closest  = 0;
+    uint32_t smallest = UINT32_MAX;
+    for (uint8_t i = 0; i + 1 < dirty_count; ++i) {
+        uint32_t gap = dirty_ranges[i + 1].start - dirty_ranges[i].end;
+        if (gap < smallest) {
+            closest  = i;
+            smallest = gap;
+        }
+    }
+
+    dirty_ranges[closest].end = dirty_ranges[closest + 1].end;
+    memmove(&dirty_ranges[closest + 1], &dirty_ranges[closest + 2], (dirty_count - closest - 2) * sizeof(dirty_range_t));
+    --dirty_count;
+}
+
+/**
+ * Records that the logical range [start, end) needs to be written to the log.
+ */
+static void wear_leveling_mark_dirty(uint32_t start, uint32_t end) {
+    // Skip the ranges entirely before this one
+    uint8_t first = 0;
+    while (first < dirty_count && dirty_ranges[first].end < start) {
+        ++first;
+    }
+
+    // Absorb the ranges overlapping or adjacent to this one
+    uint8_t last = first;
+    while (last < dirty_count && dirty_ranges[last].start <= end) {
+        if (dirty_ranges[last].start < start) {
+            start = dirty_ranges[last].start;
+        }
+        if (dirty_ranges[last].end > end) {
+            end = dirty_ranges[last].end;
+        }
+        ++last;
+    }
+
+    if (last > first) {
+        memmove(&dirty_ranges[first + 1], &dirty_ranges[last], (dirty_count - last) * sizeof(dirty_range_t));
+        dirty_count -= last - first - 1;
+    } else {
+        memmove(&dirty_ranges[first + 1], &dirty_ranges[first], (dirty_count - first) * sizeof(dirty_range_t));
+        ++dirty_count;
+    }
+    dirty_ranges[first] = (dirty_range_t){.start = start, .end = end};
+
+    if (dirty_count > (WEAR_LEVELING_DIRTY_RANGES)) {
+        wear_leveling_merge_closest_ranges();
+    }
+}
+
+/**
+ * Upper bound of the log space used by wear_leveling_write_raw() for the given length.
+ */
+static uint32_t wear_leveling_log_size_bound(uint32_t length) {
+#    if BACKING_STORE_WRITE_SIZE == 2
+    // Byte-entries take 2 bytes per byte, a short multi-byte entry at the end takes up to 2 more
+    return 2 * length + 4;
+#    else
+    return 8 * ((length + LOG_ENTRY_MULTIBYTE_MAX_BYTES - 1) / LOG_ENTRY_MULTIBYTE_MAX_BYTES);
+#    endif
+}
+#endif // WEAR_LEVELING_WRITE_COMBINING
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
@@ -691,6 +798,12 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+    // The log is written from the cache on the next flush
+    wear_leveling_mark_dirty(address, address + length);
+    return WEAR_LEVELING_SUCCESS;
+#endif
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -726,6 +839,72 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Writes the ranges held back by write combining into the log.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+    if (dirty_count == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Flush %d ranges\n", (int)dirty_count);
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    uint32_t log_size = 0;
+    for (uint8_t i = 0; i < dirty_count; ++i) {
+        log_size += wear_leveling_log_size_bound(dirty_ranges[i].end - dirty_ranges[i].start);
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    if (wear_leveling.write_address + log_size > (WEAR_LEVELING_BACKING_SIZE)) {
+        // The log could fill up part way through, consolidating up front writes everything with a single erase
+        status = wear_leveling_consolidate_force();
+    } else {
+        for (uint8_t i = 0; i < dirty_count && status == WEAR_LEVELING_SUCCESS; ++i) {
+            const uint32_t start = dirty_ranges[i].start;
+            status               = wear_leveling_write_raw(start, &wear_leveling.cache[start], dirty_ranges[i].end - start);
+        }
+        if (status == WEAR_LEVELING_SUCCESS) {
+            // Consolidate the cache + write log if required
+            status = wear_leveling_consolidate_if_needed();
+        }
+    }
+
+    // Keep the ranges on failure so that a later flush retries them
+    if (status != WEAR_LEVELING_FAILED) {
+        dirty_count = 0;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_WRITE_COMBINING
+}
+
+/**
+ * Whether there is data waiting for a flush.
+ */
+bool wear_leveling_flush_pending(void) {
+#ifdef WEAR_LEVELING_WRITE_COMBINING
+    return dirty_count > 0;
+#else
+    return false;
+#endif // WEAR_LEVELING_WRITE_COMBINING
+}
+
 /**
  * Reads logical data from the cache.
  */
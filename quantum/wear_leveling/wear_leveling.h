@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
 /**
@@ -36,6 +37,9 @@ wear_leveling_status_t wear_leveling_erase(void);
  * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
  * not just the changed bytes.
  *
+ * If WEAR_LEVELING_WRITE_COMBINING is defined, only the cache is updated and the written range is remembered; the
+ * backing store is written by the next call to wear_leveling_flush().
+ *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
  * @param length[in] length of the data
@@ -52,3 +56,18 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Writes any data held back by WEAR_LEVELING_WRITE_COMBINING to the backing store.
+ *
+ * Adjacent and overlapping writes since the last flush are written to the log once. If they would not fit in the
+ * remainder of the log, the cache is consolidated instead, so a flush never consolidates more than once.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
+/**
+ * Whether there is data waiting for wear_leveling_flush().
+ */
+bool wear_leveling_flush_pending(void);
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define AUTOCORRECT_EXTERNAL_FLASH
+// flash_spi.h needs a chip select pin, the test mocks the flash reads instead.
+#define EXTERNAL_FLASH_SPI_SLAVE_SELECT_PIN 0
@@ -0,0 +1,9 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTOCORRECT_ENABLE = yes
+
+# flash_spi.h only, flash_read_block() is mocked by the test.
+COMMON_VPATH += $(DRIVER_PATH)/flash
+
+SRC += tests/autocorrect/test_autocorrect.cpp
@@ -0,0 +1,181 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "flash_spi.h"
+
+/**
+ * Serves autocorrect_data.bin as the external flash. autocorrect_data.bin and autocorrect_data.h were generated from
+ * autocorrect_dict.txt with `qmk generate-autocorrect-data --external-flash`, which holds the default dictionary, so
+ * the tests of the parent folder pass, and synthetic words to benchmark the lookups with.
+ */
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+const std::string test_dir = std::string(__FILE__).substr(0, std::string(__FILE__).rfind('/') + 1);
+
+std::vector<uint8_t> flash;
+std::string          last_correction;
+unsigned             correction_count = 0;
+
+void load_flash() {
+    std::ifstream file(test_dir + "autocorrect_data.bin", std::ios::binary);
+    flash.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::vector<std::pair<std::string, std::string>> load_dictionary() {
+    std::ifstream                                    file(test_dir + "autocorrect_dict.txt");
+    std::vector<std::pair<std::string, std::string>> dictionary;
+    for (std::string line; std::getline(file, line);) {
+        auto arrow = line.find("->");
+        if (line.empty() || line[0] == '#' || arrow == std::string::npos) {
+            continue;
+        }
+        std::string typo       = line.substr(0, line.find_last_not_of(' ', arrow - 1) + 1);
+        std::string correction = line.substr(line.find_first_not_of(' ', arrow + 2));
+        dictionary.push_back({typo, correction});
+    }
+    return dictionary;
+}
+
+uint16_t char_to_keycode(char c) {
+    switch (c) {
+        case ' ':
+        case ':':
+            return KC_SPACE;
+        case '\'':
+            return KC_QUOTE;
+        case '\b':
+            return KC_BACKSPACE;
+        default:
+            return KC_A + (c - 'a');
+    }
+}
+} // namespace
+
+extern "C" {
+void flash_init(void) {}
+
+flash_status_t flash_read_block(uint32_t addr, void *buf, size_t len) {
+    if (flash.empty()) {
+        load_flash();
+    }
+    for (size_t i = 0; i < len; i++) {
+        ((uint8_t *)buf)[i] = addr + i < flash.size() ? flash[addr + i] : 0xFF;
+    }
+    return FLASH_STATUS_SUCCESS;
+}
+
+bool apply_autocorrect(uint8_t backspaces, const char *str, char *typo, char *correct) {
+    last_correction = correct;
+    correction_count++;
+    return true;
+}
+}
+
+class AutoCorrectExternalFlash : public TestFixture {
+   public:
+    std::vector<double> keystroke_us;
+
+    void SetUp() override {
+        autocorrect_enable();
+    }
+
+    // Feeds `text` to autocorrect, and returns whether it was corrected.
+    bool type(const std::string &text) {
+        unsigned corrections = correction_count;
+        for (char c : text) {
+            keyrecord_t record   = {};
+            record.event.pressed = true;
+
+            auto begin = std::chrono::steady_clock::now();
+            process_autocorrect(char_to_keycode(c), &record);
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+            keystroke_us.push_back(elapsed.count());
+        }
+        return correction_count != corrections;
+    }
+};
+
+TEST_F(AutoCorrectExternalFlash, MismatchedFlashDisablesLookups) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    load_flash();
+    flash[7]++; // the size in the header no longer matches DICTIONARY_SIZE
+    autocorrect_flash_invalidate();
+    EXPECT_FALSE(type(" fales"));
+
+    load_flash();
+    EXPECT_FALSE(type(" fales")) << "the header should only be checked again when invalidated";
+    autocorrect_flash_invalidate();
+    EXPECT_TRUE(type(" fales"));
+    EXPECT_EQ(last_correction, "false");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoCorrectExternalFlash, RepeatedLookupsHitTheCache) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    type(" fal");
+    autocorrect_flash_reset_cache_stats();
+    // walks the same nodes twice
+    type("e\be");
+
+    auto stats = autocorrect_flash_get_cache_stats();
+    EXPECT_GT(stats.hits, 0);
+    EXPECT_LE(stats.misses, stats.hits / 2);
+    EXPECT_TRUE(type("s"));
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoCorrectExternalFlash, DictionaryLookupBenchmark) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    auto dictionary = load_dictionary();
+    ASSERT_GT(dictionary.size(), 1000);
+
+    // Warm up the cache with a word, so the reported numbers don't depend on the order of the tests.
+    type(" fales ");
+    autocorrect_flash_reset_cache_stats();
+    keystroke_us.clear();
+
+    unsigned false_triggers = 0;
+    for (const auto &entry : dictionary) {
+        // The correctly spelled word first, which usually misses halfway through the trie.
+        false_triggers += type(" " + entry.second);
+        if (entry.first.find(':') != std::string::npos) {
+            // Word boundaries are covered by the tests of the parent folder.
+            continue;
+        }
+        EXPECT_TRUE(type(" " + entry.first)) << "\"" << entry.first << "\" was not corrected";
+        EXPECT_EQ(last_correction, entry.second) << "\"" << entry.first << "\" was corrected wrongly";
+    }
+
+    auto   stats    = autocorrect_flash_get_cache_stats();
+    double hit_rate = 100.0 * stats.hits / (stats.hits + stats.misses);
+    double mean_us  = 0;
+    for (double us : keystroke_us) {
+        mean_us += us / keystroke_us.size();
+    }
+    std::sort(keystroke_us.begin(), keystroke_us.end());
+
+    std::cout << "[ BENCHMARK] autocorrect_external_flash: " << dictionary.size() << " entries, " << keystroke_us.size() << " keystrokes, mean " << mean_us << " us, median " << keystroke_us[keystroke_us.size() / 2] << " us, max " << keystroke_us.back() << " us, cache hit rate " << hit_rate << " %, " << (double)stats.misses / keystroke_us.size() << " flash reads of " << AUTOCORRECT_FLASH_CACHE_LINE_SIZE << " bytes per keystroke, " << false_triggers << " false triggers" << std::endl;
+
+    VERIFY_AND_CLEAR(driver);
+}
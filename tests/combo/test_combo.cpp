@@ -55,3 +55,75 @@ TEST_F(Combo, combo_osmshift_tapped) {
     tap_key(key_i);
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Combo, longer_overlapping_combo_wins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 1, KC_A);
+    KeymapKey  key_b(0, 0, 2, KC_B);
+    KeymapKey  key_c(0, 0, 3, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_b, key_a});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, combos_sharing_a_key) {
+    TestDriver driver;
+    KeymapKey  key_j(0, 0, 1, KC_J);
+    KeymapKey  key_k(0, 0, 2, KC_K);
+    KeymapKey  key_l(0, 0, 3, KC_L);
+    set_keymap({key_j, key_k, key_l});
+
+    EXPECT_REPORT(driver, (KC_TAB));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_k, key_l});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_j, key_k});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, combo_key_alone_after_combo_term) {
+    TestDriver driver;
+    KeymapKey  key_k(0, 0, 1, KC_K);
+    set_keymap({key_k});
+
+    EXPECT_REPORT(driver, (KC_K));
+    EXPECT_EMPTY_REPORT(driver);
+    key_k.press();
+    idle_for(COMBO_TERM + 1);
+    key_k.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, combo_with_repeated_key_never_fires) {
+    TestDriver driver;
+    KeymapKey  key_m(0, 0, 1, KC_M);
+    set_keymap({key_m});
+
+    EXPECT_REPORT(driver, (KC_M));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_m);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, other_keys_pass_through) {
+    TestDriver driver;
+    KeymapKey  key_i(0, 0, 1, KC_I);
+    set_keymap({key_i});
+
+    EXPECT_REPORT(driver, (KC_I));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_i);
+    VERIFY_AND_CLEAR(driver);
+}
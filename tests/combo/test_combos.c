@@ -4,14 +4,24 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include "quantum.h"
 
-enum combos { modtest, osmshift };
+enum combos { modtest, osmshift, ab, abc, kl, jk, dup };
 
 uint16_t const modtest_combo[]  = {KC_Y, KC_U, COMBO_END};
 uint16_t const osmshift_combo[] = {KC_Z, KC_X, COMBO_END};
+uint16_t const ab_combo[]       = {KC_B, KC_A, COMBO_END};
+uint16_t const abc_combo[]      = {KC_C, KC_A, KC_B, COMBO_END};
+uint16_t const kl_combo[]       = {KC_L, KC_K, COMBO_END};
+uint16_t const jk_combo[]       = {KC_J, KC_K, COMBO_END};
+uint16_t const dup_combo[]      = {KC_M, KC_M, COMBO_END};
 
 // clang-format off
 combo_t key_combos[] = {
     [modtest]  = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
-    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT))
+    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT)),
+    [ab]       = COMBO(ab_combo, KC_1),
+    [abc]      = COMBO(abc_combo, KC_2),
+    [kl]       = COMBO(kl_combo, KC_TAB),
+    [jk]       = COMBO(jk_combo, KC_ESCAPE),
+    [dup]      = COMBO(dup_combo, KC_3)
 };
 // clang-format on
@@ -0,0 +1,7 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+DYNAMIC_KEYMAP_ENABLE = yes
+
+# The test platform's EEPROM is too small to hold a dynamic keymap
+EEPROM_DRIVER = transient
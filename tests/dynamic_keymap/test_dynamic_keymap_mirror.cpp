@@ -0,0 +1,68 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+namespace {
+
+// Changes a keycode in EEPROM without going through the dynamic keymap, so the mirror doesn't see it
+void write_behind_mirror(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+    eeprom_write_block(data, dynamic_keymap_key_to_eeprom_address(layer, row, column), sizeof(data));
+}
+
+uint16_t read_eeprom(uint8_t layer, uint8_t row, uint8_t column) {
+    uint8_t data[2];
+    eeprom_read_block(data, dynamic_keymap_key_to_eeprom_address(layer, row, column), sizeof(data));
+    return (data[0] << 8) | data[1];
+}
+
+} // namespace
+
+class DynamicKeymapMirror : public TestFixture {};
+
+TEST_F(DynamicKeymapMirror, InitFillsTheMirror) {
+    write_behind_mirror(0, 1, 2, KC_A);
+    dynamic_keymap_init();
+
+    // Neither the first read nor any later one goes back to EEPROM
+    write_behind_mirror(0, 1, 2, KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_A);
+}
+
+TEST_F(DynamicKeymapMirror, ResetFillsTheMirror) {
+    dynamic_keymap_set_keycode(1, 2, 3, KC_A);
+    dynamic_keymap_reset();
+
+    write_behind_mirror(1, 2, 3, KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_TRNS);
+}
+
+TEST_F(DynamicKeymapMirror, BufferReadsComeFromTheMirror) {
+    dynamic_keymap_reset();
+    dynamic_keymap_set_keycode(0, 0, 1, KC_A);
+
+    write_behind_mirror(0, 0, 1, KC_B);
+    uint8_t data[4];
+    dynamic_keymap_get_buffer(0, sizeof(data), data);
+    EXPECT_EQ((data[2] << 8) | data[3], KC_A);
+}
+
+TEST_F(DynamicKeymapMirror, WritesGoThroughToEeprom) {
+    dynamic_keymap_reset();
+
+    dynamic_keymap_set_keycode(0, 3, 4, KC_A);
+    EXPECT_EQ(read_eeprom(0, 3, 4), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 3, 4), KC_A);
+
+    uint8_t data[2] = {(uint8_t)(KC_B >> 8), (uint8_t)(KC_B & 0xFF)};
+    dynamic_keymap_set_buffer((uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 3, 5) - (uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 0, 0), sizeof(data), data);
+    EXPECT_EQ(read_eeprom(0, 3, 5), KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 3, 5), KC_B);
+}
@@ -0,0 +1,15 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define I2C_ASYNC_QUEUE_LENGTH 4
+
+#define IS31FL3731_I2C_ASYNC
+#define IS31FL3731_I2C_ADDRESS_1 IS31FL3731_I2C_ADDRESS_GND
+#define IS31FL3731_LED_COUNT 3
+
+#define OLED_I2C_ASYNC
+#define OLED_TRANSPORT_I2C
@@ -0,0 +1,11 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+I2C_ASYNC_ENABLE = yes
+
+# QUANTUM_LIB_SRC is not built for tests, the bus is the test platform's mock.
+SRC += i2c_async.c i2c_master.c
+
+# The drivers are built without their features, so keyboard_init() and the scan loop leave the bus to the tests.
+COMMON_VPATH += $(DRIVER_PATH)/led/issi $(DRIVER_PATH)/oled
+SRC += is31fl3731.c oled_driver.c
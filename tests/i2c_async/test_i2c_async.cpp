@@ -0,0 +1,393 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "i2c_async.h"
+#include "is31fl3731.h"
+#include "oled_driver.h"
+
+// One LED in the first, third and last PWM chunk
+const is31fl3731_led_t PROGMEM g_is31fl3731_leds[IS31FL3731_LED_COUNT] = {
+    {0, C1_1, C1_2, C1_3},
+    {0, C3_9, C3_10, C3_11},
+    {0, C9_3, C9_4, C9_5},
+};
+}
+
+using testing::_;
+
+namespace {
+
+std::vector<std::pair<i2c_async_transaction_t *, i2c_status_t>> completed;
+
+void record_completion(i2c_async_transaction_t *transaction, i2c_status_t status) {
+    completed.push_back({transaction, status});
+}
+
+i2c_async_transaction_t make_transaction(i2c_async_priority_t priority) {
+    i2c_async_transaction_t transaction = {};
+    transaction.priority                = priority;
+    transaction.callback                = record_completion;
+    return transaction;
+}
+
+// Finishes the transfers held on the bus one at a time, and returns the addresses in the order they were on the bus.
+std::vector<uint8_t> complete_all() {
+    while (i2c_mock_complete_transfer()) {
+        i2c_async_task();
+    }
+
+    std::vector<uint8_t> addresses;
+    for (uint16_t i = 0; i < i2c_mock_transfer_count(); i++) {
+        addresses.push_back(i2c_mock_get_transfer(i)->address);
+    }
+    return addresses;
+}
+
+// The transfers logged since `first` that went to `address`
+std::vector<i2c_mock_transfer_t> transfers_to(uint8_t address, uint16_t first = 0) {
+    std::vector<i2c_mock_transfer_t> transfers;
+    for (uint16_t i = first; i < i2c_mock_transfer_count(); i++) {
+        if (i2c_mock_get_transfer(i)->address == address) {
+            transfers.push_back(*i2c_mock_get_transfer(i));
+        }
+    }
+    return transfers;
+}
+
+#define IS31FL3731_ADDRESS (IS31FL3731_I2C_ADDRESS_1 << 1)
+#define OLED_ADDRESS (OLED_DISPLAY_ADDRESS << 1)
+// The control byte oled_driver.c sends before display data, the mock stores it as the register
+#define OLED_DATA 0x40
+
+// The index of the PWM chunk the transfer wrote
+uint16_t pwm_chunk(const i2c_mock_transfer_t &transfer) {
+    return (transfer.regaddr - IS31FL3731_FRAME_REG_PWM) / 16;
+}
+
+} // namespace
+
+class I2cAsync : public TestFixture {
+   public:
+    uint8_t data[4] = {1, 2, 3, 4};
+
+    void SetUp() override {
+        i2c_mock_reset();
+        completed.clear();
+    }
+
+    // The transactions are gone by now, so every test has to finish them.
+    void TearDown() override {
+        EXPECT_FALSE(i2c_mock_complete_transfer());
+        EXPECT_EQ(i2c_async_queue_depth(), 0);
+    }
+};
+
+TEST_F(I2cAsync, HigherPrioritiesGoFirst) {
+    auto led    = make_transaction(I2C_ASYNC_PRIORITY_LOW);
+    auto led2   = make_transaction(I2C_ASYNC_PRIORITY_LOW);
+    auto oled   = make_transaction(I2C_ASYNC_PRIORITY_NORMAL);
+    auto sensor = make_transaction(I2C_ASYNC_PRIORITY_HIGH);
+
+    i2c_mock_hold_transfers(true);
+    EXPECT_TRUE(i2c_async_write_register(&led, 0x10, 0x24, data, sizeof(data), 100));
+    EXPECT_TRUE(i2c_async_write_register(&led2, 0x11, 0x24, data, sizeof(data), 100));
+    EXPECT_TRUE(i2c_async_transmit(&oled, 0x20, data, sizeof(data), 100));
+    EXPECT_TRUE(i2c_async_read_register(&sensor, 0x30, 0x00, data, sizeof(data), 100));
+
+    // the first LED flush was already on the bus, the sensor read overtakes the rest
+    EXPECT_EQ(complete_all(), (std::vector<uint8_t>{0x10, 0x30, 0x20, 0x11}));
+    ASSERT_EQ(completed.size(), 4);
+    EXPECT_EQ(completed[1].first, &sensor);
+}
+
+TEST_F(I2cAsync, SamePriorityKeepsSubmitOrder) {
+    std::vector<i2c_async_transaction_t> transactions(I2C_ASYNC_QUEUE_LENGTH + 1, make_transaction(I2C_ASYNC_PRIORITY_NORMAL));
+
+    i2c_mock_hold_transfers(true);
+    for (uint8_t i = 0; i < transactions.size(); i++) {
+        EXPECT_TRUE(i2c_async_write_register(&transactions[i], 0x10 + i, 0, data, 1, 100));
+    }
+
+    EXPECT_EQ(complete_all(), (std::vector<uint8_t>{0x10, 0x11, 0x12, 0x13, 0x14}));
+}
+
+TEST_F(I2cAsync, FullQueueRejectsTransactions) {
+    std::vector<i2c_async_transaction_t> transactions(I2C_ASYNC_QUEUE_LENGTH + 2, make_transaction(I2C_ASYNC_PRIORITY_LOW));
+
+    i2c_mock_hold_transfers(true);
+    // one on the bus, the rest queued
+    for (uint8_t i = 0; i <= I2C_ASYNC_QUEUE_LENGTH; i++) {
+        EXPECT_TRUE(i2c_async_transmit(&transactions[i], i, data, 1, 100));
+    }
+    EXPECT_EQ(i2c_async_queue_depth(), I2C_ASYNC_QUEUE_LENGTH);
+
+    auto &overflow = transactions.back();
+    EXPECT_FALSE(i2c_async_transmit(&overflow, 0x40, data, 1, 100));
+    EXPECT_FALSE(i2c_async_is_pending(&overflow));
+    // still pending, its data must not change
+    EXPECT_FALSE(i2c_async_transmit(&transactions[1], 0x41, data, 1, 100));
+    EXPECT_EQ(transactions[1].address, 1);
+
+    ASSERT_TRUE(i2c_mock_complete_transfer());
+    i2c_async_task();
+    EXPECT_TRUE(i2c_async_transmit(&overflow, 0x40, data, 1, 100));
+    complete_all();
+}
+
+TEST_F(I2cAsync, CallbacksRunFromTask) {
+    TestDriver driver;
+    auto       sensor = make_transaction(I2C_ASYNC_PRIORITY_HIGH);
+
+    i2c_mock_hold_transfers(true);
+    i2c_mock_registers()[0x05] = 0x42;
+    uint8_t value              = 0;
+    EXPECT_TRUE(i2c_async_read_register(&sensor, 0x30, 0x05, &value, 1, 100));
+    EXPECT_TRUE(i2c_async_is_pending(&sensor));
+
+    ASSERT_TRUE(i2c_mock_complete_transfer());
+    EXPECT_EQ(value, 0x42);
+    EXPECT_TRUE(completed.empty()) << "callbacks should only run from i2c_async_task()";
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    ASSERT_EQ(completed.size(), 1);
+    EXPECT_EQ(completed[0].second, I2C_STATUS_SUCCESS);
+    EXPECT_FALSE(i2c_async_is_pending(&sensor));
+}
+
+TEST_F(I2cAsync, CallbacksReceiveErrors) {
+    auto led = make_transaction(I2C_ASYNC_PRIORITY_LOW);
+
+    i2c_mock_set_status(I2C_STATUS_TIMEOUT);
+    EXPECT_TRUE(i2c_async_write_register(&led, 0x10, 0x24, data, sizeof(data), 100));
+    i2c_async_wait(&led);
+
+    ASSERT_EQ(completed.size(), 1);
+    EXPECT_EQ(completed[0].second, I2C_STATUS_TIMEOUT);
+}
+
+TEST_F(I2cAsync, CallbacksCanSubmitAgain) {
+    // Writes a buffer a byte at a time, like a driver flushing its dirty chunks
+    static uint8_t written = 0;
+    written                = 0;
+
+    auto chunk     = make_transaction(I2C_ASYNC_PRIORITY_LOW);
+    chunk.context  = data;
+    chunk.callback = [](i2c_async_transaction_t *transaction, i2c_status_t status) {
+        if (++written < 4) {
+            uint8_t *buffer = (uint8_t *)transaction->context;
+            EXPECT_TRUE(i2c_async_write_register(transaction, 0x10, written, &buffer[written], 1, 100));
+        }
+    };
+
+    i2c_mock_hold_transfers(true);
+    EXPECT_TRUE(i2c_async_write_register(&chunk, 0x10, 0, &data[0], 1, 100));
+    complete_all();
+
+    EXPECT_EQ(written, 4);
+    EXPECT_EQ(i2c_mock_transfer_count(), 4);
+    EXPECT_EQ(i2c_mock_registers()[3], 4);
+}
+
+TEST_F(I2cAsync, FlushWaitsForEverything) {
+    std::vector<i2c_async_transaction_t> transactions(I2C_ASYNC_QUEUE_LENGTH, make_transaction(I2C_ASYNC_PRIORITY_NORMAL));
+
+    for (auto &transaction : transactions) {
+        EXPECT_TRUE(i2c_async_transmit(&transaction, 0x20, data, sizeof(data), 100));
+    }
+    i2c_async_flush();
+
+    EXPECT_EQ(i2c_async_queue_depth(), 0);
+    EXPECT_EQ(completed.size(), I2C_ASYNC_QUEUE_LENGTH);
+}
+
+class I2cAsyncIs31fl3731 : public I2cAsync {
+   public:
+    uint8_t brightness = 0;
+
+    // Starts every test from a driver with nothing left to send
+    void SetUp() override {
+        I2cAsync::SetUp();
+        is31fl3731_set_color_all(0, 0, 0);
+        is31fl3731_flush();
+        i2c_async_flush();
+        i2c_mock_reset();
+    }
+
+    // Changes every LED to a colour it hasn't had yet, making their chunks dirty
+    void set_all_dirty() {
+        brightness++;
+        is31fl3731_set_color_all(brightness, brightness, brightness);
+    }
+};
+
+TEST_F(I2cAsyncIs31fl3731, PwmChunksAreSentInOrder) {
+    i2c_mock_hold_transfers(true);
+    is31fl3731_set_color(2, 1, 2, 3);
+    is31fl3731_set_color(0, 4, 5, 6);
+    is31fl3731_set_color(1, 7, 8, 9);
+    is31fl3731_flush();
+    // only one chunk is queued at a time, the next one is queued when it finishes
+    EXPECT_EQ(i2c_async_queue_depth(), 0);
+    complete_all();
+
+    auto transfers = transfers_to(IS31FL3731_ADDRESS);
+    ASSERT_EQ(transfers.size(), 3);
+    EXPECT_EQ(pwm_chunk(transfers[0]), 0);
+    EXPECT_EQ(pwm_chunk(transfers[1]), 2);
+    EXPECT_EQ(pwm_chunk(transfers[2]), 8);
+    for (auto &transfer : transfers) {
+        EXPECT_EQ(transfer.length, 16);
+        EXPECT_FALSE(transfer.read);
+    }
+    EXPECT_EQ(i2c_mock_registers()[IS31FL3731_FRAME_REG_PWM + C1_1], 4);
+    EXPECT_EQ(i2c_mock_registers()[IS31FL3731_FRAME_REG_PWM + C3_10], 8);
+    EXPECT_EQ(i2c_mock_registers()[IS31FL3731_FRAME_REG_PWM + C9_5], 3);
+
+    // nothing is sent twice
+    is31fl3731_flush();
+    EXPECT_EQ(complete_all().size(), 3);
+}
+
+TEST_F(I2cAsyncIs31fl3731, FailedPwmChunkIsRetried) {
+    i2c_mock_hold_transfers(true);
+    set_all_dirty();
+    is31fl3731_flush();
+
+    // the first chunk fails, which stops the rest until the next flush
+    i2c_mock_set_status(I2C_STATUS_TIMEOUT);
+    ASSERT_TRUE(i2c_mock_complete_transfer());
+    i2c_mock_set_status(I2C_STATUS_SUCCESS);
+    i2c_async_task();
+    EXPECT_FALSE(i2c_mock_complete_transfer());
+
+    is31fl3731_flush();
+    complete_all();
+
+    auto transfers = transfers_to(IS31FL3731_ADDRESS);
+    ASSERT_EQ(transfers.size(), 4);
+    EXPECT_EQ(pwm_chunk(transfers[0]), 0);
+    EXPECT_EQ(pwm_chunk(transfers[1]), 0);
+    EXPECT_EQ(pwm_chunk(transfers[2]), 2);
+    EXPECT_EQ(pwm_chunk(transfers[3]), 8);
+    EXPECT_EQ(i2c_mock_registers()[IS31FL3731_FRAME_REG_PWM + C1_1], brightness);
+}
+
+TEST_F(I2cAsyncIs31fl3731, ChangesDuringAChunkAreSentAgain) {
+    i2c_mock_hold_transfers(true);
+    set_all_dirty();
+    is31fl3731_flush();
+
+    // the first chunk is already on the bus when its LED changes again, so it is sent once more before the others
+    set_all_dirty();
+    complete_all();
+
+    auto transfers = transfers_to(IS31FL3731_ADDRESS);
+    ASSERT_EQ(transfers.size(), 4);
+    EXPECT_EQ(pwm_chunk(transfers[0]), 0);
+    EXPECT_EQ(pwm_chunk(transfers[1]), 0);
+    EXPECT_EQ(pwm_chunk(transfers[2]), 2);
+    EXPECT_EQ(pwm_chunk(transfers[3]), 8);
+    EXPECT_EQ(i2c_mock_registers()[IS31FL3731_FRAME_REG_PWM + C1_1], brightness);
+
+    is31fl3731_flush();
+    EXPECT_EQ(complete_all().size(), 4);
+}
+
+class I2cAsyncOled : public I2cAsync {
+   public:
+    void SetUp() override {
+        I2cAsync::SetUp();
+        oled_init(OLED_ROTATION_0);
+        // Marks every block with its index, and makes them all dirty
+        for (uint8_t block = 0; block < OLED_BLOCK_COUNT; block++) {
+            oled_write_raw_byte(block + 1, block * OLED_BLOCK_SIZE);
+        }
+        i2c_mock_reset();
+    }
+};
+
+TEST_F(I2cAsyncOled, PositionAndDataStayPaired) {
+    auto    sensor = make_transaction(I2C_ASYNC_PRIORITY_HIGH);
+    uint8_t value  = 0;
+
+    i2c_mock_hold_transfers(true);
+    for (uint8_t block = 0; block < OLED_BLOCK_COUNT; block++) {
+        uint16_t first = i2c_mock_transfer_count();
+        oled_render_dirty(false);
+        // the position is on the bus and the data is queued, the read overtakes the data
+        EXPECT_TRUE(i2c_async_read_register(&sensor, 0x30, 0x00, &value, 1, 100));
+        EXPECT_EQ(complete_all().size(), first + 3);
+
+        auto oled = transfers_to(OLED_ADDRESS, first);
+        ASSERT_EQ(oled.size(), 2) << "block " << (int)block;
+        EXPECT_EQ(oled[0].regaddr, 0) << "block " << (int)block;
+        EXPECT_EQ(oled[1].regaddr, OLED_DATA) << "block " << (int)block;
+        EXPECT_EQ(oled[1].length, OLED_BLOCK_SIZE) << "block " << (int)block;
+        EXPECT_EQ(i2c_mock_get_transfer(first + 1)->address, 0x30) << "block " << (int)block;
+        EXPECT_EQ(i2c_mock_registers()[OLED_DATA], block + 1) << "block " << (int)block;
+    }
+
+    uint16_t count = i2c_mock_transfer_count();
+    oled_render_dirty(false);
+    EXPECT_EQ(complete_all().size(), count);
+}
+
+TEST_F(I2cAsyncOled, WaitsForRoomForPositionAndData) {
+    std::vector<i2c_async_transaction_t> transactions(I2C_ASYNC_QUEUE_LENGTH, make_transaction(I2C_ASYNC_PRIORITY_LOW));
+
+    // one on the bus, one slot left in the queue
+    i2c_mock_hold_transfers(true);
+    for (auto &transaction : transactions) {
+        EXPECT_TRUE(i2c_async_transmit(&transaction, 0x10, data, 1, 100));
+    }
+    oled_render_dirty(false);
+    EXPECT_EQ(i2c_async_queue_depth(), I2C_ASYNC_QUEUE_LENGTH - 1);
+
+    // once there is room for both, the block goes out as a pair
+    ASSERT_TRUE(i2c_mock_complete_transfer());
+    i2c_async_task();
+    oled_render_dirty(false);
+    complete_all();
+
+    auto oled = transfers_to(OLED_ADDRESS);
+    ASSERT_EQ(oled.size(), 2);
+    EXPECT_EQ(oled[0].regaddr, 0);
+    EXPECT_EQ(oled[1].regaddr, OLED_DATA);
+    EXPECT_EQ(i2c_mock_registers()[OLED_DATA], 1);
+
+    // the rest of the blocks aren't needed by the test
+    oled_clear();
+    oled_render_dirty(true);
+}
+
+TEST_F(I2cAsyncOled, FailedBlockIsRenderedAgain) {
+    i2c_mock_hold_transfers(true);
+    oled_render_dirty(false);
+    ASSERT_TRUE(i2c_mock_complete_transfer());
+    i2c_async_task();
+    // the data of the first block fails
+    i2c_mock_set_status(I2C_STATUS_TIMEOUT);
+    ASSERT_TRUE(i2c_mock_complete_transfer());
+    i2c_mock_set_status(I2C_STATUS_SUCCESS);
+    i2c_async_task();
+
+    uint16_t first = i2c_mock_transfer_count();
+    oled_render_dirty(false);
+    complete_all();
+
+    auto oled = transfers_to(OLED_ADDRESS, first);
+    ASSERT_EQ(oled.size(), 2);
+    EXPECT_EQ(oled[0].regaddr, 0);
+    EXPECT_EQ(oled[1].regaddr, OLED_DATA);
+    EXPECT_EQ(i2c_mock_registers()[OLED_DATA], 1);
+
+    oled_clear();
+    oled_render_dirty(true);
+}
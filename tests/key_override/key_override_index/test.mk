@@ -0,0 +1,7 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+SRC += tests/key_override/test_key_overrides.c
+SRC += tests/key_override/test_key_override.cpp
@@ -0,0 +1,246 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" bool ctrl_x_override_enabled;
+
+/**
+ * The overrides are defined in test_key_overrides.c. Built both with and without KEY_OVERRIDE_INDEX: the index must
+ * not change which override activates, or when.
+ */
+class KeyOverride : public TestFixture {
+   public:
+    KeymapKey key_a{0, 0, 0, KC_A};
+    KeymapKey key_bspc{0, 1, 0, KC_BSPC};
+    KeymapKey key_1{0, 2, 0, KC_1};
+    KeymapKey key_x{0, 3, 0, KC_X};
+    KeymapKey key_lsft{0, 4, 0, KC_LSFT};
+    KeymapKey key_lctl{0, 5, 0, KC_LCTL};
+    KeymapKey key_lalt{0, 6, 0, KC_LALT};
+    KeymapKey key_lgui{0, 7, 0, KC_LGUI};
+    KeymapKey key_mo{0, 8, 0, MO(1)};
+
+    void SetUp() override {
+        set_keymap({key_a, key_bspc, key_1, key_x, key_lsft, key_lctl, key_lalt, key_lgui, key_mo, KeymapKey(1, 0, 0, KC_A), KeymapKey(1, 5, 0, KC_TRNS), KeymapKey(1, 8, 0, KC_TRNS)});
+        ctrl_x_override_enabled = true;
+    }
+};
+
+TEST_F(KeyOverride, ShiftBackspaceSendsDelete) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_DELETE));
+    key_bspc.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_bspc.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, BackspaceWithoutShift) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_BSPC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_bspc);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, FirstMatchingOverrideWins) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    tap_key(key_1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, OnlyActivatesOnItsLayers) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    key_lctl.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LCTL, KC_A));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    tap_key(key_a);
+
+    EXPECT_NO_REPORT(driver);
+    key_mo.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    tap_key(key_a);
+
+    EXPECT_NO_REPORT(driver);
+    key_mo.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lctl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ModifiersAloneActivateOverrideWithoutTrigger) {
+    TestDriver driver;
+    InSequence s;
+
+    // no key was pressed within the default KEY_OVERRIDE_REPEAT_DELAY
+    idle_for(600);
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    key_lctl.press();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lalt.press();
+    run_one_scan_loop();
+
+    // a modifier activation is registered after 50 ms
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    idle_for(100);
+
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LALT));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    key_lalt.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lctl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, NegativeModifierPreventsActivation) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LALT));
+    key_lalt.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_REPORT(driver, (KC_LALT));
+    tap_key(key_x);
+
+    EXPECT_REPORT(driver, (KC_LALT, KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LALT, KC_LSFT, KC_X));
+    EXPECT_REPORT(driver, (KC_LALT, KC_LSFT));
+    tap_key(key_x);
+
+    EXPECT_REPORT(driver, (KC_LALT));
+    key_lsft.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lalt.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, OneModOption) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LGUI));
+    key_lgui.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_REPORT(driver, (KC_LGUI));
+    tap_key(key_x);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lgui.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, DisabledOverrideIsSkipped) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    key_lctl.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    tap_key(key_x);
+
+    ctrl_x_override_enabled = false;
+    EXPECT_REPORT(driver, (KC_LCTL, KC_X));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    tap_key(key_x);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lctl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ModifierPressedWhileTriggerHeld) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_BSPC));
+    key_bspc.press();
+    run_one_scan_loop();
+    // longer than the default KEY_OVERRIDE_REPEAT_DELAY
+    idle_for(600);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_DELETE));
+    idle_for(100);
+
+    // the trigger is registered again once shift is released
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.release();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_BSPC));
+    idle_for(100);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_bspc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,41 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+bool ctrl_x_override_enabled = true;
+
+const key_override_t shift_bspc_override  = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t shift_1_override     = ko_make_basic(MOD_MASK_SHIFT, KC_1, KC_2);
+const key_override_t shift_1_late_override = ko_make_basic(MOD_MASK_SHIFT, KC_1, KC_3);
+const key_override_t ctrl_a_override      = ko_make_with_layers(MOD_MASK_CTRL, KC_A, KC_B, 1 << 1);
+const key_override_t ctrl_alt_override    = ko_make_basic(MOD_MASK_CA, KC_NO, KC_ESC);
+const key_override_t alt_x_override       = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_X, KC_Y, ~0, MOD_MASK_SHIFT);
+const key_override_t gui_x_override       = ko_make_with_layers_negmods_and_options(MOD_MASK_GUI, KC_X, KC_Z, ~0, 0, ko_option_one_mod | ko_options_all_activations);
+
+key_override_t ctrl_x_override = {
+    .trigger           = KC_X,
+    .trigger_mods      = MOD_MASK_CTRL,
+    .layers            = ~0,
+    .negative_mod_mask = 0,
+    .suppressed_mods   = MOD_MASK_CTRL,
+    .replacement       = KC_C,
+    .options           = ko_options_default,
+    .custom_action     = NULL,
+    .context           = NULL,
+    .enabled           = &ctrl_x_override_enabled,
+};
+
+// clang-format off
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &shift_bspc_override,
+    &shift_1_override,
+    &shift_1_late_override,
+    &ctrl_a_override,
+    &ctrl_alt_override,
+    &alt_x_override,
+    &gui_x_override,
+    &ctrl_x_override,
+    NULL
+};
+// clang-format on
@@ -0,0 +1,84 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keycode_dispatch.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class KeycodeDispatch : public TestFixture {};
+
+TEST_F(KeycodeDispatch, MapsKeycodesOfEnabledHandlers) {
+    EXPECT_EQ(keycode_dispatch_handler(KC_A), KEYCODE_DISPATCH_NONE);
+    EXPECT_EQ(keycode_dispatch_handler(KC_LEFT_SHIFT), KEYCODE_DISPATCH_NONE);
+    EXPECT_EQ(keycode_dispatch_handler(LT(1, KC_A)), KEYCODE_DISPATCH_NONE);
+    EXPECT_EQ(keycode_dispatch_handler(QK_BOOTLOADER), KEYCODE_DISPATCH_NONE);
+
+    EXPECT_EQ(keycode_dispatch_handler(QK_GRAVE_ESCAPE), KEYCODE_DISPATCH_GRAVE_ESC);
+    EXPECT_EQ(keycode_dispatch_handler(QK_MAGIC), KEYCODE_DISPATCH_MAGIC);
+    EXPECT_EQ(keycode_dispatch_handler(QK_MAGIC_MAX), KEYCODE_DISPATCH_MAGIC);
+    EXPECT_EQ(keycode_dispatch_handler(QK_DYNAMIC_TAPPING_TERM_UP), KEYCODE_DISPATCH_DYNAMIC_TAPPING_TERM);
+    EXPECT_EQ(keycode_dispatch_handler(QK_TRI_LAYER_LOWER), KEYCODE_DISPATCH_TRI_LAYER);
+    EXPECT_EQ(keycode_dispatch_handler(QK_TRI_LAYER_UPPER), KEYCODE_DISPATCH_TRI_LAYER);
+}
+
+TEST_F(KeycodeDispatch, DisabledHandlersAreNotMapped) {
+    EXPECT_EQ(keycode_dispatch_handler(QK_SEQUENCER_ON), KEYCODE_DISPATCH_NONE);
+    EXPECT_EQ(keycode_dispatch_handler(QK_JOYSTICK), KEYCODE_DISPATCH_NONE);
+    EXPECT_EQ(keycode_dispatch_handler(RGB_TOG), KEYCODE_DISPATCH_NONE);
+    EXPECT_EQ(keycode_dispatch_handler(QK_BACKLIGHT_ON), KEYCODE_DISPATCH_NONE);
+}
+
+TEST_F(KeycodeDispatch, DispatchedHandlersStillProcessTheirKeycodes) {
+    TestDriver driver;
+    KeymapKey  grave_esc  = KeymapKey(0, 0, 0, QK_GRAVE_ESCAPE);
+    KeymapKey  dt_up      = KeymapKey(0, 1, 0, QK_DYNAMIC_TAPPING_TERM_UP);
+    KeymapKey  tl_lower   = KeymapKey(0, 2, 0, QK_TRI_LAYER_LOWER);
+    KeymapKey  magic_swap = KeymapKey(0, 3, 0, QK_MAGIC_SWAP_CONTROL_CAPS_LOCK);
+
+    set_keymap({grave_esc, dt_up, tl_lower, magic_swap, KeymapKey(1, 2, 0, KC_TRNS)});
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(grave_esc);
+    VERIFY_AND_CLEAR(driver);
+
+    uint16_t tapping_term = g_tapping_term;
+    EXPECT_NO_REPORT(driver);
+    tap_key(dt_up);
+    EXPECT_EQ(g_tapping_term, tapping_term + DYNAMIC_TAPPING_TERM_INCREMENT);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    tl_lower.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    tl_lower.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(magic_swap);
+    EXPECT_TRUE(keymap_config.swap_control_capslock);
+    VERIFY_AND_CLEAR(driver);
+    keymap_config.swap_control_capslock = false;
+    eeconfig_update_keymap(keymap_config.raw);
+}
+
+TEST_F(KeycodeDispatch, OtherKeycodesPassThrough) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
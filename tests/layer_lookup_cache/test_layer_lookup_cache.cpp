@@ -0,0 +1,108 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCache : public TestFixture {};
+
+TEST_F(LayerLookupCache, ResolvesTransparentKeysThroughLayerStack) {
+    TestDriver driver;
+    KeymapKey  key_a       = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b_trans = KeymapKey(1, 0, 0, KC_TRNS);
+    KeymapKey  key_c       = KeymapKey(2, 0, 0, KC_C);
+
+    set_keymap({key_a, key_b_trans, key_c});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, FollowsDefaultLayerChanges) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b = KeymapKey(1, 0, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    default_layer_set(1 << 1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    default_layer_set(1 << 0);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, InvalidateAfterKeymapChange) {
+    TestDriver driver;
+    KeymapKey  key_a       = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b_trans = KeymapKey(1, 0, 0, KC_TRNS);
+
+    set_keymap({key_a, key_b_trans});
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* Replacing the keymap invalidates the cache through TestFixture::add_key. */
+    KeymapKey key_b = KeymapKey(1, 0, 0, KC_B);
+    set_keymap({key_a, key_b});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, MomentaryLayerKeyReleasesFromSourceLayer) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  layer_key = KeymapKey(0, 0, 0, MO(1));
+    KeymapKey  key_a     = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey  key_b     = KeymapKey(1, 1, 0, KC_B);
+
+    set_keymap({layer_key, key_a, key_b, KeymapKey(1, 0, 0, KC_TRNS)});
+
+    /* Press key_a on layer 0 to populate the cache. */
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Activate layer 1, the same position must now resolve to KC_B. */
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Releasing the layer key first must still release KC_B. */
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,24 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Deliberately out of order, the table is sorted when first used.
+const leader_sequence_t leader_sequences[] PROGMEM = {
+    LEADER_SEQUENCE(KC_5, KC_A, KC_B, KC_C, KC_D, KC_E),
+    LEADER_SEQUENCE(KC_7, KC_C, KC_C, KC_C),
+    LEADER_SEQUENCE(KC_1, KC_A),
+    LEADER_SEQUENCE(KC_3, KC_A, KC_B, KC_C),
+    LEADER_SEQUENCE(KC_6, KC_B),
+    LEADER_SEQUENCE(KC_2, KC_A, KC_B),
+    LEADER_SEQUENCE(KC_4, KC_A, KC_B, KC_C, KC_D),
+    LEADER_SEQUENCE(KC_NO, KC_C, KC_B),
+};
+
+bool leader_sequence_matched_user(uint16_t index) {
+    // C, B is handled here instead of with a keycode
+    if (leader_sequence_two_keys(KC_C, KC_B)) {
+        tap_code(KC_8);
+    }
+    return true;
+}
@@ -0,0 +1,131 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+class LeaderSequenceTable : public TestFixture {
+   public:
+    KeymapKey key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    KeymapKey key_a      = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey key_b      = KeymapKey(0, 2, 0, KC_B);
+    KeymapKey key_c      = KeymapKey(0, 3, 0, KC_C);
+    KeymapKey key_d      = KeymapKey(0, 4, 0, KC_D);
+    KeymapKey key_e      = KeymapKey(0, 5, 0, KC_E);
+
+    void SetUp() override {
+        set_keymap({key_leader, key_a, key_b, key_c, key_d, key_e});
+    }
+};
+
+TEST_F(LeaderSequenceTable, prefix_of_longer_sequence_waits_for_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderSequenceTable, unique_sequence_ends_immediately) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_6));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, longest_sequence_ends_immediately) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+    tap_key(key_c);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_5));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_e);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderSequenceTable, unmatched_sequence_ends_immediately) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, unmatched_prefix_times_out_silently) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_c);
+    tap_key(key_c);
+    EXPECT_EQ(leader_sequence_active(), true);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderSequenceTable, sequence_handled_by_callback) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    VERIFY_AND_CLEAR(driver);
+
+    // C is a prefix of C, C, C, so only B ends the sequence
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_8));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
@@ -0,0 +1,12 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Large synthetic matrix, spanning more than one 32-bit word of rows
+#undef MATRIX_ROWS
+#undef MATRIX_COLS
+#define MATRIX_ROWS 40
+#define MATRIX_COLS 32
@@ -0,0 +1,142 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+#include "test_matrix.h"
+
+extern "C" {
+#include "keyboard.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::InSequence;
+
+class MatrixScan : public ::testing::WithParamInterface<bool>, public TestFixture {
+   public:
+    void SetUp() override {
+        set_publish_changed_rows(GetParam());
+    }
+
+    void TearDown() override {
+        set_publish_changed_rows(true);
+    }
+
+    /* Runs keyboard_task the given number of times and returns the achieved scans per second. */
+    template <typename F>
+    double scans_per_second(unsigned scans, F &&before_scan) {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < scans; i++) {
+            before_scan(i);
+            keyboard_task();
+            advance_time(1);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return scans / elapsed.count();
+    }
+
+    void report(const char *name, double rate) {
+        std::cout << "[ BENCHMARK] " << name << " (" << (GetParam() ? "published rows" : "row compare") << "): " << (unsigned long)rate << " scans/s" << std::endl;
+        RecordProperty(name, (int)rate);
+    }
+};
+
+TEST_P(MatrixScan, ChangesInSeveralRowsAndWordsInOneScan) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, MATRIX_COLS - 1, 5, KC_B);
+    auto       key_c = KeymapKey(0, 7, 33, KC_C);
+    auto       key_d = KeymapKey(0, 31, MATRIX_ROWS - 1, KC_D);
+
+    set_keymap({key_a, key_b, key_c, key_d});
+
+    /* Events are processed row by row, lowest column first. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    key_d.press();
+    key_c.press();
+    key_b.press();
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    key_d.release();
+    key_c.release();
+    key_b.release();
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(MatrixScan, BenchmarkIdle) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    report("idle", scans_per_second(200000, [](unsigned) {}));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(MatrixScan, BenchmarkToggleOneKeyPerScan) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, MATRIX_COLS / 2, MATRIX_ROWS / 2, KC_NO);
+
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    report("toggle", scans_per_second(200000, [&](unsigned i) {
+               /* Bypass KeymapKey to keep the test logger out of the measurement. */
+               if (i & 1) {
+                   release_key(key.position.col, key.position.row);
+               } else {
+                   press_key(key.position.col, key.position.row);
+               }
+           }));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(MatrixScan, BenchmarkHeldKeysWithToggle) {
+    TestDriver             driver;
+    std::vector<KeymapKey> held;
+    auto                   key = KeymapKey(0, MATRIX_COLS - 1, MATRIX_ROWS - 3, KC_NO);
+
+    /* Hold one key in every row, then toggle another on top of it. */
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        held.emplace_back(0, (row * 7) % (MATRIX_COLS - 1), row, KC_NO);
+    }
+    for (auto &k : held) {
+        add_key(k);
+        k.press();
+    }
+    add_key(key);
+    run_one_scan_loop();
+
+    EXPECT_NO_REPORT(driver);
+    report("held", scans_per_second(200000, [&](unsigned i) {
+               /* Bypass KeymapKey to keep the test logger out of the measurement. */
+               if (i & 1) {
+                   release_key(key.position.col, key.position.row);
+               } else {
+                   press_key(key.position.col, key.position.row);
+               }
+           }));
+    for (auto &k : held) {
+        k.release();
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+INSTANTIATE_TEST_CASE_P(ChangedRows, MatrixScan, ::testing::Bool(), [](const ::testing::TestParamInfo<bool> &info) { return info.param ? "Published" : "Compared"; });
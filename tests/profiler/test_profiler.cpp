@@ -0,0 +1,175 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <functional>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "profiler.h"
+
+void advance_ticks(uint32_t us);
+}
+
+using testing::_;
+
+namespace {
+
+std::function<void(keyrecord_t*)> on_record = [](keyrecord_t* record) {};
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t* record) {
+    on_record(record);
+    return true;
+}
+
+class Profiler : public TestFixture {
+   public:
+    void SetUp() override {
+        profiler_reset();
+        on_record = [](keyrecord_t* record) {};
+    }
+
+    profiler_stats_t stats(profiler_stage_t stage) {
+        profiler_stats_t stats;
+        EXPECT_TRUE(profiler_get_stats(stage, &stats));
+        return stats;
+    }
+};
+
+TEST_F(Profiler, CountsEveryPass) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(stats(PROFILER_STAGE_MATRIX).count, 10);
+    EXPECT_EQ(stats(PROFILER_STAGE_QUANTUM).count, 10);
+    EXPECT_EQ(stats(PROFILER_STAGE_LED).count, 10);
+    EXPECT_EQ(stats(PROFILER_STAGE_KEYBOARD_TASK).count, 10);
+    EXPECT_EQ(stats(PROFILER_STAGE_KEYBOARD_TASK).max, 0);
+}
+
+TEST_F(Profiler, AttributesTimeToTheStageThatSpentIt) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    // Key events are processed as part of matrix_task()
+    on_record = [](keyrecord_t* record) { advance_ticks(record->event.pressed ? 300 : 100); };
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    auto matrix = stats(PROFILER_STAGE_MATRIX);
+    EXPECT_EQ(matrix.count, 4);
+    EXPECT_EQ(matrix.min, 0);
+    EXPECT_EQ(matrix.max, 300);
+    EXPECT_EQ(matrix.avg, 100);
+
+    EXPECT_EQ(stats(PROFILER_STAGE_QUANTUM).max, 0);
+    EXPECT_EQ(stats(PROFILER_STAGE_KEYBOARD_TASK).max, 300);
+}
+
+TEST_F(Profiler, PercentileIgnoresRareOutliers) {
+    for (int i = 0; i < 1000; i++) {
+        profiler_begin();
+        advance_ticks(i < 5 ? 1000 : 20);
+        profiler_mark(PROFILER_STAGE_QUANTUM);
+        profiler_end();
+    }
+
+    auto quantum = stats(PROFILER_STAGE_QUANTUM);
+    EXPECT_EQ(quantum.count, 1000);
+    EXPECT_EQ(quantum.min, 20);
+    EXPECT_EQ(quantum.max, 1000);
+    EXPECT_EQ(quantum.avg, (5 * 1000 + 995 * 20) / 1000);
+    // 20us falls in the [16, 32) bucket
+    EXPECT_EQ(quantum.p99, 31);
+}
+
+TEST_F(Profiler, PercentileFollowsSlowTail) {
+    for (int i = 0; i < 1000; i++) {
+        profiler_begin();
+        advance_ticks(i < 50 ? 1000 : 20);
+        profiler_mark(PROFILER_STAGE_QUANTUM);
+        profiler_end();
+    }
+
+    // 1000us falls in the [512, 1024) bucket, which is clamped to the observed maximum
+    EXPECT_EQ(stats(PROFILER_STAGE_QUANTUM).p99, 1000);
+}
+
+TEST_F(Profiler, HistogramSurvivesSaturation) {
+    for (int i = 0; i < 70000; i++) {
+        profiler_begin();
+        profiler_mark(PROFILER_STAGE_QUANTUM);
+        profiler_end();
+    }
+
+    auto quantum = stats(PROFILER_STAGE_QUANTUM);
+    EXPECT_EQ(quantum.count, 70000);
+    EXPECT_EQ(quantum.p99, 0);
+}
+
+TEST_F(Profiler, MarksOutsideOfAPassAreIgnored) {
+    profiler_mark(PROFILER_STAGE_MATRIX);
+    profiler_end();
+
+    EXPECT_EQ(stats(PROFILER_STAGE_MATRIX).count, 0);
+    EXPECT_EQ(stats(PROFILER_STAGE_KEYBOARD_TASK).count, 0);
+
+    profiler_stats_t unused;
+    EXPECT_FALSE(profiler_get_stats(PROFILER_STAGE_COUNT, &unused));
+}
+
+TEST_F(Profiler, RawHidCommands) {
+    uint8_t data[32];
+
+    profiler_begin();
+    advance_ticks(0x01020304);
+    profiler_mark(PROFILER_STAGE_MATRIX);
+    profiler_end();
+
+    memset(data, 0, sizeof(data));
+    data[0] = 0x00;
+    EXPECT_FALSE(profiler_raw_hid_command(data, sizeof(data)));
+
+    data[0] = PROFILER_RAW_HID_COMMAND_ID;
+    data[1] = id_profiler_get_stage_count;
+    EXPECT_TRUE(profiler_raw_hid_command(data, sizeof(data)));
+    EXPECT_EQ(data[2], PROFILER_STAGE_COUNT);
+
+    data[1] = id_profiler_get_stage_name;
+    data[2] = PROFILER_STAGE_KEYBOARD_TASK;
+    EXPECT_TRUE(profiler_raw_hid_command(data, sizeof(data)));
+    EXPECT_STREQ((const char*)&data[3], "keyboard_task");
+
+    data[1] = id_profiler_get_stage_stats;
+    data[2] = PROFILER_STAGE_MATRIX;
+    EXPECT_TRUE(profiler_raw_hid_command(data, sizeof(data)));
+    const uint8_t expected[] = {
+        0x00, 0x00, 0x00, 0x01, // count
+        0x01, 0x02, 0x03, 0x04, // min
+        0x01, 0x02, 0x03, 0x04, // avg
+        0x01, 0x02, 0x03, 0x04, // max
+        0x01, 0x02, 0x03, 0x04, // p99
+    };
+    EXPECT_EQ(memcmp(&data[3], expected, sizeof(expected)), 0);
+
+    data[2] = PROFILER_STAGE_COUNT;
+    EXPECT_TRUE(profiler_raw_hid_command(data, sizeof(data)));
+    EXPECT_EQ(data[1], 0xFF);
+
+    data[1] = id_profiler_reset;
+    EXPECT_TRUE(profiler_raw_hid_command(data, sizeof(data)));
+    EXPECT_EQ(stats(PROFILER_STAGE_MATRIX).count, 0);
+}
+
+} // namespace
@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// One for the dirty rectangle tests, one to draw text on
+#define SURFACE_NUM_DEVICES 2
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SURFACE_NUM_DEVICES 2
+
+// Room for every glyph the tests draw
+#define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 2048
@@ -0,0 +1,220 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal_driver.h"
+#include "qp_comms_dummy.h"
+#include "qp_draw.h"
+#include "qp_stream.h"
+}
+
+namespace {
+
+// Pixel data the decoder sent, one 16-bit value per pixel: the palette index for palette formats, the pixel itself
+// for native ones
+std::vector<uint16_t> pixdata;
+uint32_t              pixdata_calls;
+
+bool target_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    uint16_t *buf = (uint16_t *)target_buffer;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = palette_indices[i];
+    }
+    return true;
+}
+
+bool target_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+bool target_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    const uint16_t *pixels = (const uint16_t *)pixel_data;
+    pixdata.insert(pixdata.end(), pixels, pixels + native_pixel_count);
+    pixdata_calls++;
+    return true;
+}
+
+const painter_driver_vtable_t target_vtable = {
+    .pixdata        = target_pixdata,
+    .append_pixels  = target_append_pixels,
+    .append_pixdata = target_append_pixdata,
+};
+
+painter_driver_t target = {
+    .driver_vtable         = &target_vtable,
+    .comms_vtable          = &dummy_comms_vtable,
+    .validate_ok           = true,
+    .panel_width           = 64,
+    .panel_height          = 64,
+    .native_bits_per_pixel = 16,
+};
+
+// A stream that is not a memory stream, so that the decoder has to go through the byte input callback
+struct byte_stream_t {
+    qp_stream_t          base;
+    std::vector<uint8_t> data;
+    size_t               position;
+};
+
+int16_t byte_stream_get(qp_stream_t *stream) {
+    byte_stream_t *s = (byte_stream_t *)stream;
+    return s->position < s->data.size() ? s->data[s->position++] : STREAM_EOF;
+}
+
+bool byte_stream_is_eof(qp_stream_t *stream) {
+    byte_stream_t *s = (byte_stream_t *)stream;
+    return s->position >= s->data.size();
+}
+
+// Palette indices with runs of a single value, some longer than an RLE run can hold, in between changing ones
+std::vector<uint8_t> make_indices(uint8_t bpp, uint32_t count) {
+    std::vector<uint8_t> indices;
+    uint32_t             random = 1;
+    for (uint32_t i = 0; i < count; ++i) {
+        random = random * 1103515245 + 12345;
+        switch ((i / 150) % 3) {
+            case 0:
+                indices.push_back((random >> 16) & ((1 << bpp) - 1));
+                break;
+            case 1:
+                indices.push_back(1);
+                break;
+            default:
+                indices.push_back((i / 40) & ((1 << bpp) - 1));
+                break;
+        }
+    }
+    return indices;
+}
+
+// Packs the indices as QGF stores them, least significant bits first
+std::vector<uint8_t> pack(const std::vector<uint8_t> &indices, uint8_t bpp) {
+    const uint8_t        pixels_per_byte = 8 / bpp;
+    std::vector<uint8_t> packed((indices.size() + pixels_per_byte - 1) / pixels_per_byte);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        packed[i / pixels_per_byte] |= indices[i] << ((i % pixels_per_byte) * bpp);
+    }
+    return packed;
+}
+
+// QGF run-length encoding: a marker below 128 repeats the following byte that many times, a marker of 128 or more
+// is followed by (marker - 127) bytes to be copied
+std::vector<uint8_t> rle_encode(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> encoded;
+    size_t               i = 0;
+    while (i < data.size()) {
+        size_t run = 1;
+        while (i + run < data.size() && run < 127 && data[i + run] == data[i]) {
+            run++;
+        }
+        if (run >= 3) {
+            encoded.push_back(run);
+            encoded.push_back(data[i]);
+            i += run;
+            continue;
+        }
+        size_t literal = 0;
+        while (i + literal < data.size() && literal < 128 && !(i + literal + 2 < data.size() && data[i + literal] == data[i + literal + 1] && data[i + literal] == data[i + literal + 2])) {
+            literal++;
+        }
+        encoded.push_back(127 + literal);
+        encoded.insert(encoded.end(), data.begin() + i, data.begin() + i + literal);
+        i += literal;
+    }
+    return encoded;
+}
+
+} // namespace
+
+// Bits per pixel, RLE compressed, read from a memory stream
+using codec_param_t = std::tuple<uint8_t, bool, bool>;
+
+class CodecBlocks : public testing::TestWithParam<codec_param_t> {
+   protected:
+    void SetUp() override {
+        pixdata.clear();
+        pixdata_calls = 0;
+    }
+
+    uint8_t bpp() const {
+        return std::get<0>(GetParam());
+    }
+
+    // Decodes the data with qp_internal_appender, as images and fonts are drawn
+    bool append(const std::vector<uint8_t> &raw, uint8_t asset_bpp, uint32_t pixel_count) {
+        bool                 rle  = std::get<1>(GetParam());
+        std::vector<uint8_t> data = rle ? rle_encode(raw) : raw;
+
+        qp_internal_byte_input_state_t  input_state = {.device = (painter_device_t)&target};
+        qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, rle ? IMAGE_COMPRESSED_RLE : IMAGE_UNCOMPRESSED);
+
+        if (std::get<2>(GetParam())) {
+            qp_memory_stream_t stream = qp_make_memory_stream(data.data(), data.size());
+            input_state.src_stream    = (qp_stream_t *)&stream;
+            return qp_internal_appender((painter_device_t)&target, asset_bpp, pixel_count, input_callback, &input_state);
+        }
+
+        byte_stream_t stream   = {};
+        stream.base.get        = byte_stream_get;
+        stream.base.is_eof     = byte_stream_is_eof;
+        stream.data            = data;
+        input_state.src_stream = &stream.base;
+        return qp_internal_appender((painter_device_t)&target, asset_bpp, pixel_count, input_callback, &input_state);
+    }
+};
+
+TEST_P(CodecBlocks, PaletteImage) {
+    // Not a multiple of the block size, nor of the pixels per byte, and more than the pixdata buffer holds
+    const uint32_t       pixel_count = 37 * 29;
+    std::vector<uint8_t> indices     = make_indices(bpp(), pixel_count);
+
+    ASSERT_TRUE(append(pack(indices, bpp()), bpp(), pixel_count));
+
+    EXPECT_EQ(pixdata, std::vector<uint16_t>(indices.begin(), indices.end()));
+    // Every buffer but the last is sent full
+    uint32_t buffer_pixels = qp_internal_num_pixels_in_buffer((painter_device_t)&target);
+    EXPECT_EQ(pixdata_calls, (pixel_count + buffer_pixels - 1) / buffer_pixels);
+}
+
+TEST_P(CodecBlocks, SinglePixel) {
+    std::vector<uint8_t> indices = {(uint8_t)((1 << bpp()) - 1)};
+
+    ASSERT_TRUE(append(pack(indices, bpp()), bpp(), 1));
+
+    EXPECT_EQ(pixdata, std::vector<uint16_t>{indices[0]});
+}
+
+TEST_P(CodecBlocks, TruncatedDataFails) {
+    const uint32_t       pixel_count = 200;
+    std::vector<uint8_t> packed      = pack(make_indices(bpp(), pixel_count), bpp());
+    packed.resize(packed.size() / 2);
+
+    EXPECT_FALSE(append(packed, bpp(), pixel_count));
+}
+
+TEST_P(CodecBlocks, NativeImage) {
+    // Native data is streamed as-is, whatever the palette format under test
+    const uint32_t        pixel_count = 700;
+    std::vector<uint16_t> pixels;
+    std::vector<uint8_t>  raw;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        pixels.push_back((i / 50) % 2 ? 0xF800 : i * 7 * bpp());
+        raw.push_back(pixels.back() & 0xFF);
+        raw.push_back(pixels.back() >> 8);
+    }
+
+    ASSERT_TRUE(append(raw, 16, pixel_count));
+
+    EXPECT_EQ(pixdata, pixels);
+}
+
+INSTANTIATE_TEST_CASE_P(Formats, CodecBlocks, testing::Combine(testing::Values(1, 2, 4, 8), testing::Bool(), testing::Bool()), [](const testing::TestParamInfo<codec_param_t> &info) {
+    return std::to_string(std::get<0>(info.param)) + "bpp" + (std::get<1>(info.param) ? "Rle" : "Raw") + (std::get<2>(info.param) ? "Memory" : "Stream");
+});
@@ -0,0 +1,173 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Built without a glyph cache here, and with a large and a small one in the glyph_cache_* subdirectories. Whichever
+// it is, the text drawn must be the same.
+
+#include <string>
+#include "test_common.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+#include "thintel15.qff.h"
+}
+
+namespace {
+
+// "QMK" in thintel15 is 16 pixels wide, the font's lines are 11 pixels high. Its glyphs take 112, 132 and 112 bytes
+// once converted to RGB565 and aligned.
+#define SURFACE_WIDTH 16
+#define SURFACE_HEIGHT 11
+
+const char *const QMK = "QMK";
+
+const char *const QMK_PIXELS =
+    "................\n"
+    ".##..#...#.#..#.\n"
+    "#..#.##.##.#..#.\n"
+    "#..#.#.#.#.#.#..\n"
+    "#..#.#...#.##...\n"
+    "#..#.#...#.#.#..\n"
+    "#.#..#...#.#..#.\n"
+    ".#.#.#...#.#..#.\n"
+    "................\n"
+    "................\n"
+    "................\n";
+
+uint8_t          buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 16)];
+painter_device_t surface;
+
+// The surface's pixels, '#' for the foreground and '.' for the background
+std::string surface_pixels() {
+    const uint16_t *pixels = (const uint16_t *)buffer;
+    std::string     text;
+    for (int y = 0; y < SURFACE_HEIGHT; y++) {
+        for (int x = 0; x < SURFACE_WIDTH; x++) {
+            text += pixels[y * SURFACE_WIDTH + x] ? '#' : '.';
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+} // namespace
+
+class GlyphCache : public testing::Test {
+   public:
+    static void SetUpTestSuite() {
+        surface = qp_make_rgb565_surface(SURFACE_WIDTH, SURFACE_HEIGHT, buffer);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        qp_glyph_cache_clear();
+        font = qp_load_font_mem(font_thintel15);
+        ASSERT_NE(font, nullptr);
+    }
+
+    void TearDown() override {
+        if (font) {
+            qp_close_font(font);
+        }
+    }
+
+    std::string draw(const char *str) {
+        memset(buffer, 0, sizeof(buffer));
+        EXPECT_EQ(qp_drawtext(surface, 0, 0, font, str), qp_textwidth(font, str));
+        return surface_pixels();
+    }
+
+    void expect_stats(uint32_t hits, uint32_t misses, uint32_t evictions, uint16_t entries) {
+        painter_glyph_cache_stats_t stats = qp_glyph_cache_get_stats();
+        EXPECT_EQ(stats.hits, hits);
+        EXPECT_EQ(stats.misses, misses);
+        EXPECT_EQ(stats.evictions, evictions);
+        EXPECT_EQ(stats.entries, entries);
+        EXPECT_LE(stats.bytes_used, QUANTUM_PAINTER_GLYPH_CACHE_SIZE);
+    }
+
+    painter_font_handle_t font;
+};
+
+TEST_F(GlyphCache, ColdAndWarmCacheDrawTheSame) {
+    EXPECT_EQ(draw(QMK), QMK_PIXELS);
+    EXPECT_EQ(draw(QMK), QMK_PIXELS);
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE == 0
+    expect_stats(0, 0, 0, 0);
+#elif QUANTUM_PAINTER_GLYPH_CACHE_SIZE < 356
+    // Only two of the three glyphs fit, each one evicts the glyph needed next
+    expect_stats(0, 6, 4, 2);
+#else
+    expect_stats(3, 3, 0, 3);
+#endif
+}
+
+TEST_F(GlyphCache, RepeatedGlyphsAreDecodedOnce) {
+    memset(buffer, 0, sizeof(buffer));
+    EXPECT_EQ(qp_drawtext(surface, 0, 0, font, "MM"), 12);
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE == 0
+    expect_stats(0, 0, 0, 0);
+#else
+    expect_stats(1, 1, 0, 1);
+#endif
+}
+
+TEST_F(GlyphCache, ColorsAreCachedSeparately) {
+    memset(buffer, 0, sizeof(buffer));
+    EXPECT_EQ(qp_drawtext_recolor(surface, 0, 0, font, "M", 0, 255, 255, 0, 0, 0), 6);
+    std::string red = surface_pixels();
+    EXPECT_EQ(draw("M"), red);
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE == 0
+    expect_stats(0, 0, 0, 0);
+#else
+    expect_stats(0, 2, 0, 2);
+#endif
+}
+
+TEST_F(GlyphCache, TextRunDrawsTheSame) {
+    uint8_t            run_buffer[QP_TEXTRUN_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 16)];
+    painter_text_run_t run;
+    ASSERT_TRUE(qp_textrun_prepare(surface, &run, run_buffer, sizeof(run_buffer), font, QMK, 0, 0, 255, 0, 0, 0));
+    EXPECT_EQ(run.width, SURFACE_WIDTH);
+    EXPECT_EQ(run.height, SURFACE_HEIGHT);
+
+    memset(buffer, 0, sizeof(buffer));
+    EXPECT_EQ(qp_textrun_draw(surface, 0, 0, &run), SURFACE_WIDTH);
+    EXPECT_EQ(surface_pixels(), QMK_PIXELS);
+
+    // Text runs are rendered on their own, without going through the cache
+    expect_stats(0, 0, 0, 0);
+}
+
+TEST_F(GlyphCache, TextRunBufferTooSmall) {
+    uint8_t            run_buffer[QP_TEXTRUN_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 16) - 1];
+    painter_text_run_t run;
+    EXPECT_FALSE(qp_textrun_prepare(surface, &run, run_buffer, sizeof(run_buffer), font, QMK, 0, 0, 255, 0, 0, 0));
+}
+
+TEST_F(GlyphCache, ClosingTheFontDropsItsGlyphs) {
+    EXPECT_EQ(draw(QMK), QMK_PIXELS);
+    ASSERT_TRUE(qp_close_font(font));
+    font = nullptr;
+
+    painter_glyph_cache_stats_t stats = qp_glyph_cache_get_stats();
+    EXPECT_EQ(stats.entries, 0);
+    EXPECT_EQ(stats.bytes_used, 0);
+
+    // The handle is reused by the next font loaded, which must not be drawn with the closed font's glyphs
+    font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+    EXPECT_EQ(draw(QMK), QMK_PIXELS);
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE == 0
+    expect_stats(0, 0, 0, 0);
+#elif QUANTUM_PAINTER_GLYPH_CACHE_SIZE < 356
+    expect_stats(0, 6, 2, 2);
+#else
+    expect_stats(0, 6, 0, 3);
+#endif
+}
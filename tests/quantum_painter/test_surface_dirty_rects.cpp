@@ -0,0 +1,159 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal_driver.h"
+#include "qp_comms_dummy.h"
+#include "qp_surface.h"
+}
+
+namespace {
+
+#define SURFACE_SIZE 32
+
+struct transfer_t {
+    uint16_t l, t, r, b;
+    uint32_t pixels;
+
+    bool operator==(const transfer_t &other) const {
+        return l == other.l && t == other.t && r == other.r && b == other.b && pixels == other.pixels;
+    }
+    bool operator<(const transfer_t &other) const {
+        return std::tie(t, l, b, r) < std::tie(other.t, other.l, other.b, other.r);
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const transfer_t &transfer) {
+    return os << "{" << transfer.l << "," << transfer.t << "," << transfer.r << "," << transfer.b << " pixels=" << transfer.pixels << "}";
+}
+
+// The viewports the surface set on the target, each with the number of pixels streamed into it
+std::vector<transfer_t> transfers;
+
+bool target_noop(painter_device_t device) {
+    return true;
+}
+
+bool target_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+bool target_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+bool target_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    transfers.push_back({left, top, right, bottom, 0});
+    return true;
+}
+
+bool target_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    transfers.back().pixels += native_pixel_count;
+    return true;
+}
+
+const painter_driver_vtable_t target_vtable = {
+    .init     = target_init,
+    .power    = target_power,
+    .clear    = target_noop,
+    .flush    = target_noop,
+    .viewport = target_viewport,
+    .pixdata  = target_pixdata,
+};
+
+painter_driver_t target = {
+    .driver_vtable         = &target_vtable,
+    .comms_vtable          = &dummy_comms_vtable,
+    .validate_ok           = true,
+    .panel_width           = SURFACE_SIZE,
+    .panel_height          = SURFACE_SIZE,
+    .native_bits_per_pixel = 16,
+};
+
+uint8_t          buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_SIZE, SURFACE_SIZE, 16)];
+painter_device_t surface;
+
+transfer_t rect(uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    return {l, t, r, b, (uint32_t)(r - l + 1) * (b - t + 1)};
+}
+
+// Draws the surface to the target and returns what was sent, in a fixed order
+std::vector<transfer_t> draw_dirty() {
+    transfers.clear();
+    EXPECT_TRUE(qp_surface_draw(surface, (painter_device_t)&target, 0, 0, false));
+    std::sort(transfers.begin(), transfers.end());
+    return transfers;
+}
+
+} // namespace
+
+class SurfaceDirtyRects : public testing::Test {
+   public:
+    static void SetUpTestSuite() {
+        surface = qp_make_rgb565_surface(SURFACE_SIZE, SURFACE_SIZE, buffer);
+    }
+
+    void SetUp() override {
+        // A freshly initialised surface is entirely dirty, start each test from a clean one
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        ASSERT_TRUE(qp_flush(surface));
+    }
+};
+
+TEST_F(SurfaceDirtyRects, CleanSurfaceSendsNothing) {
+    EXPECT_EQ(draw_dirty(), std::vector<transfer_t>{});
+}
+
+TEST_F(SurfaceDirtyRects, SeparateDrawsAreSentSeparately) {
+    EXPECT_TRUE(qp_rect(surface, 0, 0, 3, 3, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 20, 20, 23, 23, 0, 255, 255, true));
+
+    EXPECT_EQ(draw_dirty(), (std::vector<transfer_t>{rect(0, 0, 3, 3), rect(20, 20, 23, 23)}));
+    EXPECT_EQ(draw_dirty(), std::vector<transfer_t>{});
+}
+
+TEST_F(SurfaceDirtyRects, AdjacentDrawsAreMerged) {
+    EXPECT_TRUE(qp_rect(surface, 0, 0, 3, 3, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 4, 0, 7, 3, 0, 255, 255, true));
+
+    EXPECT_EQ(draw_dirty(), std::vector<transfer_t>{rect(0, 0, 7, 3)});
+}
+
+TEST_F(SurfaceDirtyRects, OverlappingDrawsMergeWhenTheUnionIsNoLargerThanBoth) {
+    // The union is 12x12 = 144 pixels against 100 + 100, so they are merged, although 8 of its pixels weren't drawn
+    EXPECT_TRUE(qp_rect(surface, 0, 0, 9, 9, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 2, 2, 11, 11, 0, 255, 255, true));
+
+    EXPECT_EQ(draw_dirty(), std::vector<transfer_t>{rect(0, 0, 11, 11)});
+}
+
+TEST_F(SurfaceDirtyRects, OverlappingDrawsStaySeparateWhenTheUnionIsLarger) {
+    // The union is 15x15 = 225 pixels against 100 + 100, so both are sent and the overlap goes twice
+    EXPECT_TRUE(qp_rect(surface, 0, 0, 9, 9, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 5, 5, 14, 14, 0, 255, 255, true));
+
+    EXPECT_EQ(draw_dirty(), (std::vector<transfer_t>{rect(0, 0, 9, 9), rect(5, 5, 14, 14)}));
+}
+
+TEST_F(SurfaceDirtyRects, RunningOutMergesTheCheapestPair) {
+    // One more rectangle than can be tracked, the two top-left ones are the closest
+    EXPECT_TRUE(qp_rect(surface, 0, 0, 1, 1, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 28, 0, 29, 1, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 0, 28, 1, 29, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 28, 28, 29, 29, 0, 255, 255, true));
+    EXPECT_TRUE(qp_rect(surface, 3, 0, 4, 1, 0, 255, 255, true));
+    static_assert(SURFACE_NUM_DIRTY_RECTS == 4, "the test draws one more rectangle than the default limit");
+
+    EXPECT_EQ(draw_dirty(), (std::vector<transfer_t>{rect(0, 0, 4, 1), rect(28, 0, 29, 1), rect(0, 28, 1, 29), rect(28, 28, 29, 29)}));
+}
+
+TEST_F(SurfaceDirtyRects, FullWidthDrawsAreSentFromTheFramebuffer) {
+    EXPECT_TRUE(qp_rect(surface, 0, 4, SURFACE_SIZE - 1, 5, 0, 255, 255, true));
+
+    EXPECT_EQ(draw_dirty(), std::vector<transfer_t>{rect(0, 4, SURFACE_SIZE - 1, 5)});
+}
@@ -0,0 +1,15 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+enum combos { we, er };
+
+uint16_t const we_combo[] = {KC_W, KC_E, COMBO_END};
+uint16_t const er_combo[] = {KC_E, KC_R, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [we] = COMBO(we_combo, KC_ESCAPE),
+    [er] = COMBO(er_combo, KC_TAB),
+};
+// clang-format on
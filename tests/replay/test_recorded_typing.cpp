@@ -0,0 +1,69 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_replay.hpp"
+
+/**
+ * Replays the traces in the traces folder and compares the reports with the recorded `.reports` files.
+ * The printed processing times and report latencies can be compared between builds.
+ */
+
+namespace {
+const std::string trace_dir = std::string(__FILE__).substr(0, std::string(__FILE__).rfind('/') + 1) + "traces/";
+
+// clang-format off
+const uint16_t layout[MATRIX_ROWS][MATRIX_COLS] = {
+    {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G, KC_H, RSFT_T(KC_J), RCTL_T(KC_K), RALT_T(KC_L), RGUI_T(KC_SCLN)},
+    {KC_Q,         KC_W,         KC_E,         KC_R,         KC_T, KC_Y, KC_U,         KC_I,         KC_O,         KC_P},
+    {KC_Z,         KC_X,         KC_C,         KC_V,         KC_B, KC_N, KC_M,         KC_COMM,      KC_DOT,       KC_SLSH},
+    {KC_NO,        KC_NO,        KC_NO,        KC_NO,        KC_SPACE, KC_NO, KC_NO,   KC_NO,        KC_NO,        KC_NO},
+};
+// clang-format on
+} // namespace
+
+class RecordedTyping : public TestFixture {
+   protected:
+    void SetUp() override {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, layout[row][col]));
+            }
+        }
+    }
+
+    void replay(const std::string& name, const std::string& trace) {
+        TestDriver driver;
+        auto       events = load_replay_trace(trace_dir + trace);
+        ASSERT_FALSE(events.empty()) << "no events in " << trace;
+
+        auto result = replay_trace(*this, driver, events, TAPPING_TERM * 2);
+        result.print_summary(name);
+        expect_replay_reports(result, trace_dir + name + ".reports");
+    }
+};
+
+TEST_F(RecordedTyping, HomeRowMods) {
+    replay("home_row_mods", "home_row_mods.csv");
+}
+
+TEST_F(RecordedTyping, Combos) {
+    replay("combos", "combos.csv");
+}
+
+TEST_F(RecordedTyping, ConsoleCapture) {
+    replay("console_capture", "console_capture.txt");
+}
+
+TEST_F(RecordedTyping, ConsoleTimesAreUnwrapped) {
+    auto events = load_replay_trace(trace_dir + "console_capture.txt");
+    ASSERT_EQ(events.size(), 8);
+    EXPECT_EQ(events.front().time, 0);
+    // the last event was logged at 222, after the 16 bit timer wrapped
+    EXPECT_EQ(events.back().time, 0x10000 + 222 - 65400);
+    EXPECT_EQ(events.back().position.col, 7);
+    EXPECT_EQ(events.back().position.row, 0);
+    EXPECT_FALSE(events.back().pressed);
+}
@@ -0,0 +1,264 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "host.h"
+#include "report_queue.h"
+}
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+using testing::InSequence;
+
+namespace {
+
+void send_mouse(uint8_t buttons, int8_t x, int8_t y) {
+    report_mouse_t report = {};
+    report.buttons        = buttons;
+    report.x              = x;
+    report.y              = y;
+    host_mouse_send(&report);
+}
+
+auto MouseReport(uint8_t buttons, int8_t x, int8_t y) {
+    return AllOf(Field(&report_mouse_t::buttons, buttons), Field(&report_mouse_t::x, x), Field(&report_mouse_t::y, y));
+}
+
+// Like the ChibiOS driver, keeps transmitting a keyboard report from the caller's buffer after returning, and only
+// finishes reading it when the next one is started
+struct InFlightEndpoint {
+    static bool                           ready;
+    static const report_keyboard_t*       in_flight;
+    static std::vector<report_keyboard_t> transmitted;
+
+    static void send_keyboard(report_keyboard_t* report) {
+        complete();
+        in_flight = report;
+    }
+
+    static void complete() {
+        if (in_flight) {
+            transmitted.push_back(*in_flight);
+            in_flight = nullptr;
+        }
+    }
+
+    static bool send_ready(uint8_t report_type) {
+        return ready;
+    }
+};
+
+bool                           InFlightEndpoint::ready;
+const report_keyboard_t*       InFlightEndpoint::in_flight;
+std::vector<report_keyboard_t> InFlightEndpoint::transmitted;
+
+host_driver_t in_flight_driver = {
+    [] { return (uint8_t)0; }, InFlightEndpoint::send_keyboard, [](report_nkro_t*) {}, [](report_mouse_t*) {}, [](report_extra_t*) {}, InFlightEndpoint::send_ready,
+};
+
+} // namespace
+
+class ReportQueue : public TestFixture {
+   public:
+    void SetUp() override {
+        report_queue_clear();
+        report_queue_reset_stats();
+    }
+};
+
+TEST_F(ReportQueue, ReadyDriverSendsImmediately) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(report_queue_get_stats().max_depth, 0);
+}
+
+TEST_F(ReportQueue, BusyDriverKeepsPressAndRelease) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    driver.set_send_ready(false);
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_queue_depth(), 3);
+
+    driver.set_send_ready(true);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_queue_depth(), 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    report_queue_stats_t stats = report_queue_get_stats();
+    EXPECT_EQ(stats.max_depth, 3);
+    EXPECT_EQ(stats.blocked, 0);
+}
+
+TEST_F(ReportQueue, FullQueueKeepsEveryState) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    driver.set_send_ready(false);
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_a);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_queue_depth(), REPORT_QUEUE_SIZE);
+
+    // The oldest reports are sent while the endpoint is busy to make room
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(report_queue_depth(), REPORT_QUEUE_SIZE);
+
+    driver.set_send_ready(true);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    report_queue_stats_t stats = report_queue_get_stats();
+    EXPECT_EQ(stats.max_depth, REPORT_QUEUE_SIZE);
+    EXPECT_EQ(stats.blocked, 2);
+}
+
+TEST_F(ReportQueue, FullQueueKeepsRepress) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    // Three taps and a press queue seven reports, the oldest three are sent while the endpoint is busy
+    driver.set_send_ready(false);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_a);
+    tap_key(key_a);
+    tap_key(key_a);
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    driver.set_send_ready(true);
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(report_queue_get_stats().blocked, 3);
+}
+
+TEST_F(ReportQueue, MouseMovementIsCoalesced) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_send_ready(false);
+    send_mouse(0, 1, -1);
+    send_mouse(0, 2, -2);
+    send_mouse(0, 3, -3);
+    EXPECT_EQ(report_queue_depth(), 1);
+    EXPECT_EQ(report_queue_get_stats().coalesced, 2);
+
+    driver.set_send_ready(true);
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 6, -6)));
+    report_queue_task();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, MouseButtonChangesAreNotCoalesced) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_send_ready(false);
+    send_mouse(0, 100, 0);
+    send_mouse(0, 100, 0); // would overflow the report
+    send_mouse(1, 0, 0);
+    send_mouse(0, 0, 0);
+    EXPECT_EQ(report_queue_depth(), 4);
+    EXPECT_EQ(report_queue_get_stats().coalesced, 0);
+
+    driver.set_send_ready(true);
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 100, 0))).Times(2);
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(1, 0, 0)));
+    EXPECT_CALL(driver, send_mouse_mock(MouseReport(0, 0, 0)));
+    report_queue_task();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, FullQueueDoesNotOverwriteReportInFlight) {
+    InFlightEndpoint::ready     = false;
+    InFlightEndpoint::in_flight = nullptr;
+    InFlightEndpoint::transmitted.clear();
+    host_set_driver(&in_flight_driver);
+
+    // The last two reports are queued while full, so the oldest two go out back to back on the busy endpoint
+    const int count = REPORT_QUEUE_SIZE + 2;
+    for (int i = 0; i < count; i++) {
+        report_keyboard_t report = {};
+        report.keys[0]           = KC_A + i;
+        report_queue_send(HOST_REPORT_KEYBOARD, &report);
+    }
+    EXPECT_EQ(report_queue_get_stats().blocked, 2);
+
+    InFlightEndpoint::ready = true;
+    report_queue_task();
+    InFlightEndpoint::complete();
+
+    ASSERT_EQ(InFlightEndpoint::transmitted.size(), count);
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(InFlightEndpoint::transmitted[i].keys[0], KC_A + i);
+    }
+}
@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 44
+
+#define HSV_TO_RGB_LUT
+#define HSV_TO_RGB_WHITE_BALANCE_G 224
+#define HSV_TO_RGB_WHITE_BALANCE_B 192
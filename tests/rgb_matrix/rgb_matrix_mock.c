@@ -0,0 +1,59 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix_mock.h"
+
+// clang-format off
+led_config_t g_led_config = { {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9 },
+    { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 },
+    { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 },
+    { 30, 31, 32, 33, 34, 35, 36, 37, 38, 39 }
+}, {
+    {   0,  0 }, {  24,  0 }, {  49,  0 }, {  74,  0 }, {  99,  0 }, { 124,  0 }, { 149,  0 }, { 174,  0 }, { 199,  0 }, { 224,  0 },
+    {   6, 21 }, {  31, 21 }, {  56, 21 }, {  81, 21 }, { 106, 21 }, { 131, 21 }, { 156, 21 }, { 181, 21 }, { 206, 21 }, { 224, 21 },
+    {  12, 42 }, {  37, 42 }, {  62, 42 }, {  87, 42 }, { 112, 42 }, { 137, 42 }, { 162, 42 }, { 187, 42 }, { 212, 42 }, { 224, 42 },
+    {   0, 64 }, {  24, 64 }, {  49, 64 }, {  74, 64 }, {  99, 64 }, { 124, 64 }, { 149, 64 }, { 174, 64 }, { 199, 64 }, { 224, 64 },
+    {  28, 32 }, {  84, 10 }, { 140, 54 }, { 196, 32 }
+}, {
+    1, 4, 4, 4, 4, 4, 4, 4, 4, 1,
+    1, 4, 4, 4, 4, 4, 4, 4, 4, 1,
+    1, 4, 4, 4, 4, 4, 4, 4, 4, 1,
+    1, 1, 1, 4, 4, 4, 4, 1, 1, 1,
+    2, 2, 2, 2
+} };
+// clang-format on
+
+uint8_t  mock_leds[RGB_MATRIX_LED_COUNT][3];
+uint32_t mock_frame_hash  = 2166136261u;
+uint32_t mock_frame_count = 0;
+
+static void init(void) {}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    mock_leds[index][0] = r;
+    mock_leds[index][1] = g;
+    mock_leds[index][2] = b;
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+// FNV-1a over every flushed frame
+static void flush(void) {
+    const uint8_t *bytes = &mock_leds[0][0];
+    for (size_t i = 0; i < sizeof(mock_leds); i++) {
+        mock_frame_hash = (mock_frame_hash ^ bytes[i]) * 16777619u;
+    }
+    mock_frame_count++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+    .flush         = flush,
+};
@@ -0,0 +1,18 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint8_t  mock_leds[RGB_MATRIX_LED_COUNT][3];
+extern uint32_t mock_frame_hash;
+extern uint32_t mock_frame_count;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,101 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include "test_common.hpp"
+
+/**
+ * Compares hsv_to_rgb() with the sector math in hsv_to_rgb_impl() for every HSV value. Without HSV_TO_RGB_LUT they
+ * are the same function; the table backend may differ by HSV_TO_RGB_LUT_TOLERANCE per channel from the reference at
+ * the hue of the table entry, after the reference has been scaled by the white balance. Against the exact hue, each
+ * hue a table entry covers beyond its first adds up to 6 more, as the channels ramp by 6 per hue. Built with every
+ * HSV_TO_RGB_LUT_SIZE:
+ *
+ *   size  tolerance at the entry's hue  tolerance at the exact hue
+ *   256   2 (4 with white balance)      2 (4)
+ *   128   2 (4)                         8 (10)
+ *    64   2 (4)                         20 (22)
+ *    32   2 (4)                         44 (46)
+ *
+ * Greys are scaled exactly, to (v * (white + 1)) >> 8.
+ */
+
+extern "C" RGB hsv_to_rgb_impl(HSV hsv, bool use_cie);
+
+namespace {
+#ifdef HSV_TO_RGB_LUT
+// rounding the white balance into the table costs up to 2 more
+constexpr int HSV_TO_RGB_LUT_TOLERANCE = (HSV_TO_RGB_WHITE_BALANCE_R & HSV_TO_RGB_WHITE_BALANCE_G & HSV_TO_RGB_WHITE_BALANCE_B) == 255 ? 2 : 4;
+
+uint8_t balance(uint8_t value, unsigned white) {
+    return (value * (white + 1)) >> 8;
+}
+
+// hues sharing a table entry are converted as the first hue of the entry
+constexpr unsigned HUE_STEP               = 256 / HSV_TO_RGB_LUT_SIZE;
+constexpr int      HSV_TO_RGB_HUE_TOLERANCE = HSV_TO_RGB_LUT_TOLERANCE + 6 * (HUE_STEP - 1);
+
+RGB expected_rgb(HSV hsv, bool use_cie, bool table_hue = true) {
+    if (table_hue) {
+        hsv.h -= hsv.h % HUE_STEP;
+    }
+    RGB rgb = hsv_to_rgb_impl(hsv, use_cie);
+    rgb.r   = balance(rgb.r, HSV_TO_RGB_WHITE_BALANCE_R);
+    rgb.g   = balance(rgb.g, HSV_TO_RGB_WHITE_BALANCE_G);
+    rgb.b   = balance(rgb.b, HSV_TO_RGB_WHITE_BALANCE_B);
+    return rgb;
+}
+#else
+constexpr int HSV_TO_RGB_LUT_TOLERANCE = 0;
+constexpr int HSV_TO_RGB_HUE_TOLERANCE = 0;
+
+RGB expected_rgb(HSV hsv, bool use_cie, bool table_hue = true) {
+    return hsv_to_rgb_impl(hsv, use_cie);
+}
+#endif
+
+int max_error(RGB (*convert)(HSV), bool use_cie, HSV* worst, bool table_hue = true) {
+    int error = 0;
+    for (unsigned h = 0; h < 256; h++) {
+        for (unsigned s = 0; s < 256; s++) {
+            for (unsigned v = 0; v < 256; v++) {
+                HSV hsv      = {(uint8_t)h, (uint8_t)s, (uint8_t)v};
+                RGB actual   = convert(hsv);
+                RGB expected = expected_rgb(hsv, use_cie, table_hue);
+                int channel  = std::max({std::abs(actual.r - expected.r), std::abs(actual.g - expected.g), std::abs(actual.b - expected.b)});
+                if (channel > error) {
+                    error  = channel;
+                    *worst = hsv;
+                }
+            }
+        }
+    }
+    return error;
+}
+} // namespace
+
+TEST(HsvToRgb, MatchesReference) {
+    HSV worst = {0, 0, 0};
+    EXPECT_LE(max_error(hsv_to_rgb, true, &worst), HSV_TO_RGB_LUT_TOLERANCE) << "worst at h " << +worst.h << " s " << +worst.s << " v " << +worst.v;
+}
+
+TEST(HsvToRgb, NoCieMatchesReference) {
+    HSV worst = {0, 0, 0};
+    EXPECT_LE(max_error(hsv_to_rgb_nocie, false, &worst), HSV_TO_RGB_LUT_TOLERANCE) << "worst at h " << +worst.h << " s " << +worst.s << " v " << +worst.v;
+}
+
+TEST(HsvToRgb, MatchesReferenceAtExactHue) {
+    HSV worst = {0, 0, 0};
+    EXPECT_LE(max_error(hsv_to_rgb_nocie, false, &worst, false), HSV_TO_RGB_HUE_TOLERANCE) << "worst at h " << +worst.h << " s " << +worst.s << " v " << +worst.v;
+}
+
+TEST(HsvToRgb, GreysAreExact) {
+    for (unsigned v = 0; v < 256; v++) {
+        HSV hsv      = {0, 0, (uint8_t)v};
+        RGB actual   = hsv_to_rgb_nocie(hsv);
+        RGB expected = expected_rgb(hsv, false);
+        EXPECT_EQ(actual.r, expected.r) << "v " << v;
+        EXPECT_EQ(actual.g, expected.g) << "v " << v;
+        EXPECT_EQ(actual.b, expected.b) << "v " << v;
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cmath>
+#include "test_common.hpp"
+#include "rgb_matrix_mock.h"
+
+/**
+ * Renders the effects using the dx/dy runners for a while and hashes every flushed frame. Built both with and without
+ * RGB_MATRIX_LED_GEOMETRY_CACHE: both builds must flush exactly the frames recorded below.
+ */
+
+namespace {
+struct EffectFrames {
+    uint8_t     mode;
+    const char* name;
+    uint32_t    hash;
+};
+
+const EffectFrames effects[] = {
+    {RGB_MATRIX_BAND_PINWHEEL_SAT, "BAND_PINWHEEL_SAT", 2434691201u},
+    {RGB_MATRIX_BAND_PINWHEEL_VAL, "BAND_PINWHEEL_VAL", 3719121188u},
+    {RGB_MATRIX_BAND_SPIRAL_SAT, "BAND_SPIRAL_SAT", 3194402101u},
+    {RGB_MATRIX_BAND_SPIRAL_VAL, "BAND_SPIRAL_VAL", 2781360072u},
+    {RGB_MATRIX_CYCLE_OUT_IN, "CYCLE_OUT_IN", 1414951121u},
+    {RGB_MATRIX_CYCLE_OUT_IN_DUAL, "CYCLE_OUT_IN_DUAL", 3531785641u},
+    {RGB_MATRIX_CYCLE_PINWHEEL, "CYCLE_PINWHEEL", 4124454297u},
+    {RGB_MATRIX_CYCLE_SPIRAL, "CYCLE_SPIRAL", 3093916843u},
+};
+
+constexpr unsigned RENDER_MS = 2000;
+} // namespace
+
+class RgbMatrixEffects : public TestFixture {};
+
+TEST_F(RgbMatrixEffects, FramesMatchRecordedFrames) {
+    TestDriver driver;
+    rgb_matrix_sethsv_noeeprom(HSV_CYAN);
+    rgb_matrix_set_speed_noeeprom(200);
+
+    for (const auto& effect : effects) {
+        rgb_matrix_mode_noeeprom(effect.mode);
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+
+        mock_frame_hash  = 2166136261u;
+        mock_frame_count = 0;
+        idle_for(RENDER_MS);
+
+        EXPECT_GE(mock_frame_count, RENDER_MS / RGB_MATRIX_LED_FLUSH_LIMIT / 2) << "Too few frames rendered for " << effect.name;
+        EXPECT_EQ(mock_frame_hash, effect.hash) << "Unexpected frames for " << effect.name;
+    }
+}
+
+#ifdef RGB_MATRIX_LED_GEOMETRY_CACHE
+extern "C" const led_point_t k_rgb_matrix_center;
+
+namespace {
+// sqrt16() rounds down
+uint8_t expected_dist(int16_t dx, int16_t dy) {
+    return (uint8_t)std::sqrt(dx * dx + dy * dy);
+}
+} // namespace
+
+TEST_F(RgbMatrixEffects, GeometryMatchesLedConfig) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        EXPECT_EQ(g_led_geometry.dx[i], dx) << "LED " << +i;
+        EXPECT_EQ(g_led_geometry.dy[i], dy) << "LED " << +i;
+        EXPECT_EQ(g_led_geometry.dist[i], expected_dist(dx, dy)) << "LED " << +i;
+    }
+}
+
+TEST_F(RgbMatrixEffects, GeometryFollowsLedConfigChanges) {
+    led_point_t saved = g_led_config.point[0];
+
+    g_led_config.point[0] = k_rgb_matrix_center;
+    rgb_matrix_update_led_geometry();
+    EXPECT_EQ(g_led_geometry.dx[0], 0);
+    EXPECT_EQ(g_led_geometry.dy[0], 0);
+    EXPECT_EQ(g_led_geometry.dist[0], 0);
+
+    g_led_config.point[0] = saved;
+    rgb_matrix_update_led_geometry();
+    EXPECT_EQ(g_led_geometry.dist[0], expected_dist(g_led_config.point[0].x - k_rgb_matrix_center.x, g_led_config.point[0].y - k_rgb_matrix_center.y));
+}
+#endif
@@ -0,0 +1,186 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "send_string_async.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+namespace {
+
+int callback_count = 0;
+
+void count_callback(void *context) {
+    callback_count++;
+    EXPECT_EQ(context, &callback_count);
+}
+
+} // namespace
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        send_string_async_clear();
+        callback_count = 0;
+    }
+};
+
+TEST_F(SendStringAsync, TypesOneCharacterPerScan) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async("ab"));
+    EXPECT_TRUE(send_string_async_is_busy());
+    EXPECT_NO_REPORT(driver);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, ShiftedCharacters) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async("A" SS_TAP(X_ENTER)));
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, IntervalSpreadsKeystrokes) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay("ab", 10));
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(9);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, DelayKeepsScanning) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_c = KeymapKey(0, 0, 0, KC_C);
+
+    set_keymap({key_c});
+
+    EXPECT_TRUE(send_string_async("a" SS_DELAY(50) "b"));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Keys pressed while the string waits are processed right away. */
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CallbackRunsAfterQueuedStrings) {
+    TestDriver driver;
+
+    EXPECT_TRUE(send_string_async("ab"));
+    EXPECT_TRUE(send_string_async_callback(count_callback, &callback_count));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver).Times(2);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    EXPECT_EQ(callback_count, 0);
+    run_one_scan_loop();
+    EXPECT_EQ(callback_count, 1);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, FullQueueRejectsString) {
+    TestDriver driver;
+
+    EXPECT_FALSE(send_string_async("this string does not fit in 32 bytes"));
+    EXPECT_FALSE(send_string_async_is_busy());
+
+    EXPECT_TRUE(send_string_async("a"));
+    EXPECT_FALSE(send_string_async("this one neither"));
+    /* Room is always left for a callback. */
+    EXPECT_TRUE(send_string_async_callback(count_callback, &callback_count));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(callback_count, 1);
+}
+
+TEST_F(SendStringAsync, ClearReleasesHeldKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay("AB", 10));
+    EXPECT_TRUE(send_string_async_callback(count_callback, &callback_count));
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT)).Times(testing::AnyNumber());
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_clear();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(send_string_async_is_busy());
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(callback_count, 0);
+}
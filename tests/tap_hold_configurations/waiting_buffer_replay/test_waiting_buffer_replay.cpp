@@ -0,0 +1,110 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_replay.hpp"
+
+/**
+ * Replays the recorded home row mod typing in the traces folder through the tap-hold engine, which must send exactly
+ * the reports in the recorded `.reports` files, and times rolls that keep the waiting buffer full.
+ */
+
+extern "C" {
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+
+namespace {
+const std::string trace_dir = std::string(__FILE__).substr(0, std::string(__FILE__).rfind('/') + 1) + "traces/";
+
+const std::vector<std::string> traces = {"flask_roll", "shift_hold", "ctrl_tap_interrupt", "sad_dad_overlap", "asdf_rolled_in_order", "jk_nested_taps"};
+
+constexpr int BENCHMARK_ROLLS = 20000;
+
+// Home row mods pressed in this order, all before the first is released, so that up to six events wait behind the
+// undecided tap-hold key
+const std::vector<keypos_t> roll = {{0, 0}, {1, 0}, {2, 0}, {3, 0}, {6, 0}, {7, 0}, {8, 0}};
+
+keyevent_t make_event(keypos_t key, keyevent_type_t type, bool pressed) {
+    return {key, timer_read(), type, pressed};
+}
+
+unsigned benchmark_reports = 0;
+
+// Takes the reports while the benchmark runs, so that only the tapping engine is timed
+host_driver_t benchmark_driver = {
+    []() -> uint8_t { return 0; }, [](report_keyboard_t*) { benchmark_reports++; }, [](report_nkro_t*) {}, [](report_mouse_t*) {}, [](report_extra_t*) {}, nullptr,
+};
+} // namespace
+
+class WaitingBufferReplay : public TestFixture {
+   protected:
+    void SetUp() override {
+        for (const auto& key : keys) {
+            add_key(key);
+        }
+    }
+
+   private:
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 0, 0, LGUI_T(KC_A)), KeymapKey(0, 1, 0, LALT_T(KC_S)), KeymapKey(0, 2, 0, LCTL_T(KC_D)), KeymapKey(0, 3, 0, LSFT_T(KC_F)), KeymapKey(0, 6, 0, RSFT_T(KC_J)), KeymapKey(0, 7, 0, RCTL_T(KC_K)),
+        KeymapKey(0, 8, 0, RALT_T(KC_L)),  KeymapKey(0, 2, 1, KC_E),         KeymapKey(0, 6, 1, KC_U),         KeymapKey(0, 8, 1, KC_O),         KeymapKey(0, 0, 2, KC_SPACE),
+    };
+};
+
+TEST_F(WaitingBufferReplay, RecordedSessionsSendRecordedReports) {
+    for (const auto& name : traces) {
+        TestDriver driver;
+        auto       events = load_replay_trace(trace_dir + name + ".csv");
+        ASSERT_FALSE(events.empty()) << "no events in " << name;
+
+        expect_replay_reports(replay_trace(*this, driver, events, TAPPING_TERM * 2), trace_dir + name + ".reports");
+    }
+}
+
+TEST_F(WaitingBufferReplay, Benchmark) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    host_driver_t* test_driver = host_get_driver();
+    host_set_driver(&benchmark_driver);
+    benchmark_reports = 0;
+
+    unsigned                                  events = 0;
+    std::chrono::duration<double, std::micro> elapsed(0);
+    auto                                      exec = [&](keyevent_t event) {
+        auto begin = std::chrono::steady_clock::now();
+        action_exec(event);
+        elapsed += std::chrono::steady_clock::now() - begin;
+    };
+
+    for (int i = 0; i < BENCHMARK_ROLLS; i++) {
+        for (bool pressed : {true, false}) {
+            for (const auto& key : roll) {
+                exec(make_event(key, KEY_EVENT, pressed));
+                events++;
+                advance_time(5);
+                exec(make_event({0, 0}, TICK_EVENT, false));
+            }
+        }
+        advance_time(TAPPING_TERM);
+        exec(make_event({0, 0}, TICK_EVENT, false));
+    }
+
+    host_set_driver(test_driver);
+    std::cout << "[ BENCHMARK] waiting_buffer_replay: " << events << " key events in rolls of " << roll.size() << " keys, " << (elapsed.count() / events) << " us/event in action_exec()" << std::endl;
+    EXPECT_EQ(benchmark_reports, BENCHMARK_ROLLS * roll.size() * 2);
+}
@@ -19,6 +19,8 @@
 #include <string.h>
 
 static matrix_row_t matrix[MATRIX_ROWS] = {};
+static uint32_t     changed_rows[MATRIX_ROWS_BITMAP_WORDS] = {};
+static bool         publish_changed_rows                   = true;
 
 void matrix_init(void) {
     clear_all_keys();
@@ -26,6 +28,10 @@ void matrix_init(void) {
 }
 
 uint8_t matrix_scan(void) {
+    if (publish_changed_rows) {
+        matrix_set_changed_rows(changed_rows);
+    }
+    memset(changed_rows, 0, sizeof(changed_rows));
     matrix_scan_kb();
     return 1;
 }
@@ -42,10 +48,12 @@ void matrix_scan_kb(void) {}
 
 void press_key(uint8_t col, uint8_t row) {
     matrix[row] |= (matrix_row_t)1 << col;
+    changed_rows[row / 32] |= (uint32_t)1 << (row % 32);
 }
 
 void release_key(uint8_t col, uint8_t row) {
     matrix[row] &= ~((matrix_row_t)1 << col);
+    changed_rows[row / 32] |= (uint32_t)1 << (row % 32);
 }
 
 bool matrix_is_on(uint8_t row, uint8_t col) {
@@ -54,6 +62,11 @@ bool matrix_is_on(uint8_t row, uint8_t col) {
 
 void clear_all_keys(void) {
     memset(matrix, 0, sizeof(matrix));
+    memset(changed_rows, 0xFF, sizeof(changed_rows));
+}
+
+void set_publish_changed_rows(bool enable) {
+    publish_changed_rows = enable;
 }
 
 void led_set(uint8_t usb_led) {}
@@ -30,6 +30,10 @@ class TestDriver {
     void set_leds(uint8_t leds) {
         m_leds = leds;
     }
+    // Simulates a busy endpoint, reports are only sent while ready
+    void set_send_ready(bool ready) {
+        m_send_ready = ready;
+    }
 
     MOCK_METHOD1(send_keyboard_mock, void(report_keyboard_t&));
     MOCK_METHOD1(send_nkro_mock, void(report_nkro_t&));
@@ -42,8 +46,10 @@ class TestDriver {
     static void        send_nkro(report_nkro_t* report);
     static void        send_mouse(report_mouse_t* report);
     static void        send_extra(report_extra_t* report);
+    static bool        send_ready(uint8_t report_type);
     host_driver_t      m_driver;
-    uint8_t            m_leds = 0;
+    uint8_t            m_leds       = 0;
+    bool               m_send_ready = true;
     static TestDriver* m_this;
 };
 
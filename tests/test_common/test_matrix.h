@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -23,6 +26,7 @@ extern "C" {
 void press_key(uint8_t col, uint8_t row);
 void release_key(uint8_t col, uint8_t row);
 void clear_all_keys(void);
+void set_publish_changed_rows(bool enable);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,221 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_replay.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include "keyboard_report_util.hpp"
+#include "timer.h"
+
+using testing::_;
+
+namespace {
+std::string report_to_string(const report_keyboard_t& report) {
+    std::ostringstream stream;
+    stream << report;
+    std::string text = stream.str();
+    // strip the "report:" label and the line break
+    text.erase(0, text.find_first_not_of(' ', text.find(':') + 1));
+    return text.substr(0, text.find('\n'));
+}
+
+bool parse_pressed(std::string value, bool* pressed) {
+    value.erase(std::remove_if(value.begin(), value.end(), ::isspace), value.end());
+    if (value == "1" || value == "down") {
+        *pressed = true;
+    } else if (value == "0" || value == "up") {
+        *pressed = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parse_console_line(const std::string& line, uint32_t* time, ReplayEvent* event) {
+    unsigned col, row, pressed, console_time;
+    auto     start = line.find("col:");
+    if (line.find("KL:") == std::string::npos || start == std::string::npos) {
+        return false;
+    }
+    if (std::sscanf(line.c_str() + start, "col: %u, row: %u, pressed: %u, time: %u", &col, &row, &pressed, &console_time) != 4) {
+        return false;
+    }
+    *time           = console_time;
+    event->position = {.col = (uint8_t)col, .row = (uint8_t)row};
+    event->pressed  = pressed;
+    return true;
+}
+
+bool parse_csv_line(const std::string& line, uint32_t* time, ReplayEvent* event) {
+    std::stringstream        stream(line);
+    std::vector<std::string> fields;
+    for (std::string field; std::getline(stream, field, ',');) {
+        fields.push_back(field);
+    }
+    unsigned row, col;
+    if (fields.size() != 4 || std::sscanf(fields[0].c_str(), "%u", time) != 1 || std::sscanf(fields[1].c_str(), "%u", &row) != 1 || std::sscanf(fields[2].c_str(), "%u", &col) != 1) {
+        return false;
+    }
+    event->position = {.col = (uint8_t)col, .row = (uint8_t)row};
+    return parse_pressed(fields[3], &event->pressed);
+}
+} // namespace
+
+bool operator==(const ReplayReport& lhs, const ReplayReport& rhs) {
+    return lhs.time == rhs.time && lhs.keys == rhs.keys;
+}
+
+std::ostream& operator<<(std::ostream& stream, const ReplayReport& value) {
+    return stream << value.time << " " << value.keys;
+}
+
+std::vector<ReplayEvent> load_replay_trace(const std::string& path) {
+    std::ifstream file(path);
+    EXPECT_TRUE(file.is_open()) << "could not open trace " << path;
+
+    std::vector<ReplayEvent> events;
+    uint32_t                 first = 0, previous = 0, wraps = 0;
+    unsigned                 line_number = 0;
+    for (std::string line; std::getline(file, line);) {
+        line_number++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#') {
+            continue;
+        }
+
+        ReplayEvent event;
+        uint32_t    time;
+        if (parse_console_line(line, &time, &event)) {
+            // the console prints the 16 bit event time
+            if (!events.empty() && time + wraps < previous) {
+                wraps += 0x10000;
+            }
+            time += wraps;
+        } else if (!parse_csv_line(line, &time, &event)) {
+            // a CSV header
+            EXPECT_EQ(line_number, 1) << path << ":" << line_number << ": unrecognised trace line: " << line;
+            continue;
+        }
+
+        if (events.empty()) {
+            first = time;
+        }
+        EXPECT_GE(time, previous) << path << ":" << line_number << ": events are not in time order";
+        previous   = time;
+        event.time = time - first;
+        events.push_back(event);
+    }
+    return events;
+}
+
+std::vector<ReplayReport> load_replay_reports(const std::string& path) {
+    std::ifstream             file(path);
+    std::vector<ReplayReport> reports;
+    for (std::string line; std::getline(file, line);) {
+        auto separator = line.find(' ');
+        if (separator == std::string::npos) {
+            continue;
+        }
+        reports.push_back({(uint32_t)std::stoul(line.substr(0, separator)), line.substr(separator + 1)});
+    }
+    return reports;
+}
+
+void save_replay_reports(const std::string& path, const std::vector<ReplayReport>& reports) {
+    std::ofstream file(path);
+    for (const auto& report : reports) {
+        file << report << std::endl;
+    }
+}
+
+ReplayResult replay_trace(TestFixture& fixture, TestDriver& driver, const std::vector<ReplayEvent>& events, unsigned settle_ms) {
+    ReplayResult         result;
+    std::deque<uint32_t> unreported;
+    const uint32_t       start = timer_read32();
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly([&](report_keyboard_t& report) {
+        uint32_t now = timer_read32() - start;
+        result.reports.push_back({now, report_to_string(report)});
+        result.report_latency_ms.push_back(unreported.empty() ? 0 : now - unreported.front());
+        unreported.clear();
+    });
+
+    for (size_t i = 0; i < events.size();) {
+        uint32_t time = events[i].time;
+        uint32_t now  = timer_read32() - start;
+        if (time > now) {
+            fixture.idle_for(time - now);
+        }
+
+        // events recorded in the same ms are seen by the same scan, as on a real matrix
+        size_t first = i;
+        for (; i < events.size() && events[i].time == time; i++) {
+            if (events[i].pressed) {
+                press_key(events[i].position.col, events[i].position.row);
+            } else {
+                release_key(events[i].position.col, events[i].position.row);
+            }
+            unreported.push_back(time);
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        fixture.run_one_scan_loop();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+        result.event_us.insert(result.event_us.end(), i - first, elapsed.count());
+    }
+    fixture.idle_for(settle_ms);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    return result;
+}
+
+void ReplayResult::print_summary(const std::string& name) const {
+    std::vector<double> sorted_us(event_us);
+    std::sort(sorted_us.begin(), sorted_us.end());
+    double median_us = sorted_us.empty() ? 0 : sorted_us[sorted_us.size() / 2];
+    double max_us    = sorted_us.empty() ? 0 : sorted_us.back();
+
+    uint32_t max_latency  = report_latency_ms.empty() ? 0 : *std::max_element(report_latency_ms.begin(), report_latency_ms.end());
+    double   mean_latency = report_latency_ms.empty() ? 0 : std::accumulate(report_latency_ms.begin(), report_latency_ms.end(), 0.0) / report_latency_ms.size();
+
+    std::cout << "[ REPLAY   ] " << name << ": " << event_us.size() << " events, " << reports.size() << " reports, scan median " << median_us << " us, max " << max_us << " us, report latency mean " << mean_latency << " ms, max " << max_latency << " ms" << std::endl;
+}
+
+void expect_replay_reports(const ReplayResult& result, const std::string& golden_path) {
+    if (!std::ifstream(golden_path).good()) {
+        save_replay_reports(golden_path, result.reports);
+        ADD_FAILURE() << "golden reports were missing, recorded " << result.reports.size() << " reports to " << golden_path;
+        return;
+    }
+
+    auto   golden = load_replay_reports(golden_path);
+    size_t i      = 0;
+    while (i < golden.size() && i < result.reports.size() && golden[i] == result.reports[i]) {
+        i++;
+    }
+    if (i == golden.size() && i == result.reports.size()) {
+        return;
+    }
+
+    std::ostringstream message;
+    message << "reports diverge from " << golden_path << " at report " << i << std::endl;
+    message << "  expected: ";
+    if (i < golden.size()) {
+        message << golden[i];
+    } else {
+        message << "no more reports";
+    }
+    message << std::endl << "  actual:   ";
+    if (i < result.reports.size()) {
+        message << result.reports[i];
+    } else {
+        message << "no more reports";
+    }
+    ADD_FAILURE() << message.str();
+}
@@ -0,0 +1,70 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+
+/**
+ * @brief A physical key event of a recorded trace.
+ */
+struct ReplayEvent {
+    uint32_t time; // ms since the first event of the trace
+    keypos_t position;
+    bool     pressed;
+};
+
+/**
+ * @brief A keyboard report sent while replaying a trace.
+ */
+struct ReplayReport {
+    uint32_t    time; // ms since the first event of the trace
+    std::string keys; // as printed by operator<<(std::ostream&, const report_keyboard_t&)
+};
+
+bool          operator==(const ReplayReport& lhs, const ReplayReport& rhs);
+std::ostream& operator<<(std::ostream& stream, const ReplayReport& value);
+
+struct ReplayResult {
+    std::vector<ReplayReport> reports;
+    /* Host time spent in the scan loop that saw each event, in µs. Events seen by the same scan share it. */
+    std::vector<double> event_us;
+    /* For each report, ms since the oldest event that was not followed by a report yet. */
+    std::vector<uint32_t> report_latency_ms;
+
+    void print_summary(const std::string& name) const;
+};
+
+/**
+ * @brief Loads a trace of key events.
+ *
+ * Each line is either `time,row,col,pressed` (`pressed` being `1`/`0` or `down`/`up`), or a
+ * `KL: kc: ..., col: ..., row: ..., pressed: ..., time: ...` line as printed by the debugging
+ * example of `process_record_user()`. Empty lines, lines starting with `#` and a CSV header are skipped.
+ * Times are made relative to the first event.
+ */
+std::vector<ReplayEvent> load_replay_trace(const std::string& path);
+
+/**
+ * @brief Loads a golden report stream, one `time report` line per report.
+ */
+std::vector<ReplayReport> load_replay_reports(const std::string& path);
+void                      save_replay_reports(const std::string& path, const std::vector<ReplayReport>& reports);
+
+/**
+ * @brief Runs the events through the keyboard task at their recorded times, then for another `settle_ms`.
+ */
+ReplayResult replay_trace(TestFixture& fixture, TestDriver& driver, const std::vector<ReplayEvent>& events, unsigned settle_ms);
+
+/**
+ * @brief Expects the reports to match the golden report stream, times included, and reports the first divergence.
+ *
+ * If the golden file does not exist yet, it is written from the replayed reports and the test fails, so that
+ * it gets reviewed before it is committed. Delete the file to record it again.
+ */
+void expect_replay_reports(const ReplayResult& result, const std::string& golden_path);
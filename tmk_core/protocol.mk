@@ -4,6 +4,11 @@ SRC +=	\
 	$(PROTOCOL_DIR)/usb_device_state.c \
 	$(PROTOCOL_DIR)/usb_util.c \
 
+ifeq ($(strip $(REPORT_QUEUE_ENABLE)), yes)
+    OPT_DEFS += -DREPORT_QUEUE_ENABLE
+    SRC += $(PROTOCOL_DIR)/report_queue.c
+endif
+
 SHARED_EP_ENABLE = no
 MOUSE_SHARED_EP ?= yes
 ifeq ($(strip $(KEYBOARD_SHARED_EP)), yes)
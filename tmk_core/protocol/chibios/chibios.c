@@ -62,9 +62,14 @@ void    send_keyboard(report_keyboard_t *report);
 void    send_nkro(report_nkro_t *report);
 void    send_mouse(report_mouse_t *report);
 void    send_extra(report_extra_t *report);
+#ifdef REPORT_QUEUE_ENABLE
+bool send_ready(uint8_t report_type);
+#else
+#    define send_ready NULL
+#endif
 
 /* host struct */
-host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra};
+host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra, send_ready};
 
 #ifdef VIRTSER_ENABLE
 void virtser_task(void);
@@ -863,6 +863,38 @@ void send_report(uint8_t endpoint, void *report, size_t size) {
     osalSysUnlock();
 }
 
+#ifdef REPORT_QUEUE_ENABLE
+static bool endpoint_ready(uint8_t endpoint) {
+    osalSysLock();
+    // send_report() drops reports while inactive, there is nothing to wait for
+    bool ready = usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE || !usbGetTransmitStatusI(&USB_DRIVER, endpoint);
+    osalSysUnlock();
+    return ready;
+}
+
+/* whether send_report() would go through without waiting for the endpoint
+ * not callable from ISR or locked state */
+bool send_ready(uint8_t report_type) {
+    switch (report_type) {
+        case HOST_REPORT_KEYBOARD:
+            return endpoint_ready(KEYBOARD_IN_EPNUM);
+#    ifdef NKRO_ENABLE
+        case HOST_REPORT_NKRO:
+            return endpoint_ready(SHARED_IN_EPNUM);
+#    endif
+#    ifdef MOUSE_ENABLE
+        case HOST_REPORT_MOUSE:
+            return endpoint_ready(MOUSE_IN_EPNUM);
+#    endif
+#    ifdef EXTRAKEY_ENABLE
+        case HOST_REPORT_EXTRA:
+            return endpoint_ready(SHARED_IN_EPNUM);
+#    endif
+    }
+    return true;
+}
+#endif
+
 /* prepare and start sending a report IN
  * not callable from ISR or locked state */
 void send_keyboard(report_keyboard_t *report) {
@@ -35,6 +35,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "outputselect.h"
 #endif
 
+#ifdef REPORT_QUEUE_ENABLE
+#    include "report_queue.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 extern keymap_config_t keymap_config;
@@ -84,7 +88,11 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_send(HOST_REPORT_KEYBOARD, report);
+#else
     (*driver->send_keyboard)(report);
+#endif
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -98,7 +106,11 @@ void host_keyboard_send(report_keyboard_t *report) {
 void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_send(HOST_REPORT_NKRO, report);
+#else
     (*driver->send_nkro)(report);
+#endif
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
@@ -126,7 +138,11 @@ void host_mouse_send(report_mouse_t *report) {
     report->boot_x = (report->x > 127) ? 127 : ((report->x < -127) ? -127 : report->x);
     report->boot_y = (report->y > 127) ? 127 : ((report->y < -127) ? -127 : report->y);
 #endif
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_send(HOST_REPORT_MOUSE, report);
+#else
     (*driver->send_mouse)(report);
+#endif
 }
 
 void host_system_send(uint16_t usage) {
@@ -139,7 +155,11 @@ void host_system_send(uint16_t usage) {
         .report_id = REPORT_ID_SYSTEM,
         .usage     = usage,
     };
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_send(HOST_REPORT_EXTRA, &report);
+#else
     (*driver->send_extra)(&report);
+#endif
 }
 
 void host_consumer_send(uint16_t usage) {
@@ -159,7 +179,11 @@ void host_consumer_send(uint16_t usage) {
         .report_id = REPORT_ID_CONSUMER,
         .usage     = usage,
     };
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_send(HOST_REPORT_EXTRA, &report);
+#else
     (*driver->send_extra)(&report);
+#endif
 }
 
 #ifdef JOYSTICK_ENABLE
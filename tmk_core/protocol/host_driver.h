@@ -18,17 +18,28 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "report.h"
 #ifdef MIDI_ENABLE
 #    include "midi.h"
 #endif
 
+enum host_report_type {
+    HOST_REPORT_KEYBOARD,
+    HOST_REPORT_NKRO,
+    HOST_REPORT_MOUSE,
+    HOST_REPORT_EXTRA,
+    HOST_REPORT_TYPE_COUNT,
+};
+
 typedef struct {
     uint8_t (*keyboard_leds)(void);
     void (*send_keyboard)(report_keyboard_t *);
     void (*send_nkro)(report_nkro_t *);
     void (*send_mouse)(report_mouse_t *);
     void (*send_extra)(report_extra_t *);
+    /* Whether a report of the given type can be sent without blocking, NULL if sending never blocks */
+    bool (*send_ready)(uint8_t report_type);
 } host_driver_t;
 
 void send_joystick(report_joystick_t *report);
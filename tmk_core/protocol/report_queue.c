@@ -0,0 +1,186 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "report_queue.h"
+
+#include <string.h>
+#include "host.h"
+
+#ifdef MOUSE_EXTENDED_REPORT
+#    define MOUSE_XY_MIN INT16_MIN
+#    define MOUSE_XY_MAX INT16_MAX
+#else
+#    define MOUSE_XY_MIN INT8_MIN
+#    define MOUSE_XY_MAX INT8_MAX
+#endif
+
+typedef union {
+    report_keyboard_t keyboard;
+#ifdef NKRO_ENABLE
+    report_nkro_t nkro;
+#endif
+    report_mouse_t mouse;
+    report_extra_t extra;
+} report_t;
+
+typedef struct {
+    uint8_t  type;
+    report_t report;
+} queued_report_t;
+
+static const uint8_t report_sizes[HOST_REPORT_TYPE_COUNT] = {
+    [HOST_REPORT_KEYBOARD] = sizeof(report_keyboard_t),
+#ifdef NKRO_ENABLE
+    [HOST_REPORT_NKRO] = sizeof(report_nkro_t),
+#endif
+    [HOST_REPORT_MOUSE] = sizeof(report_mouse_t),
+    [HOST_REPORT_EXTRA] = sizeof(report_extra_t),
+};
+
+static queued_report_t      queue[REPORT_QUEUE_SIZE];
+static uint8_t              queue_count = 0;
+static report_queue_stats_t stats       = {0};
+
+// The driver may still be reading a report after returning, until it starts
+// the next one on that endpoint, so reports sent from the queue are copied out
+// of it first. Each type alternates between two buffers: when the queue is full
+// a report goes out while the previous one may still be in flight.
+static report_t sent[HOST_REPORT_TYPE_COUNT][2];
+static uint8_t  sent_buffer = 0; // bit per type, the buffer used last
+
+static bool send_ready(host_driver_t *driver, uint8_t type) {
+    return !driver->send_ready || driver->send_ready(type);
+}
+
+static void dispatch(host_driver_t *driver, uint8_t type, void *report) {
+    switch (type) {
+        case HOST_REPORT_KEYBOARD:
+            (*driver->send_keyboard)(report);
+            break;
+        case HOST_REPORT_NKRO:
+            (*driver->send_nkro)(report);
+            break;
+        case HOST_REPORT_MOUSE:
+            (*driver->send_mouse)(report);
+            break;
+        case HOST_REPORT_EXTRA:
+            (*driver->send_extra)(report);
+            break;
+    }
+}
+
+// Returns the index of the newest queued report of a type, or -1
+static int8_t find_newest(uint8_t type) {
+    for (int8_t i = queue_count - 1; i >= 0; i--) {
+        if (queue[i].type == type) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool in_range(int32_t value, int32_t min, int32_t max) {
+    return value >= min && value <= max;
+}
+
+static bool coalesce_mouse(report_mouse_t *queued, const report_mouse_t *report) {
+    if (queued->buttons != report->buttons) {
+        return false;
+    }
+
+    int32_t x = (int32_t)queued->x + report->x;
+    int32_t y = (int32_t)queued->y + report->y;
+    int32_t v = (int32_t)queued->v + report->v;
+    int32_t h = (int32_t)queued->h + report->h;
+    if (!in_range(x, MOUSE_XY_MIN, MOUSE_XY_MAX) || !in_range(y, MOUSE_XY_MIN, MOUSE_XY_MAX) || !in_range(v, INT8_MIN, INT8_MAX) || !in_range(h, INT8_MIN, INT8_MAX)) {
+        return false;
+    }
+
+    queued->x = x;
+    queued->y = y;
+    queued->v = v;
+    queued->h = h;
+#ifdef MOUSE_EXTENDED_REPORT
+    queued->boot_x = (x > 127) ? 127 : ((x < -127) ? -127 : x);
+    queued->boot_y = (y > 127) ? 127 : ((y < -127) ? -127 : y);
+#endif
+    return true;
+}
+
+static void send_at(host_driver_t *driver, uint8_t index) {
+    uint8_t type = queue[index].type;
+
+    sent_buffer ^= 1 << type;
+    report_t *report = &sent[type][(sent_buffer >> type) & 1];
+    memcpy(report, &queue[index].report, report_sizes[type]);
+    queue_count--;
+    memmove(&queue[index], &queue[index + 1], (queue_count - index) * sizeof(queued_report_t));
+    dispatch(driver, type, report);
+}
+
+void report_queue_send(uint8_t type, void *report) {
+    host_driver_t *driver = host_get_driver();
+    if (!driver) return;
+
+    report_queue_task();
+
+    int8_t newest = find_newest(type);
+    if (newest < 0 && send_ready(driver, type)) {
+        dispatch(driver, type, report);
+        return;
+    }
+
+    if (type == HOST_REPORT_MOUSE && newest >= 0 && coalesce_mouse(&queue[newest].report.mouse, report)) {
+        stats.coalesced++;
+        return;
+    }
+
+    if (queue_count == REPORT_QUEUE_SIZE) {
+        // Every queued report is a state the host must see, so make room by sending the oldest one the way it was
+        // sent without the queue, waiting for its endpoint.
+        send_at(driver, 0);
+        stats.blocked++;
+    }
+
+    queue[queue_count].type = type;
+    memcpy(&queue[queue_count].report, report, report_sizes[type]);
+    queue_count++;
+    if (queue_count > stats.max_depth) {
+        stats.max_depth = queue_count;
+    }
+}
+
+void report_queue_task(void) {
+    host_driver_t *driver = host_get_driver();
+    if (!driver || !queue_count) return;
+
+    uint8_t blocked = 0;
+    for (uint8_t i = 0; i < queue_count;) {
+        uint8_t type = queue[i].type;
+        if ((blocked & (1 << type)) || !send_ready(driver, type)) {
+            // keep the order of reports of this type
+            blocked |= 1 << type;
+            i++;
+            continue;
+        }
+
+        send_at(driver, i);
+    }
+}
+
+void report_queue_clear(void) {
+    queue_count = 0;
+}
+
+uint8_t report_queue_depth(void) {
+    return queue_count;
+}
+
+report_queue_stats_t report_queue_get_stats(void) {
+    stats.depth = queue_count;
+    return stats;
+}
+
+void report_queue_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
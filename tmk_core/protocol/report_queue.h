@@ -0,0 +1,46 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "host_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Reports waiting for a busy endpoint are kept in order in a queue of this many entries */
+#ifndef REPORT_QUEUE_SIZE
+#    define REPORT_QUEUE_SIZE 8
+#endif
+
+typedef struct {
+    uint8_t  depth;     // reports currently queued
+    uint8_t  max_depth; // highest depth seen since the last reset
+    uint16_t coalesced; // mouse reports merged into a queued one
+    uint16_t blocked;   // reports sent to a busy endpoint because the queue was full
+} report_queue_stats_t;
+
+/** \brief Sends a report, or queues it until the host driver's endpoint for that report type is ready.
+ *
+ * Reports of the same type are sent in the order they were queued. Mouse reports that do not
+ * change the buttons are merged into the last queued mouse report by adding up their movement.
+ * Other reports are never merged or dropped: when the queue is full, the oldest queued report
+ * is sent first, waiting for its endpoint like it would without the queue.
+ */
+void report_queue_send(uint8_t report_type, void *report);
+
+/** \brief Sends queued reports whose endpoint is ready. Called from keyboard_task(). */
+void report_queue_task(void);
+
+/** \brief Drops all queued reports. */
+void report_queue_clear(void);
+
+uint8_t              report_queue_depth(void);
+report_queue_stats_t report_queue_get_stats(void);
+void                 report_queue_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif